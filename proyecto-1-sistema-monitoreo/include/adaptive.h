@@ -0,0 +1,23 @@
+#ifndef ADAPTIVE_H
+#define ADAPTIVE_H
+
+// Politica de muestreo adaptativo: el intervalo se estira mientras la señal
+// esta quieta y vuelve al piso apenas detecta un cambio.
+typedef struct {
+    int min_ms;                                             // Piso: intervalo cuando hay cambios
+    int max_ms;                                             // Techo: intervalo maximo en reposo
+    float tolerance;                                        // Cambio maximo (puntos %) considerado "quieto"
+    float growth;                                           // Factor con que crece el intervalo en reposo
+    int interval_ms;                                        // Intervalo actual
+
+    long samples;                                           // Muestras tomadas
+    long changes;                                           // Muestras que detectaron cambio
+    double elapsed_ms;                                      // Tiempo total cubierto por las muestras
+} AdaptivePolicy;
+
+// Funciones públicas
+void adaptive_init(AdaptivePolicy *p, int min_ms, int max_ms, float tolerance);     // Empieza en el piso
+int adaptive_next(AdaptivePolicy *p, float change, double actual_ms);   // Registra una muestra, retorna el proximo intervalo
+long adaptive_fixed_samples(const AdaptivePolicy *p, int fixed_ms);     // Muestras que hubiera tomado un intervalo fijo
+
+#endif
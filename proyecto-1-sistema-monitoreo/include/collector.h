@@ -0,0 +1,57 @@
+#ifndef COLLECTOR_H
+#define COLLECTOR_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define COLLECTOR_MAX 16                                    // Maximo de colectores por pool
+
+// Un colector independiente: lee su fuente y escribe solo en su casilla
+typedef struct {
+    const char *name;                                       // Nombre para los reportes
+    void (*collect)(void *ctx, void *slot);                 // Llena la casilla con la muestra del tick
+    void *ctx;                                              // Estado propio del colector
+    size_t slot_size;                                       // Bytes de la casilla
+} Collector;
+
+// Tiempos de un tick
+typedef struct {
+    uint64_t tick;                                          // Numero de tick publicado
+    double wall_ms;                                         // Duracion real del tick (paralelo)
+    double serial_ms;                                       // Suma de los colectores (lo que tardaria en serie)
+    double collector_ms[COLLECTOR_MAX];                     // Duracion de cada colector
+} TickStats;
+
+// Pool de hilos que ejecuta todos los colectores en cada tick
+typedef struct {
+    Collector cols[COLLECTOR_MAX];                          // Colectores registrados
+    size_t offsets[COLLECTOR_MAX];                          // Posicion de cada casilla en la instantanea
+    int count;                                              // Cantidad de colectores
+    size_t size;                                            // Bytes de una instantanea completa
+    unsigned char *back;                                    // Casillas que escriben los colectores
+    unsigned char *front;                                   // Ultima instantanea publicada
+    atomic_uint seq;                                        // Seqlock de front (impar = publicando)
+    uint64_t tick;                                          // Ticks publicados
+
+    pthread_t *threads;                                     // Hilos trabajadores (0 = modo serie)
+    int workers;
+    pthread_mutex_t lock;
+    pthread_cond_t start;                                   // Señal de inicio de tick
+    pthread_cond_t done;                                    // Señal de fin de tick (barrera)
+    uint64_t generation;                                    // Tick en curso
+    int pending;                                            // Colectores que faltan
+    int stop;                                               // Pide a los hilos terminar
+    atomic_int next;                                        // Proximo colector a tomar
+    double durations[COLLECTOR_MAX];                        // Duracion de cada colector en el tick
+} CollectorPool;
+
+// Funciones públicas
+int collector_pool_init(CollectorPool *p, const Collector *cols, int count, int workers);  // -1 si falla
+void collector_pool_tick(CollectorPool *p, TickStats *stats);      // Ejecuta colectores y publica la instantanea
+void collector_pool_snapshot(CollectorPool *p, void *dst);         // Copia consistente de la ultima instantanea
+void *collector_slot(const CollectorPool *p, void *snapshot, int index);  // Casilla de un colector en una copia
+void collector_pool_destroy(CollectorPool *p);                     // Detiene los hilos y libera
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef CPU_H
 #define CPU_H
 
+#include "sysinfo.h"
+
 // Estructura para guardar info del CPU
 typedef struct {
     char model_name[128];                                   // Nombre del procesador
@@ -8,8 +10,7 @@ typedef struct {
 } CPUInfo;                                                  // Estructura para guardar info del CPU
 
 // Funciones públicas
-CPUInfo get_cpu_info();                                     // Obtiene la info del CPU
+CPUInfo get_cpu_info(const sysinfo_snapshot *snap);         // Info del CPU de una instantanea de libsysinfo
 void print_cpu_info(CPUInfo cpu);                           // Imprime la info del CPU
-void get_cpu_load_per_core(float *loads, int cores);        // Obtiene la carga del CPU por core
 
 #endif
@@ -0,0 +1,45 @@
+#ifndef FLEET_H
+#define FLEET_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include "proto.h"
+
+// Ultimo estado conocido de un host de la flota
+typedef struct {
+    uint64_t host_id;                                       // Clave (0 = casilla vacia)
+    uint32_t boot;                                          // Arranque del emisor de la ultima muestra
+    uint32_t seq;                                           // Ultima secuencia recibida
+    time_t last_seen;                                       // Momento de la ultima muestra
+    uint32_t interval_ms;                                   // Intervalo que reporto el host
+    int cores;                                              // Cores reportados
+    float cpu_avg;                                          // Carga promedio de todos los cores en %
+    float cpu_max;                                          // Carga del core mas ocupado en %
+    long mem_total;                                         // Memoria total en KB
+    long mem_available;                                     // Memoria disponible en KB
+} HostState;
+
+// Tabla hash de direccionamiento abierto (sondeo lineal, capacidad potencia de 2)
+typedef struct {
+    HostState *slots;                                       // Arreglo de casillas
+    size_t capacity;                                        // Cantidad de casillas
+    size_t count;                                           // Hosts almacenados
+} FleetTable;
+
+// Resumen de la flota calculado en cada reporte
+typedef struct {
+    size_t hosts;                                           // Hosts vivos considerados
+    float cpu_p50;                                          // Mediana de la carga promedio
+    float cpu_p99;                                          // Percentil 99 de la carga promedio
+    long mem_available_min;                                 // Menor memoria disponible en KB
+    uint64_t mem_available_min_host;                        // Host con menos memoria disponible
+} FleetSummary;
+
+// Funciones públicas
+int fleet_init(FleetTable *t, size_t capacity);             // Reserva la tabla, -1 si falla
+void fleet_free(FleetTable *t);                             // Libera la tabla
+int fleet_update(FleetTable *t, const Sample *s, time_t now);   // Inserta/actualiza: 1 si es vieja, 2 si el host reinicio
+FleetSummary fleet_summarize(const FleetTable *t, time_t now, int max_age);     // Percentiles de hosts vivos
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef MEMORY_H
 #define MEMORY_H
 
+#include "sysinfo.h"
+
 // Estructura para guardar info de la memoria
 typedef struct {
     long total;                                     // Memoria total en KB
@@ -13,7 +15,7 @@ typedef struct {
 } MemoryInfo;                                       // Estructura para guardar info de la memoria
 
 // Funciones públicas
-MemoryInfo get_memory_info();                       // Obtiene la info de la memoria
-void print_memory_info(MemoryInfo mem);             // Imprime la info de la memoria
+MemoryInfo get_memory_info(const sysinfo_snapshot *snap);   // Info de la memoria de una instantanea de libsysinfo
+void print_memory_info(MemoryInfo mem);                     // Imprime la info de la memoria
 
 #endif
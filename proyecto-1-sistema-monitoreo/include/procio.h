@@ -0,0 +1,44 @@
+#ifndef PROCIO_H
+#define PROCIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PROCIO_TOP_MAX 32                                   // Maximo de procesos en el top
+
+// Consumo de un proceso durante el intervalo (tasas por segundo)
+typedef struct {
+    int pid;                                                // Id del proceso
+    char comm[16];                                          // Nombre del proceso
+    double read_bytes;                                      // Bytes leidos de disco por segundo
+    double write_bytes;                                     // Bytes escritos a disco por segundo
+    double syscr;                                           // Llamadas read() por segundo
+    double syscw;                                           // Llamadas write() por segundo
+    double minflt;                                          // Fallos de pagina menores por segundo
+    double majflt;                                          // Fallos de pagina mayores por segundo
+} ProcIOStat;
+
+// Costo del ultimo escaneo
+typedef struct {
+    long procs_total;                                       // Procesos conocidos (ultimo barrido)
+    long procs_read;                                        // Procesos leidos en este tick
+    long denied;                                            // Procesos sin permiso para leer io
+    int full_sweep;                                         // 1 si este tick fue un barrido completo
+    double scan_ms;                                         // Tiempo del escaneo
+} ProcIOScan;
+
+// Resultado de un tick: cabe en una casilla del pool de colectores
+typedef struct {
+    int count;                                              // Procesos validos en top
+    ProcIOStat top[PROCIO_TOP_MAX];                         // Mayores consumidores de I/O
+    ProcIOScan scan;                                        // Costo del escaneo
+} ProcIOTop;
+
+typedef struct ProcIOEngine ProcIOEngine;                   // Estado interno (opaco)
+
+// Funciones públicas
+ProcIOEngine *procio_open(const char *proc_root, int top_n, int sample_size, int sweep_every);  // NULL si falla
+void procio_sample(ProcIOEngine *e, ProcIOTop *out);       // Lee los candidatos y calcula el top
+void procio_close(ProcIOEngine *e);                        // Libera el motor
+
+#endif
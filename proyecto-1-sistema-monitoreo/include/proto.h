@@ -0,0 +1,32 @@
+#ifndef PROTO_H
+#define PROTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "memory.h"
+
+// Protocolo binario compacto para enviar muestras por UDP al agregador.
+// Formato: magic, version, y luego todos los campos como varint (LEB128).
+#define PROTO_MAGIC        0xA5                             // Primer byte de todo paquete
+#define PROTO_VERSION      3                                // Version del formato
+#define PROTO_MAX_CORES    256                              // Maximo de cores por muestra
+#define PROTO_MAX_PACKET   1472                             // Cabe en un datagrama sin fragmentar
+
+// Muestra de un host tal como viaja por la red
+typedef struct {
+    uint64_t host_id;                                       // Identificador del host (hash del hostname)
+    uint32_t boot;                                          // Arranque del emisor: cambia en cada reinicio
+    uint32_t seq;                                           // Numero de secuencia del emisor
+    uint32_t interval_ms;                                   // Tiempo real desde la muestra anterior
+    MemoryInfo mem;                                         // Info de memoria del host
+    int cores;                                              // Cantidad de cores en loads
+    float loads[PROTO_MAX_CORES];                           // Carga por core en %
+} Sample;
+
+// Funciones públicas
+size_t proto_encode(const Sample *s, uint8_t *buf, size_t cap);     // Codifica, retorna bytes o 0 si no cabe
+int proto_decode(const uint8_t *buf, size_t len, Sample *s);        // Decodifica, retorna 0 o -1 si es invalido
+uint64_t proto_host_id(const char *hostname);                       // Hash FNV-1a del hostname
+uint32_t proto_boot_id(void);                                       // Id de arranque distinto en cada ejecucion
+
+#endif
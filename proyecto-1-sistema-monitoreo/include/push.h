@@ -0,0 +1,11 @@
+#ifndef PUSH_H
+#define PUSH_H
+
+#include "proto.h"
+
+// Funciones públicas
+int push_open(const char *target);                          // Abre socket UDP hacia "host:puerto", -1 si falla
+int push_send(int fd, const Sample *s);                     // Codifica y envia una muestra, -1 si falla
+int push_simulate(const char *target, int hosts, int interval_ms, int restarts);  // Simula emisores; restarts reinician por ronda
+
+#endif
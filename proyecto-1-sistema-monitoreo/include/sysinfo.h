@@ -0,0 +1,69 @@
+#ifndef SYSINFO_H
+#define SYSINFO_H
+
+// libsysinfo: los mismos datos que muestra system_info, pero como biblioteca
+// embebible (sin salida por stdout y sin estado global).
+//
+// Reglas de ABI:
+//   - sysinfo_t es opaco; su contenido puede cambiar entre versiones.
+//   - sysinfo_snapshot solo crece agregando campos al final. El llamador pone
+//     snap->size = sizeof(*snap) y la biblioteca solo escribe esa cantidad de
+//     bytes, asi un binario viejo sigue funcionando con una biblioteca nueva.
+//   - SYSINFO_ABI_VERSION cambia (y con el el soname) solo si se rompe lo anterior.
+//
+// Reglas de hilos:
+//   - Un handle no es thread-safe: cada hilo usa su propio handle, o el llamador
+//     serializa las llamadas a sysinfo_sample() sobre el mismo handle.
+//   - Handles distintos pueden usarse en paralelo sin sincronizacion.
+//   - Las cargas por core son deltas entre dos muestras del mismo handle.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SYSINFO_ABI_VERSION   1                             // Version de la ABI (soname libsysinfo.so.1)
+#define SYSINFO_MAX_CORES     256                           // Cores que caben en una instantanea
+#define SYSINFO_MODEL_LEN     128                           // Largo maximo del nombre del CPU
+
+#if defined(SYSINFO_BUILD)
+#define SYSINFO_API __attribute__((visibility("default")))  // Solo se exporta la API publica
+#else
+#define SYSINFO_API
+#endif
+
+typedef struct sysinfo sysinfo_t;                           // Handle opaco
+
+// Instantanea preasignada por el llamador
+typedef struct {
+    uint32_t size;                                          // sizeof(sysinfo_snapshot) del llamador
+    uint32_t version;                                       // SYSINFO_ABI_VERSION de la biblioteca
+    uint64_t timestamp_ns;                                  // CLOCK_MONOTONIC de la muestra
+    uint64_t interval_ns;                                   // Tiempo desde la muestra anterior (0 en la primera)
+
+    int64_t mem_total;                                      // Memoria total en KB
+    int64_t mem_free;                                       // Memoria libre en KB
+    int64_t mem_available;                                  // Memoria disponible en KB
+    int64_t mem_used;                                       // Memoria fisica usada en KB
+    int64_t swap_total;                                     // Swap total en KB
+    int64_t swap_free;                                      // Swap libre en KB
+    int64_t swap_used;                                      // Swap usada en KB
+
+    char model_name[SYSINFO_MODEL_LEN];                     // Nombre del procesador
+    uint32_t cores;                                         // Cores validos en core_load
+    float cpu_load;                                         // Carga total del sistema en %
+    float core_load[SYSINFO_MAX_CORES];                     // Carga por core en %
+} sysinfo_snapshot;
+
+// Funciones públicas (retornan 0 o -errno)
+SYSINFO_API sysinfo_t *sysinfo_open(void);                                      // NULL y errno si falla
+SYSINFO_API int sysinfo_sample(sysinfo_t *si, sysinfo_snapshot *snap);          // Llena la instantanea
+SYSINFO_API void sysinfo_close(sysinfo_t *si);                                  // Cierra descriptores y libera
+SYSINFO_API const char *sysinfo_version(void);                                  // Version de la biblioteca
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
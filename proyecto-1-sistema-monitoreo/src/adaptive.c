@@ -0,0 +1,32 @@
+#include "adaptive.h"
+
+void adaptive_init(AdaptivePolicy *p, int min_ms, int max_ms, float tolerance) {
+    p->min_ms = min_ms > 0 ? min_ms : 1;                                                // Piso de al menos 1 ms
+    p->max_ms = max_ms > p->min_ms ? max_ms : p->min_ms;                                // El techo nunca baja del piso
+    p->tolerance = tolerance;
+    p->growth = 1.5f;
+    p->interval_ms = p->min_ms;                                                         // Arranca con resolucion fina
+    p->samples = 0;
+    p->changes = 0;
+    p->elapsed_ms = 0.0;
+}
+
+// change: mayor diferencia entre esta muestra y la anterior (en puntos %)
+int adaptive_next(AdaptivePolicy *p, float change, double actual_ms) {
+    p->samples++;
+    p->elapsed_ms += actual_ms;
+
+    if (change > p->tolerance) {                                                        // Cambio detectado: al piso
+        p->changes++;
+        p->interval_ms = p->min_ms;
+    } else {                                                                            // Quieto: estira hasta el techo
+        int next = (int)(p->interval_ms * p->growth);
+        if (next <= p->interval_ms) next = p->interval_ms + 1;                          // Siempre avanza, aun con intervalos chicos
+        p->interval_ms = next > p->max_ms ? p->max_ms : next;
+    }
+    return p->interval_ms;
+}
+
+long adaptive_fixed_samples(const AdaptivePolicy *p, int fixed_ms) {
+    return (long)(p->elapsed_ms / fixed_ms) + 1;
+}
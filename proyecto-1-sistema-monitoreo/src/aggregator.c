@@ -0,0 +1,114 @@
+#define _GNU_SOURCE                                                                     // recvmmsg
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "proto.h"
+#include "fleet.h"
+
+#define BATCH         64                                                                // Datagramas por recvmmsg
+#define REPORT_SEC    2                                                                 // Igual que el refresco de system_info
+#define MAX_AGE_SEC   10                                                                // Host caido si no reporta en este tiempo
+
+// Abre el socket UDP del agregador en todas las interfaces
+static int open_listener(int port) {
+    int fd = socket(AF_INET6, SOCK_DGRAM, 0);                                           // Dual-stack: acepta IPv4 e IPv6
+    int off = 0, rcvbuf = 8 * 1024 * 1024;                                              // Buffer grande para rafagas
+    struct sockaddr_in6 addr = {0};
+
+    if (fd < 0) {
+        perror("No se pudo crear el socket");
+        return -1;
+    }
+    setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    addr.sin6_family = AF_INET6;
+    addr.sin6_addr = in6addr_any;
+    addr.sin6_port = htons(port);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("No se pudo hacer bind");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int main(int argc, char *argv[]) {
+    int port = argc > 1 ? atoi(argv[1]) : 9000;                                         // Puerto de escucha
+    static uint8_t bufs[BATCH][PROTO_MAX_PACKET];                                       // Un buffer por datagrama
+    struct mmsghdr msgs[BATCH];                                                         // Cabeceras para recvmmsg
+    struct iovec iovs[BATCH];
+    FleetTable table;                                                                   // Ultimo estado por host
+    Sample sample;
+    long packets = 0, batches = 0, invalid = 0, stale = 0, restarts = 0;                // Contadores del intervalo
+    time_t next_report = time(NULL) + REPORT_SEC;
+
+    int fd = open_listener(port);
+    if (fd < 0) return 1;
+    if (fleet_init(&table, 4096) != 0) {                                                // Miles de hosts sin crecer
+        perror("No se pudo asignar la tabla de hosts");
+        return 1;
+    }
+
+    memset(msgs, 0, sizeof(msgs));
+    for (int i = 0; i < BATCH; i++) {
+        iovs[i].iov_base = bufs[i];
+        iovs[i].iov_len = sizeof(bufs[i]);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    printf("Agregador escuchando en UDP %d\n", port);
+    while (1) {
+        time_t now = time(NULL);
+        struct pollfd pfd = {fd, POLLIN, 0};
+        int wait_ms = next_report > now ? (int)(next_report - now) * 1000 : 0;
+
+        if (poll(&pfd, 1, wait_ms) > 0) {
+            // Vacia el socket en lotes hasta que no quede nada pendiente
+            int n;
+            while ((n = recvmmsg(fd, msgs, BATCH, MSG_DONTWAIT, NULL)) > 0) {
+                now = time(NULL);
+                batches++;
+                for (int i = 0; i < n; i++) {
+                    if (proto_decode(bufs[i], msgs[i].msg_len, &sample) != 0) {
+                        invalid++;
+                        continue;
+                    }
+                    int rc = fleet_update(&table, &sample, now);
+                    if (rc == 1) stale++;
+                    else if (rc == 2) restarts++;
+                    packets++;
+                }
+                if (n < BATCH) break;                                                   // Lote incompleto: socket vacio
+            }
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("Error en recvmmsg");
+                break;
+            }
+        }
+
+        now = time(NULL);
+        if (now >= next_report) {
+            FleetSummary s = fleet_summarize(&table, now, MAX_AGE_SEC);
+            printf("Hosts: %zu/%zu | CPU p50: %.2f%% p99: %.2f%% | Mem disponible min: %ld KB (host %016llx)"
+                   " | Paquetes: %ld (%.1f/lote) invalidos: %ld viejos: %ld reinicios: %ld\n",
+                   s.hosts, table.count, s.cpu_p50, s.cpu_p99, s.mem_available_min,
+                   (unsigned long long)s.mem_available_min_host,
+                   packets, batches ? (double)packets / batches : 0.0, invalid, stale, restarts);
+            fflush(stdout);
+            packets = batches = invalid = stale = restarts = 0;
+            next_report = now + REPORT_SEC;
+        }
+    }
+
+    fleet_free(&table);
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "collector.h"
+
+#define SLOT_ALIGN 64                                                                   // Una linea de cache por casilla
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Toma colectores pendientes hasta que no quede ninguno; retorna cuantos ejecuto
+static int run_jobs(CollectorPool *p) {
+    int ran = 0;
+    int i;
+    while ((i = atomic_fetch_add(&p->next, 1)) < p->count) {
+        double t0 = now_ms();
+        p->cols[i].collect(p->cols[i].ctx, p->back + p->offsets[i]);                    // Cada uno en su casilla
+        p->durations[i] = now_ms() - t0;
+        ran++;
+    }
+    return ran;
+}
+
+static void *worker_main(void *arg) {
+    CollectorPool *p = arg;
+    uint64_t seen = 0;                                                                  // Ultimo tick atendido
+
+    pthread_mutex_lock(&p->lock);
+    while (1) {
+        while (!p->stop && p->generation == seen) pthread_cond_wait(&p->start, &p->lock);
+        if (p->stop) break;
+        seen = p->generation;
+        pthread_mutex_unlock(&p->lock);
+
+        int ran = run_jobs(p);
+
+        pthread_mutex_lock(&p->lock);
+        p->pending -= ran;
+        if (p->pending == 0) pthread_cond_signal(&p->done);                             // El ultimo avisa: barrera cumplida
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+int collector_pool_init(CollectorPool *p, const Collector *cols, int count, int workers) {
+    memset(p, 0, sizeof(*p));
+    if (count <= 0 || count > COLLECTOR_MAX || workers < 0) return -1;
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->start, NULL);
+    pthread_cond_init(&p->done, NULL);
+
+    p->count = count;
+    for (int i = 0; i < count; i++) {                                                   // Casillas alineadas y contiguas
+        p->cols[i] = cols[i];
+        p->offsets[i] = p->size;
+        p->size += (cols[i].slot_size + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+    }
+    p->back = aligned_alloc(SLOT_ALIGN, p->size);
+    p->front = aligned_alloc(SLOT_ALIGN, p->size);
+    if (!p->back || !p->front) {
+        collector_pool_destroy(p);
+        return -1;
+    }
+    memset(p->back, 0, p->size);
+    memset(p->front, 0, p->size);
+    atomic_init(&p->seq, 0);
+    atomic_init(&p->next, count);
+
+    if (workers > 0) {
+        p->threads = calloc(workers, sizeof(pthread_t));
+        if (!p->threads) {
+            collector_pool_destroy(p);
+            return -1;
+        }
+        for (; p->workers < workers; p->workers++) {
+            if (pthread_create(&p->threads[p->workers], NULL, worker_main, p) != 0) break;
+        }
+    }
+    return 0;
+}
+
+// Publica back -> front con un seqlock: los lectores nunca bloquean el tick
+static void publish(CollectorPool *p) {
+    unsigned s = atomic_load_explicit(&p->seq, memory_order_relaxed);
+    atomic_store_explicit(&p->seq, s + 1, memory_order_relaxed);                       // Impar: publicando
+    atomic_thread_fence(memory_order_release);
+    memcpy(p->front, p->back, p->size);
+    atomic_store_explicit(&p->seq, s + 2, memory_order_release);                       // Par: estable
+}
+
+void collector_pool_tick(CollectorPool *p, TickStats *stats) {
+    double t0 = now_ms();
+
+    if (p->workers == 0) {                                                              // Modo serie, como el main() original
+        atomic_store(&p->next, 0);
+        run_jobs(p);
+    } else {
+        pthread_mutex_lock(&p->lock);
+        p->pending = p->count;
+        atomic_store(&p->next, 0);
+        p->generation++;
+        pthread_cond_broadcast(&p->start);
+        while (p->pending > 0) pthread_cond_wait(&p->done, &p->lock);                  // Barrera: todos terminaron
+        pthread_mutex_unlock(&p->lock);
+    }
+
+    publish(p);
+    p->tick++;
+
+    if (stats) {
+        stats->tick = p->tick;
+        stats->wall_ms = now_ms() - t0;
+        stats->serial_ms = 0.0;
+        for (int i = 0; i < p->count; i++) {
+            stats->collector_ms[i] = p->durations[i];
+            stats->serial_ms += p->durations[i];
+        }
+    }
+}
+
+void collector_pool_snapshot(CollectorPool *p, void *dst) {
+    unsigned s1, s2;
+    do {
+        s1 = atomic_load_explicit(&p->seq, memory_order_acquire);
+        memcpy(dst, p->front, p->size);
+        atomic_thread_fence(memory_order_acquire);
+        s2 = atomic_load_explicit(&p->seq, memory_order_relaxed);
+    } while ((s1 & 1) || s1 != s2);                                                     // Reintenta si hubo publicacion en medio
+}
+
+void *collector_slot(const CollectorPool *p, void *snapshot, int index) {
+    return (unsigned char *)snapshot + p->offsets[index];
+}
+
+void collector_pool_destroy(CollectorPool *p) {
+    if (p->threads) {
+        pthread_mutex_lock(&p->lock);
+        p->stop = 1;
+        pthread_cond_broadcast(&p->start);
+        pthread_mutex_unlock(&p->lock);
+        for (int i = 0; i < p->workers; i++) pthread_join(p->threads[i], NULL);
+        free(p->threads);
+    }
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->start);
+    pthread_cond_destroy(&p->done);
+    free(p->back);
+    free(p->front);
+    memset(p, 0, sizeof(*p));
+}
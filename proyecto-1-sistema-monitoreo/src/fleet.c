@@ -0,0 +1,127 @@
+#include <stdlib.h>
+#include <string.h>
+#include "fleet.h"
+
+// Mezcla los bits del id para que los hashes cercanos no se agrupen
+static size_t fleet_hash(uint64_t key, size_t mask) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return (size_t)key & mask;
+}
+
+// El id 0 marca casillas vacias; un host con hash 0 se mueve a 1
+static uint64_t fleet_key(uint64_t host_id) {
+    return host_id ? host_id : 1;
+}
+
+int fleet_init(FleetTable *t, size_t capacity) {
+    size_t cap = 16;
+    while (cap < capacity) cap <<= 1;                                                   // Redondea a potencia de 2
+    t->slots = calloc(cap, sizeof(HostState));
+    t->capacity = t->slots ? cap : 0;
+    t->count = 0;
+    return t->slots ? 0 : -1;
+}
+
+void fleet_free(FleetTable *t) {
+    free(t->slots);
+    memset(t, 0, sizeof(*t));
+}
+
+// Busca la casilla del host o la primera vacia de su cadena de sondeo
+static HostState *fleet_slot(HostState *slots, size_t capacity, uint64_t key) {
+    size_t mask = capacity - 1;
+    size_t i = fleet_hash(key, mask);
+    while (slots[i].host_id != 0 && slots[i].host_id != key) i = (i + 1) & mask;       // Sondeo lineal
+    return &slots[i];
+}
+
+// Duplica la capacidad cuando la carga supera 70%
+static int fleet_grow(FleetTable *t) {
+    size_t cap = t->capacity * 2;
+    HostState *slots = calloc(cap, sizeof(HostState));
+    if (!slots) return -1;
+    for (size_t i = 0; i < t->capacity; i++) {                                          // Reinserta todo
+        if (t->slots[i].host_id) *fleet_slot(slots, cap, t->slots[i].host_id) = t->slots[i];
+    }
+    free(t->slots);
+    t->slots = slots;
+    t->capacity = cap;
+    return 0;
+}
+
+int fleet_update(FleetTable *t, const Sample *s, time_t now) {
+    uint64_t key = fleet_key(s->host_id);
+    HostState *e;
+    int rc = 0;
+
+    if ((t->count + 1) * 10 > t->capacity * 7 && fleet_grow(t) != 0) return -1;
+    e = fleet_slot(t->slots, t->capacity, key);
+    if (e->host_id == 0) {                                                              // Host nuevo
+        e->host_id = key;
+        t->count++;
+    } else if (e->boot != s->boot) {                                                    // Reinicio: la secuencia vuelve a empezar
+        rc = 2;
+    } else {
+        int32_t diff = (int32_t)(s->seq - e->seq);
+        if (diff <= 0 && diff > -1000) return 1;                                        // Duplicado o desordenado
+    }
+
+    float sum = 0.0f, max = 0.0f;
+    for (int i = 0; i < s->cores; i++) {
+        sum += s->loads[i];
+        if (s->loads[i] > max) max = s->loads[i];
+    }
+    e->boot = s->boot;
+    e->seq = s->seq;
+    e->last_seen = now;
+    e->interval_ms = s->interval_ms;
+    e->cores = s->cores;
+    e->cpu_avg = s->cores > 0 ? sum / s->cores : 0.0f;
+    e->cpu_max = max;
+    e->mem_total = s->mem.total;
+    e->mem_available = s->mem.available;
+    return rc;
+}
+
+static int cmp_float(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil por rango mas cercano sobre un arreglo ordenado
+static float percentile(const float *sorted, size_t n, double p) {
+    size_t rank = (size_t)(p * n + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+}
+
+FleetSummary fleet_summarize(const FleetTable *t, time_t now, int max_age) {
+    FleetSummary sum = {0};
+    float *cpu = malloc((t->count ? t->count : 1) * sizeof(float));
+
+    if (!cpu) return sum;
+    sum.mem_available_min = -1;
+    for (size_t i = 0; i < t->capacity; i++) {
+        const HostState *e = &t->slots[i];
+        if (e->host_id == 0) continue;                                                  // Casilla vacia
+        if (now - e->last_seen > max_age + 2 * (time_t)(e->interval_ms / 1000)) continue;  // Host caido (respeta su intervalo)
+        cpu[sum.hosts++] = e->cpu_avg;
+        if (sum.mem_available_min < 0 || e->mem_available < sum.mem_available_min) {
+            sum.mem_available_min = e->mem_available;
+            sum.mem_available_min_host = e->host_id;
+        }
+    }
+
+    if (sum.hosts > 0) {
+        qsort(cpu, sum.hosts, sizeof(float), cmp_float);
+        sum.cpu_p50 = percentile(cpu, sum.hosts, 0.50);
+        sum.cpu_p99 = percentile(cpu, sum.hosts, 0.99);
+    } else {
+        sum.mem_available_min = 0;
+    }
+    free(cpu);
+    return sum;
+}
@@ -1,31 +1,321 @@
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#include <time.h>
+#include <sys/resource.h>
 #include "cpu.h"
 #include "memory.h"
+#include "sysinfo.h"
+#include "push.h"
+#include "collector.h"
+#include "adaptive.h"
+#include "procio.h"
 
-int main() {
-    CPUInfo cpu = get_cpu_info();                                   // Obtiene la info del CPU
-    MemoryInfo mem;                                                 // Estructura para guardar info de la memoria
+#define FIXED_INTERVAL_MS 2000                                      // Intervalo original (sleep(2))
 
-    float cpu_loads[cpu.cores];                                     // Array para guardar la carga del CPU por core
+// Indice de cada colector en el pool (y de su casilla en la instantanea)
+enum { COL_SYSTEM, COL_PROCIO, COL_COUNT };
 
+// Colector del sistema: memoria y carga por core en una sola lectura de libsysinfo.
+// El handle guarda los contadores del tick anterior, asi la carga es la del ultimo intervalo
+static void collect_system(void *ctx, void *slot) {
+    sysinfo_snapshot *snap = slot;
+    snap->size = sizeof(*snap);
+    if (sysinfo_sample((sysinfo_t *)ctx, snap) != 0) perror("No se pudo leer /proc");
+}
+
+// Colector de I/O por proceso: top de consumidores con escaneo acotado
+static void collect_procio(void *ctx, void *slot) {
+    procio_sample((ProcIOEngine *)ctx, (ProcIOTop *)slot);
+}
+
+// Imprime el top de procesos por I/O y el costo del escaneo
+static void print_procio(const ProcIOTop *top) {
+    printf("Top I/O (leidos %ld de %ld procesos%s en %.2f ms, sin permiso: %ld)\n",
+           top->scan.procs_read, top->scan.procs_total,
+           top->scan.full_sweep ? ", barrido completo" : "", top->scan.scan_ms, top->scan.denied);
+    printf("%7s %-15s %12s %12s %9s %9s %9s %9s\n",
+           "PID", "COMANDO", "LECTURA/s", "ESCRITURA/s", "syscr/s", "syscw/s", "minflt/s", "majflt/s");
+    for (int i = 0; i < top->count; i++) {
+        const ProcIOStat *p = &top->top[i];
+        printf("%7d %-15s %10.1fKB %10.1fKB %9.0f %9.0f %9.0f %9.0f\n",
+               p->pid, p->comm, p->read_bytes / 1024.0, p->write_bytes / 1024.0,
+               p->syscr, p->syscw, p->minflt, p->majflt);
+    }
+}
+
+// Opciones del muestreo
+typedef struct {
+    int adaptive;                                                   // 1 = intervalo adaptativo
+    int min_ms;                                                     // Piso del intervalo
+    int max_ms;                                                     // Techo del intervalo
+    float tolerance;                                                // Cambio tolerado en puntos %
+} SamplingOptions;
+
+// Estado del muestreo entre ticks
+typedef struct {
+    AdaptivePolicy policy;                                          // Politica adaptativa (si esta activa)
+    int adaptive;
+    int next_ms;                                                    // Proximo intervalo a dormir
+    double start_ms;                                                // Inicio del tick en curso
+    double last_ms;                                                 // Inicio del tick anterior
+    float *prev_loads;                                              // Cargas del tick anterior
+    long prev_available;                                            // Memoria disponible del tick anterior
+} Sampler;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// Duerme hasta un momento absoluto de CLOCK_MONOTONIC: un tick lento (un barrido completo)
+// no corre el horario de los siguientes
+static void sleep_until_ms(double deadline) {
+    long long ns = (long long)(deadline * 1e6);
+    struct timespec ts = {(time_t)(ns / 1000000000LL), (long)(ns % 1000000000LL)};
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+}
+
+// Mayor cambio entre este tick y el anterior, en puntos porcentuales
+static float sample_change(Sampler *s, const MemoryInfo *mem, const float *loads, int cores) {
+    float change = 0.0f;
+    for (int i = 0; i < cores; i++) {                               // Cambio de carga de cada core
+        float d = loads[i] - s->prev_loads[i];
+        if (d < 0) d = -d;
+        if (d > change) change = d;
+        s->prev_loads[i] = loads[i];
+    }
+    if (mem->total > 0) {                                           // Cambio de memoria disponible
+        float d = (float)(mem->available - s->prev_available) * 100.0f / mem->total;
+        if (d < 0) d = -d;
+        if (d > change) change = d;
+    }
+    s->prev_available = mem->available;
+    return change;
+}
+
+// Marca el inicio de un tick; el horario se cuenta desde aca
+static void sampler_begin(Sampler *s) {
+    s->start_ms = now_ms();
+}
+
+// Espera el intervalo (fijo o adaptativo) contado desde el inicio del tick
+static void sampler_wait(const Sampler *s) {
+    sleep_until_ms(s->start_ms + s->next_ms);
+}
+
+// Registra un tick: retorna el intervalo real entre inicios de tick y decide cuanto dormir
+static double sampler_tick(Sampler *s, const MemoryInfo *mem, const float *loads, int cores) {
+    double t = s->start_ms;
+    double actual = s->last_ms > 0 ? t - s->last_ms : 0.0;         // 0 en la primera muestra
+    float change = sample_change(s, mem, loads, cores);
+
+    s->last_ms = t;
+    if (s->adaptive) s->next_ms = adaptive_next(&s->policy, change, actual);
+    return actual;
+}
+
+// Muestras y CPU propio contra el intervalo fijo original
+static void print_sampler_stats(const Sampler *s) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    double cpu_ms = ru.ru_utime.tv_sec * 1000.0 + ru.ru_utime.tv_usec / 1000.0
+                  + ru.ru_stime.tv_sec * 1000.0 + ru.ru_stime.tv_usec / 1000.0;
+
+    if (!s->adaptive) {
+        printf("CPU propio: %.1f ms\n", cpu_ms);
+        return;
+    }
+    long fixed = adaptive_fixed_samples(&s->policy, FIXED_INTERVAL_MS);
+    printf("Muestras: %ld (con intervalo fijo de %d ms: %ld, reduccion %.1f%%) | Cambios: %ld | CPU propio: %.1f ms\n",
+           s->policy.samples, FIXED_INTERVAL_MS, fixed,
+           fixed > 0 ? 100.0 * (fixed - s->policy.samples) / fixed : 0.0,
+           s->policy.changes, cpu_ms);
+}
+
+// Imprime los tiempos del tick: paralelo contra la suma en serie
+static void print_tick_stats(const TickStats *st, const CollectorPool *pool) {
+    printf("Tick %llu: %.3f ms con %d hilos (en serie: %.3f ms",
+           (unsigned long long)st->tick, st->wall_ms, pool->workers, st->serial_ms);
+    for (int i = 0; i < pool->count; i++) {
+        printf(", %s %.3f ms", pool->cols[i].name, st->collector_ms[i]);
+    }
+    printf(")\n");
+}
+
+// Modo push: envia muestras al agregador en lugar de imprimirlas
+static int run_push(const char *target, CollectorPool *pool, void *snap, int cores, Sampler *sampler) {
+    int fd = push_open(target);                                     // Socket UDP hacia el agregador
+    char hostname[256] = "localhost";                               // Nombre del host para el id
+    Sample sample = {0};                                            // Muestra que se envia
+
+    if (fd < 0) return 1;
+    gethostname(hostname, sizeof(hostname) - 1);
+    sample.host_id = proto_host_id(hostname);                       // Id estable entre reinicios
+    sample.boot = proto_boot_id();                                  // El agregador detecta el reinicio por este id
+    sample.cores = cores < PROTO_MAX_CORES ? cores : PROTO_MAX_CORES;
+
+    printf("Enviando muestras de %s a %s\n", hostname, target);
     while (1) {
+        sampler_begin(sampler);
+        collector_pool_tick(pool, NULL);                            // Todos los colectores en paralelo
+        collector_pool_snapshot(pool, snap);                        // Instantanea consistente
+        const sysinfo_snapshot *sys = collector_slot(pool, snap, COL_SYSTEM);
+        sample.mem = get_memory_info(sys);
+        memcpy(sample.loads, sys->core_load, sample.cores * sizeof(float));
+        sample.interval_ms = (uint32_t)(sampler_tick(sampler, &sample.mem, sample.loads, sample.cores) + 0.5);
+        sample.seq++;
+        if (push_send(fd, &sample) != 0) perror("No se pudo enviar la muestra");
+        sampler_wait(sampler);                                      // Espera el intervalo (fijo o adaptativo)
+    }
+
+    close(fd);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *push_target = NULL;                                 // Destino host:puerto del modo push
+    int sim_hosts = 0;                                              // Hosts simulados (0 = datos reales)
+    int sim_restarts = 0;                                           // Hosts simulados que reinician por ronda
+    int workers = -1;                                               // Hilos del pool (-1 = automatico)
+    SamplingOptions opts = {0, 500, 30000, 5.0f};                   // Adaptativo apagado por defecto
+    int procio = 0;                                                 // 1 = top de I/O por proceso
+    int procio_top = 10;                                            // Procesos en el top
+    int procio_sample_size = 256;                                   // Procesos aleatorios por tick
+    int procio_sweep = 10;                                          // Ticks entre barridos completos
+    const char *proc_root = "/proc";                                // Raiz de procfs (permite arboles de prueba)
+
+    for (int i = 1; i < argc; i++) {                                // Parseo simple de argumentos
+        if (strcmp(argv[i], "--push") == 0 && i + 1 < argc) {
+            push_target = argv[++i];
+        } else if (strcmp(argv[i], "--sim") == 0 && i + 1 < argc) {
+            sim_hosts = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sim-restarts") == 0 && i + 1 < argc) {
+            sim_restarts = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--adaptive") == 0) {
+            opts.adaptive = 1;
+        } else if (strcmp(argv[i], "--min-interval") == 0 && i + 1 < argc) {
+            opts.min_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-interval") == 0 && i + 1 < argc) {
+            opts.max_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            opts.tolerance = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--procio") == 0) {
+            procio = 1;
+        } else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            procio_top = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sample") == 0 && i + 1 < argc) {
+            procio_sample_size = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            procio_sweep = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--proc-root") == 0 && i + 1 < argc) {
+            proc_root = argv[++i];
+        } else {
+            fprintf(stderr, "Uso: %s [--workers hilos] [--adaptive [--min-interval ms] [--max-interval ms]"
+                            " [--tolerance %%]] [--procio [--top N] [--sample N] [--sweep ticks] [--proc-root dir]]"
+                            " [--push host:puerto [--sim hosts [--sim-restarts N]]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (sim_hosts > 0) {                                            // Prueba de carga del agregador
+        if (!push_target) {
+            fprintf(stderr, "--sim requiere --push host:puerto\n");
+            return 1;
+        }
+        return push_simulate(push_target, sim_hosts, 2000, sim_restarts) == 0 ? 0 : 1;
+    }
+
+    sysinfo_t *si = sysinfo_open();                                 // /proc/stat y /proc/meminfo abiertos una sola vez
+    sysinfo_snapshot first = { .size = sizeof(first) };             // Primera muestra: modelo, cores y base de las cargas
+    if (!si || sysinfo_sample(si, &first) != 0) {
+        perror("No se pudo leer /proc");
+        return 1;
+    }
+    CPUInfo cpu = get_cpu_info(&first);                             // Obtiene la info del CPU
+    CollectorPool pool;                                             // Pool de colectores
+    TickStats stats;                                                // Tiempos del ultimo tick
+    Sampler sampler = {0};                                          // Intervalo fijo o adaptativo
+    ProcIOEngine *procio_engine = NULL;                             // Motor de I/O por proceso (opcional)
+    Collector cols[COL_COUNT] = {
+        [COL_SYSTEM] = {"sistema", collect_system, si, sizeof(sysinfo_snapshot)},
+        [COL_PROCIO] = {"procio", collect_procio, NULL, sizeof(ProcIOTop)},
+    };
+    int col_count = COL_PROCIO;                                     // procio es el ultimo: solo si se pide
+
+    if (procio) {
+        procio_engine = procio_open(proc_root, procio_top, procio_sample_size, procio_sweep);
+        if (!procio_engine) {
+            perror("No se pudo abrir el directorio de procesos");
+            return 1;
+        }
+        cols[COL_PROCIO].ctx = procio_engine;
+        col_count = COL_COUNT;
+    }
+
+    sampler.prev_loads = calloc(cpu.cores, sizeof(float));
+    if (!sampler.prev_loads) {
+        perror("No se pudo asignar memoria para la CPU");
+        return 1;
+    }
+    sampler.adaptive = opts.adaptive;
+    sampler.next_ms = FIXED_INTERVAL_MS;
+    if (opts.adaptive) {
+        adaptive_init(&sampler.policy, opts.min_ms, opts.max_ms, opts.tolerance);
+        sampler.next_ms = sampler.policy.interval_ms;
+    }
+
+    if (workers < 0) {                                              // Un hilo por colector, sin pasar de los cores
+        workers = cpu.cores < col_count ? cpu.cores : col_count;
+    }
+    if (collector_pool_init(&pool, cols, col_count, workers) != 0) {
+        fprintf(stderr, "No se pudo crear el pool de colectores\n");
+        return 1;
+    }
+    void *snap = malloc(pool.size);                                 // Copia local de la instantanea
+    if (!snap) {
+        perror("No se pudo asignar la instantanea");
+        return 1;
+    }
+
+    if (push_target) return run_push(push_target, &pool, snap, cpu.cores, &sampler);
+
+    while (1) {
+        sampler_begin(&sampler);
+        collector_pool_tick(&pool, &stats);                         // Todos los colectores en paralelo
+        collector_pool_snapshot(&pool, snap);                       // Instantanea consistente para imprimir
+        const sysinfo_snapshot *sys = collector_slot(&pool, snap, COL_SYSTEM);
+        MemoryInfo mem = get_memory_info(sys);
+        const float *cpu_loads = sys->core_load;                    // Carga del CPU por core
+        double interval = sampler_tick(&sampler, &mem, cpu_loads, cpu.cores);
+
         system("clear");                                            // Limpia la pantalla estilo terminal
 
         // Memoria
-        mem = get_memory_info();                                    // Obtiene la info de la memoria
         print_memory_info(mem);                                     // Imprime la info de la memoria
 
         // CPU
         print_cpu_info(cpu);                                        // Imprime la info del CPU
-        get_cpu_load_per_core(cpu_loads, cpu.cores);                // Obtiene la carga del CPU por core
         for (int i = 0; i < cpu.cores; i++) {                       // Imprime la carga del CPU por core
             printf("Core %d: %.2f%%\n", i, cpu_loads[i]);           // Imprime la carga del CPU por core
         }
+        if (procio) print_procio(collector_slot(&pool, snap, COL_PROCIO));
+        print_tick_stats(&stats, &pool);                            // Tiempo del tick contra el modo serie
+        printf("Intervalo: %.0f ms (proximo: %d ms)\n", interval, sampler.next_ms);
+        print_sampler_stats(&sampler);                              // Ahorro del modo adaptativo
 
-        sleep(2);                                                   // Espera 2 segundos
+        sampler_wait(&sampler);                                     // Espera el intervalo (fijo o adaptativo)
     }
 
+    collector_pool_destroy(&pool);
+    procio_close(procio_engine);
+    sysinfo_close(si);
+    free(sampler.prev_loads);
+    free(snap);
     return 0;                                                       // Retorna 0
 }
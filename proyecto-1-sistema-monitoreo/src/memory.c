@@ -1,29 +1,17 @@
 #include <stdio.h>
 #include "memory.h"
 
-MemoryInfo get_memory_info() {                                                              // Obtiene la info de la memoria
-    MemoryInfo mem = {0};                                                                   // Estructura para guardar info de la memoria
-    FILE *fp = fopen("/proc/meminfo", "r");                                                 // Abre el archivo /proc/meminfo
-    char line[256];                                                                         // Linea para leer el archivo
-
-    if (!fp) {                                                                              // Si no se pudo abrir el archivo
-        perror("No se pudo abrir /proc/meminfo");                                           // Manejo de errores
-        return mem;                                                                         // Retorna la estructura de la memoria
-    }
-
-    while (fgets(line, sizeof(line), fp)) {                                                 // Lee el archivo linea por linea
-        if (sscanf(line, "MemTotal: %ld kB", &mem.total) == 1) continue;                    // Guarda el total de memoria
-        if (sscanf(line, "MemFree: %ld kB", &mem.free) == 1) continue;                      // Guarda la memoria libre
-        if (sscanf(line, "MemAvailable: %ld kB", &mem.available) == 1) continue;            // Guarda la memoria disponible
-        if (sscanf(line, "SwapFree: %ld kB", &mem.swap_free) == 1) continue;                // Guarda la memoria swap libre
-        if (sscanf(line, "SwapTotal: %ld kB", &mem.swap_total) == 1) continue;              // Guarda la memoria swap total
-    }
-
-    fclose(fp);                                                                             // Cierra el archivo
-    mem.used = mem.total - mem.free;                                                        // física usada
-    mem.swap_used = mem.swap_total - mem.swap_free;                                         // virtual usada
+// La lectura de /proc/meminfo la hace libsysinfo; aca solo se pasa a MemoryInfo
+MemoryInfo get_memory_info(const sysinfo_snapshot *snap) {                                  // Obtiene la info de la memoria
+    MemoryInfo mem;                                                                         // Estructura para guardar info de la memoria
+    mem.total = (long)snap->mem_total;                                                      // Memoria total
+    mem.free = (long)snap->mem_free;                                                        // Memoria libre
+    mem.available = (long)snap->mem_available;                                              // Memoria disponible
+    mem.used = (long)snap->mem_used;                                                        // física usada
+    mem.swap_total = (long)snap->swap_total;                                                // Memoria swap total
+    mem.swap_free = (long)snap->swap_free;                                                  // Memoria swap libre
+    mem.swap_used = (long)snap->swap_used;                                                  // virtual usada
     return mem;                                                                             // Retorna la estructura de la memoria
-
 }
 
 void print_memory_info(MemoryInfo mem) {                                                    // Imprime la info de la memoria
@@ -0,0 +1,324 @@
+#define _GNU_SOURCE                                                                     // openat, O_DIRECTORY
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "procio.h"
+
+// Estrategia de costo acotado: en cada tick solo se leen los procesos "calientes"
+// (los que tuvieron actividad la ultima vez que se leyeron) mas una muestra
+// aleatoria de la lista; cada sweep_every ticks se hace un barrido completo que
+// refresca la lista de pids y descubre procesos nuevos.
+
+enum { F_READ, F_WRITE, F_SYSCR, F_SYSCW, F_MINFLT, F_MAJFLT, F_COUNT };               // Contadores por proceso
+
+// Ultima lectura de un proceso (casilla de la tabla hash, pid 0 = vacia)
+typedef struct {
+    int pid;
+    unsigned long long start;                                                           // starttime: detecta reuso del pid
+    double read_ms;                                                                     // Momento de la ultima lectura
+    long seen_tick;                                                                     // Ultimo tick en que fue candidato
+    uint64_t prev[F_COUNT];                                                             // Contadores de la ultima lectura
+} ProcEntry;
+
+struct ProcIOEngine {
+    int proc_fd;                                                                        // Directorio /proc para openat
+    int top_n;                                                                          // Procesos a reportar
+    int sample_size;                                                                    // Procesos aleatorios por tick
+    int sweep_every;                                                                    // Ticks entre barridos completos
+    long tick;
+    uint64_t rng;                                                                       // Estado xorshift propio
+
+    int *pids;                                                                          // Pids del ultimo barrido
+    size_t npids, pids_cap;
+    int *hot;                                                                           // Procesos con actividad reciente
+    size_t nhot, hot_cap;
+    int *cand;                                                                          // Candidatos del tick
+    size_t cand_cap;
+    ProcIOStat *results;                                                                // Tasas de los candidatos leidos
+    size_t results_cap;
+
+    ProcEntry *table;                                                                   // pid -> ultima lectura
+    size_t capacity, count;
+    char buf[4096];                                                                     // Buffer de lectura de /proc
+};
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static uint64_t next_rand(ProcIOEngine *e) {
+    e->rng ^= e->rng << 13;
+    e->rng ^= e->rng >> 7;
+    e->rng ^= e->rng << 17;
+    return e->rng;
+}
+
+// Agranda un arreglo al menos a need elementos
+static int reserve(void **arr, size_t *cap, size_t need, size_t elem) {
+    if (need <= *cap) return 0;
+    size_t n = *cap ? *cap : 256;
+    while (n < need) n *= 2;
+    void *p = realloc(*arr, n * elem);
+    if (!p) return -1;
+    *arr = p;
+    *cap = n;
+    return 0;
+}
+
+static size_t pid_hash(int pid, size_t mask) {
+    return ((uint32_t)pid * 2654435761u) & mask;
+}
+
+// Busca el pid o la casilla vacia donde iria (sondeo lineal)
+static ProcEntry *table_slot(ProcEntry *table, size_t capacity, int pid) {
+    size_t mask = capacity - 1;
+    size_t i = pid_hash(pid, mask);
+    while (table[i].pid != 0 && table[i].pid != pid) i = (i + 1) & mask;
+    return &table[i];
+}
+
+// Reconstruye la tabla con solo los pids vivos: los muertos desaparecen sin lapidas
+static int table_rebuild(ProcIOEngine *e) {
+    size_t cap = 1024;
+    while (cap < e->npids * 2) cap <<= 1;                                               // Carga maxima 50%
+    ProcEntry *table = calloc(cap, sizeof(ProcEntry));
+    size_t count = 0;
+    if (!table) return -1;
+
+    for (size_t i = 0; i < e->npids; i++) {
+        ProcEntry *dst = table_slot(table, cap, e->pids[i]);
+        if (dst->pid) continue;                                                         // Pid repetido
+        if (e->table) {
+            ProcEntry *old = table_slot(e->table, e->capacity, e->pids[i]);
+            if (old->pid) *dst = *old;                                                  // Conserva su linea base
+        }
+        dst->pid = e->pids[i];
+        count++;
+    }
+    free(e->table);
+    e->table = table;
+    e->capacity = cap;
+    e->count = count;
+    return 0;
+}
+
+// Lista todos los pids de /proc
+static int list_pids(ProcIOEngine *e) {
+    int fd = dup(e->proc_fd);
+    DIR *dir = fd >= 0 ? fdopendir(fd) : NULL;
+    struct dirent *de;
+
+    if (!dir) {
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    rewinddir(dir);
+    e->npids = 0;
+    while ((de = readdir(dir)) != NULL) {
+        if (de->d_name[0] < '1' || de->d_name[0] > '9') continue;                       // Solo directorios numericos
+        if (reserve((void **)&e->pids, &e->pids_cap, e->npids + 1, sizeof(int)) != 0) break;
+        e->pids[e->npids++] = atoi(de->d_name);
+    }
+    closedir(dir);
+    return 0;
+}
+
+// Lee un archivo de /proc/<pid>/ en el buffer del motor
+static ssize_t read_proc_file(ProcIOEngine *e, int pid, const char *name) {
+    char path[32];
+    snprintf(path, sizeof(path), "%d/%s", pid, name);
+    int fd = openat(e->proc_fd, path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -errno;
+    ssize_t n = read(fd, e->buf, sizeof(e->buf) - 1);
+    int err = errno;
+    close(fd);
+    if (n < 0) return -err;
+    e->buf[n] = '\0';
+    return n;
+}
+
+// Avanza al inicio de la siguiente linea, NULL al final del buffer
+static const char *next_line(const char *p) {
+    p = strchr(p, '\n');
+    return p ? p + 1 : NULL;
+}
+
+static const char *skip_fields(const char *p, int n) {
+    while (n-- > 0 && p) {
+        p = strchr(p, ' ');
+        if (p) p++;
+    }
+    return p;
+}
+
+// /proc/<pid>/stat: comm, minflt (campo 10), majflt (12) y starttime (22)
+static int read_stat(ProcIOEngine *e, int pid, char *comm, uint64_t *c, unsigned long long *start) {
+    if (read_proc_file(e, pid, "stat") <= 0) return -1;
+    char *lp = strchr(e->buf, '(');
+    char *rp = strrchr(e->buf, ')');                                                    // El comm puede tener ')' adentro
+    if (!lp || !rp || rp < lp) return -1;
+
+    size_t len = (size_t)(rp - lp - 1);
+    if (len > 15) len = 15;
+    memcpy(comm, lp + 1, len);
+    comm[len] = '\0';
+
+    const char *p = rp + 2;                                                             // Campo 3 (state)
+    p = skip_fields(p, 7);                                                              // Campo 10
+    if (!p) return -1;
+    c[F_MINFLT] = strtoull(p, NULL, 10);
+    p = skip_fields(p, 2);                                                              // Campo 12
+    if (!p) return -1;
+    c[F_MAJFLT] = strtoull(p, NULL, 10);
+    p = skip_fields(p, 10);                                                             // Campo 22
+    if (!p) return -1;
+    *start = strtoull(p, NULL, 10);
+    return 0;
+}
+
+// /proc/<pid>/io: syscr, syscw, read_bytes y write_bytes
+static int read_io(ProcIOEngine *e, int pid, uint64_t *c) {
+    static const struct { const char *key; size_t len; int field; } keys[] = {
+        {"syscr: ", 7, F_SYSCR},
+        {"syscw: ", 7, F_SYSCW},
+        {"read_bytes: ", 12, F_READ},
+        {"write_bytes: ", 13, F_WRITE},
+    };
+    ssize_t n = read_proc_file(e, pid, "io");
+    if (n < 0) return (int)n;
+
+    for (const char *p = e->buf; p && *p; p = next_line(p)) {
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++) {
+            if (strncmp(p, keys[k].key, keys[k].len) == 0) {
+                c[keys[k].field] = strtoull(p + keys[k].len, NULL, 10);
+                break;
+            }
+        }
+    }
+    return 0;
+}
+
+ProcIOEngine *procio_open(const char *proc_root, int top_n, int sample_size, int sweep_every) {
+    ProcIOEngine *e = calloc(1, sizeof(*e));
+    if (!e) return NULL;
+
+    e->proc_fd = open(proc_root ? proc_root : "/proc", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (e->proc_fd < 0) {
+        free(e);
+        return NULL;
+    }
+    e->top_n = top_n < 1 ? 1 : (top_n > PROCIO_TOP_MAX ? PROCIO_TOP_MAX : top_n);
+    e->sample_size = sample_size < 0 ? 0 : sample_size;
+    e->sweep_every = sweep_every < 1 ? 1 : sweep_every;
+    e->rng = (uint64_t)time(NULL) * 0x9E3779B97F4A7C15ULL | 1;
+    return e;
+}
+
+// Agrega un candidato si todavia no esta en la lista de este tick
+static void add_candidate(ProcIOEngine *e, size_t *n, int pid) {
+    ProcEntry *entry = table_slot(e->table, e->capacity, pid);
+    if (!entry->pid) {                                                                  // Nuevo desde el ultimo barrido
+        if ((e->count + 1) * 2 > e->capacity) return;                                   // Esperara al proximo barrido
+        entry->pid = pid;
+        e->count++;
+    }
+    if (entry->seen_tick == e->tick) return;                                            // Repetido
+    entry->seen_tick = e->tick;
+    e->cand[(*n)++] = pid;
+}
+
+static double score(const ProcIOStat *s) {
+    return s->read_bytes + s->write_bytes;
+}
+
+static int cmp_score(const void *a, const void *b) {
+    const ProcIOStat *x = a, *y = b;
+    double dx = score(x), dy = score(y);
+    if (dx != dy) return dx < dy ? 1 : -1;                                              // Mayor consumo primero
+    double sx = x->syscr + x->syscw, sy = y->syscr + y->syscw;
+    return (sx < sy) - (sx > sy);
+}
+
+void procio_sample(ProcIOEngine *e, ProcIOTop *out) {
+    double t0 = now_ms();
+    size_t ncand = 0, nres = 0;
+
+    memset(out, 0, sizeof(*out));
+    e->tick++;
+    out->scan.full_sweep = e->table == NULL || e->tick % e->sweep_every == 0;
+    if (out->scan.full_sweep) {
+        if (list_pids(e) != 0 || table_rebuild(e) != 0) return;
+    }
+
+    size_t want = out->scan.full_sweep ? e->npids : e->nhot + (size_t)e->sample_size;
+    if (reserve((void **)&e->cand, &e->cand_cap, want, sizeof(int)) != 0) return;
+    if (reserve((void **)&e->results, &e->results_cap, want, sizeof(ProcIOStat)) != 0) return;
+
+    if (out->scan.full_sweep) {                                                         // Todos los procesos
+        for (size_t i = 0; i < e->npids; i++) add_candidate(e, &ncand, e->pids[i]);
+    } else {                                                                            // Calientes + muestra aleatoria
+        for (size_t i = 0; i < e->nhot; i++) add_candidate(e, &ncand, e->hot[i]);
+        for (int i = 0; i < e->sample_size && e->npids > 0; i++) {
+            add_candidate(e, &ncand, e->pids[next_rand(e) % e->npids]);
+        }
+    }
+
+    for (size_t i = 0; i < ncand; i++) {
+        int pid = e->cand[i];
+        uint64_t c[F_COUNT] = {0};
+        unsigned long long start;
+        ProcIOStat *r = &e->results[nres];
+
+        if (read_stat(e, pid, r->comm, c, &start) != 0) continue;                       // Proceso terminado
+        if (read_io(e, pid, c) == -EACCES) out->scan.denied++;                          // Sin permiso: solo fallos de pagina
+        out->scan.procs_read++;
+
+        double t = now_ms();
+        ProcEntry *entry = table_slot(e->table, e->capacity, pid);
+        int baseline = entry->read_ms == 0.0 || entry->start != start;                  // Primera lectura o pid reusado
+        double secs = (t - entry->read_ms) / 1000.0;
+        if (!baseline && secs > 0.0) {
+            double *rate[F_COUNT] = {&r->read_bytes, &r->write_bytes, &r->syscr, &r->syscw, &r->minflt, &r->majflt};
+            for (int f = 0; f < F_COUNT; f++) {
+                *rate[f] = c[f] >= entry->prev[f] ? (c[f] - entry->prev[f]) / secs : 0.0;
+            }
+            r->pid = pid;
+            if (score(r) > 0.0 || r->syscr + r->syscw + r->minflt + r->majflt > 0.0) nres++;   // Solo procesos activos
+        }
+        entry->start = start;
+        entry->read_ms = t;
+        memcpy(entry->prev, c, sizeof(c));
+    }
+
+    qsort(e->results, nres, sizeof(ProcIOStat), cmp_score);
+
+    // Los mas activos se vuelven a leer en el proximo tick
+    size_t hot_max = (size_t)e->top_n * 4;
+    if (reserve((void **)&e->hot, &e->hot_cap, hot_max, sizeof(int)) == 0) {
+        e->nhot = nres < hot_max ? nres : hot_max;
+        for (size_t i = 0; i < e->nhot; i++) e->hot[i] = e->results[i].pid;
+    }
+
+    out->count = nres < (size_t)e->top_n ? (int)nres : e->top_n;
+    memcpy(out->top, e->results, out->count * sizeof(ProcIOStat));
+    out->scan.procs_total = (long)e->npids;
+    out->scan.scan_ms = now_ms() - t0;
+}
+
+void procio_close(ProcIOEngine *e) {
+    if (!e) return;
+    close(e->proc_fd);
+    free(e->pids);
+    free(e->hot);
+    free(e->cand);
+    free(e->results);
+    free(e->table);
+    free(e);
+}
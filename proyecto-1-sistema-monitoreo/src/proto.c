@@ -0,0 +1,124 @@
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "proto.h"
+
+// Escribe un entero sin signo como varint (7 bits por byte)
+static uint8_t *put_uvarint(uint8_t *p, uint8_t *end, uint64_t v) {
+    while (p && p < end) {                                                              // Mientras haya espacio
+        if (v < 0x80) {                                                                 // Ultimo byte
+            *p++ = (uint8_t)v;
+            return p;
+        }
+        *p++ = (uint8_t)(v | 0x80);                                                     // Byte con bit de continuacion
+        v >>= 7;
+    }
+    return NULL;                                                                        // No cupo en el buffer
+}
+
+// Los campos de memoria son long: se codifican en zigzag por si llegan negativos
+static uint8_t *put_svarint(uint8_t *p, uint8_t *end, long v) {
+    int64_t x = (int64_t)v;
+    return put_uvarint(p, end, ((uint64_t)x << 1) ^ (uint64_t)(x >> 63));
+}
+
+// Lee un varint sin signo, retorna NULL si el paquete esta truncado
+static const uint8_t *get_uvarint(const uint8_t *p, const uint8_t *end, uint64_t *out) {
+    uint64_t v = 0;
+    for (int shift = 0; p && p < end && shift < 64; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {                                                              // Fin del varint
+            *out = v;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+static const uint8_t *get_svarint(const uint8_t *p, const uint8_t *end, long *out) {
+    uint64_t u;
+    p = get_uvarint(p, end, &u);
+    if (p) *out = (long)(int64_t)((u >> 1) ^ (~(u & 1) + 1));                          // Deshace el zigzag
+    return p;
+}
+
+// Codifica una muestra: las cargas viajan en centesimas de porcentaje (0..10000)
+size_t proto_encode(const Sample *s, uint8_t *buf, size_t cap) {
+    uint8_t *end = buf + cap;
+    uint8_t *p = buf;
+    int cores = s->cores;
+
+    if (cap < 2 || cores < 0 || cores > PROTO_MAX_CORES) return 0;                      // Parametros invalidos
+    *p++ = PROTO_MAGIC;
+    *p++ = PROTO_VERSION;
+    p = put_uvarint(p, end, s->host_id);
+    p = put_uvarint(p, end, s->boot);
+    p = put_uvarint(p, end, s->seq);
+    p = put_uvarint(p, end, s->interval_ms);
+    p = put_svarint(p, end, s->mem.total);
+    p = put_svarint(p, end, s->mem.free);
+    p = put_svarint(p, end, s->mem.available);
+    p = put_svarint(p, end, s->mem.swap_total);
+    p = put_svarint(p, end, s->mem.swap_free);
+    p = put_uvarint(p, end, (uint64_t)cores);
+    for (int i = 0; i < cores; i++) {
+        float load = s->loads[i];
+        if (!(load > 0.0f)) load = 0.0f;                                                // Tambien descarta NaN
+        if (load > 100.0f) load = 100.0f;
+        p = put_uvarint(p, end, (uint64_t)(load * 100.0f + 0.5f));
+    }
+    return p ? (size_t)(p - buf) : 0;
+}
+
+int proto_decode(const uint8_t *buf, size_t len, Sample *s) {
+    const uint8_t *end = buf + len;
+    const uint8_t *p = buf;
+    uint64_t v;
+
+    if (len < 2 || p[0] != PROTO_MAGIC || p[1] != PROTO_VERSION) return -1;            // No es un paquete nuestro
+    p += 2;
+    memset(&s->mem, 0, sizeof(s->mem));
+    p = get_uvarint(p, end, &s->host_id);
+    p = get_uvarint(p, end, &v);
+    s->boot = (uint32_t)v;
+    p = get_uvarint(p, end, &v);
+    s->seq = (uint32_t)v;
+    p = get_uvarint(p, end, &v);
+    s->interval_ms = (uint32_t)v;
+    p = get_svarint(p, end, &s->mem.total);
+    p = get_svarint(p, end, &s->mem.free);
+    p = get_svarint(p, end, &s->mem.available);
+    p = get_svarint(p, end, &s->mem.swap_total);
+    p = get_svarint(p, end, &s->mem.swap_free);
+    p = get_uvarint(p, end, &v);
+    if (!p || v > PROTO_MAX_CORES) return -1;                                           // Truncado o demasiados cores
+    s->cores = (int)v;
+    for (int i = 0; i < s->cores; i++) {
+        p = get_uvarint(p, end, &v);
+        if (!p) return -1;
+        s->loads[i] = (float)v / 100.0f;
+    }
+    s->mem.used = s->mem.total - s->mem.free;                                           // Igual que sysinfo_sample()
+    s->mem.swap_used = s->mem.swap_total - s->mem.swap_free;
+    return 0;
+}
+
+// FNV-1a de 64 bits: suficiente para distinguir hosts de una flota
+uint64_t proto_host_id(const char *hostname) {
+    uint64_t h = 1469598103934665603ULL;
+    for (const unsigned char *c = (const unsigned char *)hostname; *c; c++) {
+        h ^= *c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Mezcla la hora y el pid: dos arranques del mismo host no repiten id
+uint32_t proto_boot_id(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    uint64_t x = ((uint64_t)ts.tv_sec << 32) ^ (uint64_t)ts.tv_nsec ^ ((uint64_t)getpid() << 40);
+    x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdULL;
+    return (uint32_t)(x ^ (x >> 33));
+}
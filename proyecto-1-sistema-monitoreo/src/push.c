@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include "push.h"
+
+// Abre un socket UDP conectado al destino "host:puerto"
+int push_open(const char *target) {
+    char host[256];                                                                     // Copia del host sin el puerto
+    const char *colon = strrchr(target, ':');                                           // Separador host:puerto
+    struct addrinfo hints = {0}, *res, *ai;
+    int fd = -1;
+
+    if (!colon || colon == target || (size_t)(colon - target) >= sizeof(host)) {        // Formato invalido
+        fprintf(stderr, "Destino invalido '%s' (use host:puerto)\n", target);
+        return -1;
+    }
+    memcpy(host, target, colon - target);
+    host[colon - target] = '\0';
+
+    hints.ai_family = AF_UNSPEC;                                                        // IPv4 o IPv6
+    hints.ai_socktype = SOCK_DGRAM;                                                     // UDP
+    int rc = getaddrinfo(host, colon + 1, &hints, &res);
+    if (rc != 0) {
+        fprintf(stderr, "No se pudo resolver %s: %s\n", target, gai_strerror(rc));
+        return -1;
+    }
+
+    for (ai = res; ai; ai = ai->ai_next) {                                              // Prueba cada direccion
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;                       // connect() en UDP fija el destino
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+
+    if (fd < 0) perror("No se pudo abrir el socket UDP");
+    return fd;
+}
+
+// Envia una muestra en un solo datagrama
+int push_send(int fd, const Sample *s) {
+    uint8_t buf[PROTO_MAX_PACKET];                                                      // Paquete codificado
+    size_t len = proto_encode(s, buf, sizeof(buf));
+
+    if (len == 0) return -1;                                                            // No cabe en un datagrama
+    return send(fd, buf, len, 0) == (ssize_t)len ? 0 : -1;
+}
+
+// Simula una flota: cada host tiene su propio id y cargas que varian suavemente.
+// En cada ronda `restarts` hosts (rotando) simulan un reinicio: id de arranque
+// nuevo y secuencia desde 1, como un system_info recien lanzado
+int push_simulate(const char *target, int hosts, int interval_ms, int restarts) {
+    int fd = push_open(target);
+    Sample *fleet;                                                                      // Estado de cada host simulado
+    long sent = 0, errors = 0, restarted = 0;                                           // Contadores de envio
+    int next_restart = 0;                                                               // Proximo host a reiniciar
+
+    if (fd < 0) return -1;
+    fleet = calloc(hosts, sizeof(Sample));
+    if (!fleet) {
+        perror("No se pudo asignar memoria para la simulacion");
+        close(fd);
+        return -1;
+    }
+
+    srand((unsigned int)time(NULL));
+    for (int h = 0; h < hosts; h++) {                                                   // Inicializa cada host
+        char name[32];
+        snprintf(name, sizeof(name), "sim-%d", h);
+        fleet[h].host_id = proto_host_id(name);
+        fleet[h].boot = proto_boot_id() + (uint32_t)h;
+        fleet[h].cores = 4 << (h % 4);                                                  // 4, 8, 16 o 32 cores
+        fleet[h].mem.total = 8L * 1024 * 1024 << (h % 3);                               // 8, 16 o 32 GB en KB
+        fleet[h].mem.swap_total = 4L * 1024 * 1024;
+        fleet[h].mem.swap_free = fleet[h].mem.swap_total;
+        for (int c = 0; c < fleet[h].cores; c++) fleet[h].loads[c] = rand() % 100;
+    }
+
+    printf("Simulando %d hosts hacia %s cada %d ms\n", hosts, target, interval_ms);
+    while (1) {
+        for (int r = 0; r < restarts && r < hosts; r++) {                               // Reinicios de esta ronda
+            Sample *s = &fleet[next_restart];
+            s->boot = proto_boot_id() + (uint32_t)next_restart;
+            s->seq = 0;
+            next_restart = (next_restart + 1) % hosts;
+            restarted++;
+        }
+        for (int h = 0; h < hosts; h++) {
+            Sample *s = &fleet[h];
+            for (int c = 0; c < s->cores; c++) {                                        // Camina aleatoria en [0, 100]
+                float v = s->loads[c] + (float)(rand() % 21 - 10);
+                s->loads[c] = v < 0 ? 0 : (v > 100 ? 100 : v);
+            }
+            s->mem.available = s->mem.total / 100 * (10 + rand() % 80);
+            s->mem.free = s->mem.available / 2;
+            s->seq++;
+            s->interval_ms = interval_ms;
+            if (push_send(fd, s) == 0) sent++; else errors++;
+        }
+        printf("\rEnviados: %ld  Errores: %ld  Reinicios: %ld", sent, errors, restarted);
+        fflush(stdout);
+
+        struct timespec delay = {interval_ms / 1000, (interval_ms % 1000) * 1000000L};
+        nanosleep(&delay, NULL);
+    }
+
+    free(fleet);
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,200 @@
+#define _GNU_SOURCE                                                                     // pread, O_CLOEXEC
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sysinfo.h"
+
+#define SYSINFO_VERSION_STR "1.0.0"
+
+// Contadores de /proc/stat de un core (en jiffies)
+typedef struct {
+    uint64_t busy;                                                                      // Todo menos idle e iowait
+    uint64_t total;                                                                     // Suma de todos los campos
+} CpuTicks;
+
+// Todo el estado vive en el handle: no hay variables globales
+struct sysinfo {
+    int stat_fd;                                                                        // /proc/stat abierto una sola vez
+    int meminfo_fd;                                                                     // /proc/meminfo abierto una sola vez
+    char *buf;                                                                          // Buffer de lectura reutilizable
+    size_t buf_size;
+    char model_name[SYSINFO_MODEL_LEN];                                                 // Leido una vez al abrir
+    uint64_t prev_ns;                                                                   // Momento de la muestra anterior
+    CpuTicks prev_all;                                                                  // Linea "cpu" anterior
+    CpuTicks prev[SYSINFO_MAX_CORES];                                                   // Lineas "cpuN" anteriores
+};
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Lee el archivo completo desde el inicio con pread (sin reabrirlo), agrandando el buffer si hace falta
+static ssize_t read_whole(struct sysinfo *si, int fd) {
+    for (;;) {
+        ssize_t n = pread(fd, si->buf, si->buf_size - 1, 0);
+        if (n < 0) return -errno;
+        if ((size_t)n < si->buf_size - 1) {                                             // Cupo completo
+            si->buf[n] = '\0';
+            return n;
+        }
+        char *bigger = realloc(si->buf, si->buf_size * 2);
+        if (!bigger) return -ENOMEM;
+        si->buf = bigger;
+        si->buf_size *= 2;
+    }
+}
+
+// Parseo de enteros sin sscanf: salta espacios y lee digitos
+static const char *parse_u64(const char *p, uint64_t *out) {
+    uint64_t v = 0;
+    while (*p == ' ' || *p == '\t') p++;
+    while (*p >= '0' && *p <= '9') v = v * 10 + (uint64_t)(*p++ - '0');
+    *out = v;
+    return p;
+}
+
+// Parsea "user nice system idle iowait irq softirq steal" de una linea cpu
+static const char *parse_ticks(const char *p, CpuTicks *t) {
+    uint64_t v[8] = {0};
+    for (int i = 0; i < 8 && *p != '\n' && *p; i++) p = parse_u64(p, &v[i]);
+    t->total = v[0] + v[1] + v[2] + v[3] + v[4] + v[5] + v[6] + v[7];
+    t->busy = t->total - v[3] - v[4];                                                   // idle + iowait no es carga
+    return p;
+}
+
+// Avanza al inicio de la siguiente linea, NULL al final del buffer
+static const char *next_line(const char *p) {
+    p = strchr(p, '\n');
+    return p ? p + 1 : NULL;
+}
+
+static float load_between(const CpuTicks *prev, const CpuTicks *cur) {
+    uint64_t total = cur->total - prev->total;
+    return total ? (float)(cur->busy - prev->busy) * 100.0f / (float)total : 0.0f;
+}
+
+static int sample_cpu(struct sysinfo *si, sysinfo_snapshot *snap) {
+    ssize_t n = read_whole(si, si->stat_fd);
+    if (n < 0) return (int)n;
+
+    uint32_t cores = 0;
+    for (const char *p = si->buf; p && strncmp(p, "cpu", 3) == 0; p = next_line(p)) {
+        CpuTicks t;
+        if (p[3] == ' ') {                                                              // Linea agregada "cpu"
+            parse_ticks(p + 3, &t);
+            snap->cpu_load = load_between(&si->prev_all, &t);
+            si->prev_all = t;
+            continue;
+        }
+        uint64_t idx;
+        const char *q = parse_u64(p + 3, &idx);
+        if (idx >= SYSINFO_MAX_CORES) continue;
+        parse_ticks(q, &t);
+        snap->core_load[idx] = load_between(&si->prev[idx], &t);
+        si->prev[idx] = t;
+        if (idx + 1 > cores) cores = (uint32_t)idx + 1;
+    }
+    snap->cores = cores;
+    return 0;
+}
+
+static int sample_memory(struct sysinfo *si, sysinfo_snapshot *snap) {
+    // Tabla de claves de /proc/meminfo y el campo de la instantanea que llenan
+    static const struct { const char *key; size_t len; size_t off; } fields[] = {
+        {"MemTotal:", 9, offsetof(sysinfo_snapshot, mem_total)},
+        {"MemFree:", 8, offsetof(sysinfo_snapshot, mem_free)},
+        {"MemAvailable:", 13, offsetof(sysinfo_snapshot, mem_available)},
+        {"SwapTotal:", 10, offsetof(sysinfo_snapshot, swap_total)},
+        {"SwapFree:", 9, offsetof(sysinfo_snapshot, swap_free)},
+    };
+    ssize_t n = read_whole(si, si->meminfo_fd);
+    if (n < 0) return (int)n;
+
+    for (const char *p = si->buf; p && *p; p = next_line(p)) {
+        for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+            if (strncmp(p, fields[i].key, fields[i].len) == 0) {
+                uint64_t v;
+                parse_u64(p + fields[i].len, &v);
+                *(int64_t *)((char *)snap + fields[i].off) = (int64_t)v;
+                break;
+            }
+        }
+    }
+    snap->mem_used = snap->mem_total - snap->mem_free;                                  // Fisica usada: total - libre
+    snap->swap_used = snap->swap_total - snap->swap_free;
+    return 0;
+}
+
+// El nombre del CPU no cambia: se lee una sola vez
+static void read_model_name(struct sysinfo *si) {
+    int fd = open("/proc/cpuinfo", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    ssize_t n = read_whole(si, fd);
+    close(fd);
+    if (n <= 0) return;
+
+    const char *p = strstr(si->buf, "model name");
+    if (!p || !(p = strchr(p, ':'))) return;
+    p++;
+    while (*p == ' ' || *p == '\t') p++;
+    size_t len = strcspn(p, "\n");
+    if (len >= sizeof(si->model_name)) len = sizeof(si->model_name) - 1;
+    memcpy(si->model_name, p, len);
+    si->model_name[len] = '\0';
+}
+
+sysinfo_t *sysinfo_open(void) {
+    struct sysinfo *si = calloc(1, sizeof(*si));
+    if (!si) return NULL;
+
+    si->buf_size = 8192;
+    si->buf = malloc(si->buf_size);
+    si->stat_fd = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+    si->meminfo_fd = open("/proc/meminfo", O_RDONLY | O_CLOEXEC);
+    if (!si->buf || si->stat_fd < 0 || si->meminfo_fd < 0) {
+        int err = si->buf ? errno : ENOMEM;
+        sysinfo_close(si);
+        errno = err;
+        return NULL;
+    }
+    read_model_name(si);
+    return si;
+}
+
+int sysinfo_sample(sysinfo_t *si, sysinfo_snapshot *snap) {
+    sysinfo_snapshot full;                                                              // Version completa local
+    int rc;
+
+    if (!si || !snap || snap->size < offsetof(sysinfo_snapshot, timestamp_ns)) return -EINVAL;
+    memset(&full, 0, sizeof(full));
+    full.size = snap->size < sizeof(full) ? snap->size : (uint32_t)sizeof(full);
+    full.version = SYSINFO_ABI_VERSION;
+    full.timestamp_ns = monotonic_ns();
+    full.interval_ns = si->prev_ns ? full.timestamp_ns - si->prev_ns : 0;
+    memcpy(full.model_name, si->model_name, sizeof(full.model_name));
+
+    if ((rc = sample_memory(si, &full)) != 0) return rc;
+    if ((rc = sample_cpu(si, &full)) != 0) return rc;
+    si->prev_ns = full.timestamp_ns;
+
+    memcpy(snap, &full, full.size);                                                     // Solo lo que el llamador conoce
+    return 0;
+}
+
+void sysinfo_close(sysinfo_t *si) {
+    if (!si) return;
+    if (si->stat_fd >= 0) close(si->stat_fd);
+    if (si->meminfo_fd >= 0) close(si->meminfo_fd);
+    free(si->buf);
+    free(si);
+}
+
+const char *sysinfo_version(void) {
+    return SYSINFO_VERSION_STR;
+}
@@ -0,0 +1,24 @@
+#include <stdlib.h>
+#include "actuator.h"
+
+/* Modo silencioso compartido por todos los actuadores */
+static bool quiet = false;
+
+void actuator_set_quiet(bool q) {
+    quiet = q;
+}
+
+bool actuator_is_quiet(void) {
+    return quiet;
+}
+
+/* Actuador sin salida */
+static void none_set_on(void *params) { *(bool *)params = true; }
+static void none_set_off(void *params) { *(bool *)params = false; }
+static bool none_status(void *params) { return *(bool *)params; }
+
+Actuator create_none_actuator(arena_t *arena) {
+    bool *params = arena ? arena_alloc(arena, sizeof(bool)) : calloc(1, sizeof(bool));
+    Actuator a = {params, none_set_on, none_set_off, none_status};
+    return a;
+}
@@ -2,6 +2,7 @@
 #define ACTUATOR_H
 
 #include <stdbool.h>
+#include "../common/arena.h"
 
 /* Definición de una interfaz polimórfica para actuadores */
 typedef struct {
@@ -11,4 +12,18 @@ typedef struct {
     bool (*status)(void *params);                /* Estado actual (ON/OFF) */
 } Actuator;
 
+/* Modo silencioso: los actuadores dejan de imprimir al cambiar de estado
+ * (por ejemplo cuando el estado ya queda en el log de eventos) */
+extern void actuator_set_quiet(bool quiet);
+extern bool actuator_is_quiet(void);
+
+/* Fábricas de actuadores: params sale de la arena y se libera con ella.
+ * Con arena NULL se usa malloc y el llamador libera params con free().
+ * Si no hay memoria, params queda en NULL. */
+extern Actuator create_led_actuator(arena_t *arena);
+extern Actuator create_buzzer_actuator(arena_t *arena);
+
+/* Actuador sin salida (solo guarda su estado), para pruebas y benchmarks */
+extern Actuator create_none_actuator(arena_t *arena);
+
 #endif /* ACTUATOR_H */
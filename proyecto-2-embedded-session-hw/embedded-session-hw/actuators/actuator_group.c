@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "actuator_group.h"
+
+bool actuator_group_init(ActuatorGroup *g, arena_t *arena, size_t count, const char *name,
+                         void (*apply_many)(void *, const uint64_t *, const uint64_t *, size_t)) {
+    size_t words = ACTUATOR_GROUP_WORDS(count);
+    size_t bytes = 2 * (words ? words : 1) * sizeof(uint64_t);
+    uint64_t *bits = arena ? arena_alloc(arena, bytes) : calloc(1, bytes);
+
+    g->params = NULL;
+    g->name = name;
+    g->count = bits ? count : 0;
+    g->words = bits ? words : 0;
+    g->state = bits;
+    g->changed = bits ? bits + words : NULL;
+    g->apply_many = apply_many;
+    return bits != NULL;
+}
+
+size_t actuator_group_apply(ActuatorGroup *g, const uint64_t *desired) {
+    uint64_t *restrict state = g->state, *restrict changed = g->changed;
+    size_t words = g->words;
+    if (words == 0) return 0;
+
+    /* Diff por palabra; la última sin los bits de más */
+    uint64_t tail = g->count % 64 ? ((uint64_t)1 << (g->count % 64)) - 1 : ~(uint64_t)0;
+    size_t n = 0;
+    for (size_t w = 0; w < words; w++) {
+        uint64_t c = state[w] ^ desired[w];
+        if (w == words - 1) c &= tail;
+        changed[w] = c;
+        n += (size_t)__builtin_popcountll(c);
+    }
+    if (n == 0) return 0;
+
+    g->apply_many(g->params, changed, desired, words);
+    for (size_t w = 0; w < words; w++) state[w] ^= changed[w];
+    return n;
+}
+
+/* Grupo de LEDs: un mensaje por salida que cambia */
+static void led_apply_many(void *params, const uint64_t *changed, const uint64_t *desired, size_t words) {
+    (void)params;
+    if (actuator_is_quiet()) return;
+    for (size_t w = 0; w < words; w++) {
+        for (uint64_t m = changed[w]; m; m &= m - 1) {
+            size_t i = w * 64 + (size_t)__builtin_ctzll(m);
+            printf("[LED %zu] %s\n", i, (desired[w] >> (i % 64)) & 1u ? "Encendido" : "Apagado");
+        }
+    }
+}
+
+ActuatorGroup create_led_group(arena_t *arena, size_t count) {
+    ActuatorGroup g;
+    actuator_group_init(&g, arena, count, "LED", led_apply_many);
+    return g;
+}
+
+/* Grupo de buzzers: un mensaje por salida que cambia */
+static void buzzer_apply_many(void *params, const uint64_t *changed, const uint64_t *desired, size_t words) {
+    (void)params;
+    if (actuator_is_quiet()) return;
+    for (size_t w = 0; w < words; w++) {
+        for (uint64_t m = changed[w]; m; m &= m - 1) {
+            size_t i = w * 64 + (size_t)__builtin_ctzll(m);
+            printf("[BUZZER %zu] %s\n", i, (desired[w] >> (i % 64)) & 1u ? "Activado" : "Desactivado");
+        }
+    }
+}
+
+ActuatorGroup create_buzzer_group(arena_t *arena, size_t count) {
+    ActuatorGroup g;
+    actuator_group_init(&g, arena, count, "BUZZER", buzzer_apply_many);
+    return g;
+}
+
+/* Grupo sin salida: el bitset de estado es todo */
+static void none_apply_many(void *params, const uint64_t *changed, const uint64_t *desired, size_t words) {
+    (void)params;
+    (void)changed;
+    (void)desired;
+    (void)words;
+}
+
+ActuatorGroup create_none_group(arena_t *arena, size_t count) {
+    ActuatorGroup g;
+    actuator_group_init(&g, arena, count, "NONE", none_apply_many);
+    return g;
+}
+
+/* Adaptador sobre actuadores individuales */
+static void wrap_apply_many(void *params, const uint64_t *changed, const uint64_t *desired, size_t words) {
+    Actuator *acts = params;
+    for (size_t w = 0; w < words; w++) {
+        for (uint64_t m = changed[w]; m; m &= m - 1) {
+            size_t i = w * 64 + (size_t)__builtin_ctzll(m);
+            if ((desired[w] >> (i % 64)) & 1u) acts[i].activate(acts[i].params);
+            else acts[i].deactivate(acts[i].params);
+        }
+    }
+}
+
+ActuatorGroup actuator_group_wrap(arena_t *arena, Actuator *acts, size_t count) {
+    ActuatorGroup g;
+    if (actuator_group_init(&g, arena, count, "GRUPO", wrap_apply_many)) {
+        g.params = acts;
+        for (size_t i = 0; i < count; i++) actuator_group_set(g.state, i, acts[i].status(acts[i].params));
+    }
+    return g;
+}
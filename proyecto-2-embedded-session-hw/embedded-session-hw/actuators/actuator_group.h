@@ -0,0 +1,62 @@
+#ifndef ACTUATOR_GROUP_H
+#define ACTUATOR_GROUP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "actuator.h"
+#include "../common/arena.h"
+
+/* Grupo de actuadores manejado por lotes: el estado de todas las salidas es
+ * un bitset (bit i = salida i) y el llamador pide el estado deseado
+ * completo de una vez. actuator_group_apply() compara contra el estado
+ * actual y hace una sola llamada indirecta por grupo con los cambios; las
+ * salidas que no cambian no se tocan. */
+
+/* Palabras de 64 bits para n salidas */
+#define ACTUATOR_GROUP_WORDS(n) (((n) + 63) / 64)
+
+typedef struct {
+    void *params;               /* Datos específicos del tipo */
+    const char *name;
+    size_t count;               /* Salidas */
+    size_t words;
+    uint64_t *state;            /* Estado actual */
+    uint64_t *changed;          /* Diff de la última aplicación */
+    /* Aplica a las salidas con bit en changed el valor de desired */
+    void (*apply_many)(void *params, const uint64_t *changed, const uint64_t *desired, size_t words);
+} ActuatorGroup;
+
+/* Inicializa un grupo de count salidas apagadas con el apply_many del tipo.
+ * state y changed salen de la arena; con arena NULL de un solo malloc que
+ * el llamador libera con free(g->state). Retorna false si falta memoria. */
+extern bool actuator_group_init(ActuatorGroup *g, arena_t *arena, size_t count, const char *name,
+                                void (*apply_many)(void *, const uint64_t *, const uint64_t *, size_t));
+
+/* Lleva el grupo al estado desired (ACTUATOR_GROUP_WORDS(count) palabras;
+ * se ignoran los bits más allá de count). Retorna cuántas salidas cambiaron. */
+extern size_t actuator_group_apply(ActuatorGroup *g, const uint64_t *desired);
+
+static inline bool actuator_group_status(const ActuatorGroup *g, size_t i) {
+    return (g->state[i / 64] >> (i % 64)) & 1u;
+}
+
+/* Marca la salida i en un bitset de estado deseado */
+static inline void actuator_group_set(uint64_t *bits, size_t i, bool on) {
+    uint64_t bit = (uint64_t)1 << (i % 64);
+    if (on) bits[i / 64] |= bit;
+    else bits[i / 64] &= ~bit;
+}
+
+/* Grupos por tipo: el mismo mensaje que el actuador individual por salida
+ * que cambia (nada en modo silencioso) */
+extern ActuatorGroup create_led_group(arena_t *arena, size_t count);
+extern ActuatorGroup create_buzzer_group(arena_t *arena, size_t count);
+extern ActuatorGroup create_none_group(arena_t *arena, size_t count);
+
+/* Grupo sobre actuadores individuales (de tipos mezclados, como los de las
+ * reglas): el diff es por lote, pero cada cambio llama a activate/deactivate.
+ * acts debe seguir vivo mientras se use el grupo. */
+extern ActuatorGroup actuator_group_wrap(arena_t *arena, Actuator *acts, size_t count);
+
+#endif /* ACTUATOR_GROUP_H */
@@ -0,0 +1,72 @@
+#include <string.h>
+#include "actuator_sched.h"
+
+static void prepare(timer_wheel_t *w, ActuatorAction *a, Actuator *act, tw_callback fn) {
+    if (a->wheel && tw_pending(&a->timer)) tw_cancel(a->wheel, &a->timer);
+    memset(a, 0, sizeof(*a));
+    tw_timer_init(&a->timer, fn, a);
+    a->wheel = w;
+    a->actuator = act;
+}
+
+static void off_fired(tw_timer_t *t, void *arg) {
+    ActuatorAction *a = arg;
+    (void)t;
+    a->actuator->deactivate(a->actuator->params);
+}
+
+void actuator_off_after(timer_wheel_t *w, ActuatorAction *a, Actuator *act, uint64_t delay) {
+    prepare(w, a, act, off_fired);
+    tw_schedule(w, &a->timer, delay, 0);
+}
+
+static void on_fired(tw_timer_t *t, void *arg) {
+    ActuatorAction *a = arg;
+    (void)t;
+    a->actuator->activate(a->actuator->params);
+}
+
+void actuator_on_after(timer_wheel_t *w, ActuatorAction *a, Actuator *act, uint64_t delay) {
+    prepare(w, a, act, on_fired);
+    tw_schedule(w, &a->timer, delay, 0);
+}
+
+static void blink_fired(tw_timer_t *t, void *arg) {
+    ActuatorAction *a = arg;
+    Actuator *act = a->actuator;
+
+    if (act->status(act->params)) act->deactivate(act->params);
+    else act->activate(act->params);
+
+    /* Periódico: ya quedó reprogramado, se cancela al llegar al último cambio */
+    if (a->remaining && --a->remaining == 0) tw_cancel(a->wheel, t);
+}
+
+void actuator_blink(timer_wheel_t *w, ActuatorAction *a, Actuator *act,
+                    uint64_t half_period, unsigned toggles) {
+    prepare(w, a, act, blink_fired);
+    a->remaining = toggles;
+    tw_schedule(w, &a->timer, half_period, half_period);
+}
+
+static void retry_fired(tw_timer_t *t, void *arg) {
+    ActuatorAction *a = arg;
+    if (a->attempt(a->actuator)) return;
+    if (a->remaining && --a->remaining == 0) return;     /* Sin intentos restantes */
+    tw_schedule(a->wheel, t, a->interval, 0);
+}
+
+void actuator_retry(timer_wheel_t *w, ActuatorAction *a, Actuator *act,
+                    bool (*attempt)(Actuator *), uint64_t interval, unsigned max_tries) {
+    prepare(w, a, act, retry_fired);
+    a->attempt = attempt;
+    a->interval = interval;
+    a->remaining = max_tries;
+    if (attempt(act)) return;
+    if (a->remaining && --a->remaining == 0) return;
+    tw_schedule(w, &a->timer, interval, 0);
+}
+
+void actuator_action_cancel(ActuatorAction *a) {
+    if (a->wheel) tw_cancel(a->wheel, &a->timer);
+}
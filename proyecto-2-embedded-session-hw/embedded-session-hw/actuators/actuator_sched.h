@@ -0,0 +1,39 @@
+#ifndef ACTUATOR_SCHED_H
+#define ACTUATOR_SCHED_H
+
+#include <stdbool.h>
+#include "actuator.h"
+#include "../common/timer_wheel.h"
+
+/* Acción diferida o periódica sobre un actuador, programada en una rueda de
+ * timers. La reserva quien la usa, inicializada en cero ({0}); una acción
+ * activa a la vez por estructura. */
+typedef struct ActuatorAction {
+    tw_timer_t timer;
+    timer_wheel_t *wheel;
+    Actuator *actuator;
+    unsigned remaining;                     /* Cambios o reintentos restantes (0 = sin límite) */
+    uint64_t interval;                      /* Ticks entre reintentos */
+    bool (*attempt)(Actuator *actuator);    /* Intento de un reintento */
+} ActuatorAction;
+
+/* Apaga el actuador dentro de delay ticks */
+extern void actuator_off_after(timer_wheel_t *w, ActuatorAction *a, Actuator *act, uint64_t delay);
+
+/* Enciende el actuador dentro de delay ticks */
+extern void actuator_on_after(timer_wheel_t *w, ActuatorAction *a, Actuator *act, uint64_t delay);
+
+/* Parpadeo: alterna el estado cada half_period ticks, toggles veces
+ * (0 = hasta cancelar). Termina apagado si toggles es par. */
+extern void actuator_blink(timer_wheel_t *w, ActuatorAction *a, Actuator *act,
+                           uint64_t half_period, unsigned toggles);
+
+/* Reintenta attempt(act) cada interval ticks hasta que retorne true o se
+ * agoten max_tries intentos (el primero es inmediato) */
+extern void actuator_retry(timer_wheel_t *w, ActuatorAction *a, Actuator *act,
+                           bool (*attempt)(Actuator *), uint64_t interval, unsigned max_tries);
+
+/* Cancela la acción pendiente, si la hay */
+extern void actuator_action_cancel(ActuatorAction *a);
+
+#endif /* ACTUATOR_SCHED_H */
@@ -12,13 +12,13 @@ typedef struct {
 static void buzzer_activate(void *params) {
     BuzzerParams *bz = (BuzzerParams *) params;
     bz->is_on = true;
-    printf("[BUZZER] Activado\n");
+    if (!actuator_is_quiet()) printf("[BUZZER] Activado\n");
 }
 
 static void buzzer_deactivate(void *params) {
     BuzzerParams *bz = (BuzzerParams *) params;
     bz->is_on = false;
-    printf("[BUZZER] Desactivado\n");
+    if (!actuator_is_quiet()) printf("[BUZZER] Desactivado\n");
 }
 
 static bool buzzer_status(void *params) {
@@ -27,9 +27,9 @@ static bool buzzer_status(void *params) {
 }
 
 /* Función de fábrica: devuelve un Actuator configurado como buzzer */
-Actuator create_buzzer_actuator(void) {
-    BuzzerParams *params = (BuzzerParams *) malloc(sizeof(BuzzerParams));
-    params->is_on = false;
+Actuator create_buzzer_actuator(arena_t *arena) {
+    BuzzerParams *params = (BuzzerParams *) (arena ? arena_alloc(arena, sizeof(BuzzerParams)) : malloc(sizeof(BuzzerParams)));
+    if (params) params->is_on = false;
 
     Actuator buzzer = {
         .params = params,
@@ -12,13 +12,13 @@ typedef struct {
 static void led_activate(void *params) {
     LedParams *led = (LedParams *) params;
     led->is_on = true;
-    printf("[LED] Encendido\n");
+    if (!actuator_is_quiet()) printf("[LED] Encendido\n");
 }
 
 static void led_deactivate(void *params) {
     LedParams *led = (LedParams *) params;
     led->is_on = false;
-    printf("[LED] Apagado\n");
+    if (!actuator_is_quiet()) printf("[LED] Apagado\n");
 }
 
 static bool led_status(void *params) {
@@ -27,9 +27,9 @@ static bool led_status(void *params) {
 }
 
 /* Función de fábrica: devuelve un Actuator configurado como LED */
-Actuator create_led_actuator(void) {
-    LedParams *params = (LedParams *) malloc(sizeof(LedParams));
-    params->is_on = false;
+Actuator create_led_actuator(arena_t *arena) {
+    LedParams *params = (LedParams *) (arena ? arena_alloc(arena, sizeof(LedParams)) : malloc(sizeof(LedParams)));
+    if (params) params->is_on = false;
 
     Actuator led = {
         .params = params,
@@ -0,0 +1,150 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include "pwm.h"
+
+/* Flanco de apagado: los canales de mask bajan offset ns después del
+ * inicio del período */
+typedef struct {
+    uint64_t offset;
+    uint64_t mask[PWM_WORDS];
+} pwm_edge_t;
+
+struct pwm {
+    pwm_config_t cfg;
+    pthread_t thread;
+    atomic_bool stop;
+    _Atomic uint64_t on_ns[PWM_MAX_CHANNELS];  /* Tiempo encendido por período */
+    _Atomic unsigned generation;               /* Cambia con cada pwm_set_duty */
+
+    /* Solo del hilo de PWM */
+    unsigned seen;                  /* Generación de la lista actual */
+    uint64_t on_mask[PWM_WORDS];    /* Canales que se encienden al inicio */
+    pwm_edge_t edges[PWM_MAX_CHANNELS];
+    size_t nedges;
+    pwm_stats_t stats;
+};
+
+typedef struct {
+    uint64_t offset;
+    size_t channel;
+} pwm_off_t;
+
+static int by_offset(const void *a, const void *b) {
+    uint64_t x = ((const pwm_off_t *)a)->offset, y = ((const pwm_off_t *)b)->offset;
+    return x < y ? -1 : x > y;
+}
+
+/* Rearma on_mask y la lista de flancos con los ciclos útiles actuales */
+static void build_schedule(struct pwm *p) {
+    pwm_off_t off[PWM_MAX_CHANNELS];
+    size_t n = 0, count = p->cfg.out->count;
+
+    memset(p->on_mask, 0, sizeof(p->on_mask));
+    for (size_t ch = 0; ch < count; ch++) {
+        uint64_t on = atomic_load_explicit(&p->on_ns[ch], memory_order_relaxed);
+        if (on == 0) continue;
+        actuator_group_set(p->on_mask, ch, true);
+        if (on < p->cfg.period_ns) off[n++] = (pwm_off_t){on, ch};    /* 100 %: sin flanco de apagado */
+    }
+    qsort(off, n, sizeof(off[0]), by_offset);
+
+    p->nedges = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (p->nedges == 0 || p->edges[p->nedges - 1].offset != off[i].offset) {
+            pwm_edge_t *e = &p->edges[p->nedges++];
+            e->offset = off[i].offset;
+            memset(e->mask, 0, sizeof(e->mask));
+        }
+        actuator_group_set(p->edges[p->nedges - 1].mask, off[i].channel, true);
+    }
+    p->stats.recomputes++;
+}
+
+/* Espera hasta deadline y aplica desired; registra y retorna el atraso */
+static uint64_t edge_at(struct pwm *p, uint64_t deadline, const uint64_t *desired) {
+    uint64_t spin = p->cfg.spin_ns;
+    if (deadline > spin) rt_sleep_until_ns(deadline - spin);
+    uint64_t now;
+    while ((now = rt_now_ns()) < deadline) {
+    }
+    hist_record(&p->stats.error, now - deadline);
+    actuator_group_apply(p->cfg.out, desired);
+    p->stats.edges++;
+    return now - deadline;
+}
+
+static void *pwm_thread(void *arg) {
+    struct pwm *p = arg;
+    uint64_t desired[PWM_WORDS];
+    uint64_t period = p->cfg.period_ns;
+
+    /* rt_setup y el margen de los timers (50 µs por defecto fuera de
+     * SCHED_FIFO) se aplican solo a este hilo */
+    rt_setup(&p->cfg.rt);
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+    uint64_t start = rt_now_ns() + period;
+    while (!atomic_load_explicit(&p->stop, memory_order_relaxed)) {
+        unsigned gen = atomic_load_explicit(&p->generation, memory_order_acquire);
+        if (gen != p->seen) {
+            p->seen = gen;
+            build_schedule(p);
+        }
+
+        memcpy(desired, p->on_mask, sizeof(desired));
+        hist_record(&p->stats.period, edge_at(p, start, desired));
+        for (size_t i = 0; i < p->nedges; i++) {
+            const pwm_edge_t *e = &p->edges[i];
+            for (size_t w = 0; w < PWM_WORDS; w++) desired[w] &= ~e->mask[w];
+            edge_at(p, start + e->offset, desired);
+        }
+        p->stats.periods++;
+
+        /* Si el período siguiente ya pasó, se saltea en vez de acumular atraso */
+        start += period;
+        uint64_t now = rt_now_ns();
+        if (now >= start + period) {
+            uint64_t lost = (now - start) / period;
+            p->stats.overruns += lost;
+            start += lost * period;
+        }
+    }
+
+    memset(desired, 0, sizeof(desired));
+    actuator_group_apply(p->cfg.out, desired);
+    return NULL;
+}
+
+pwm_t *pwm_start(const pwm_config_t *cfg) {
+    if (!cfg->out || cfg->out->count > PWM_MAX_CHANNELS || cfg->period_ns == 0) return NULL;
+    struct pwm *p = calloc(1, sizeof(*p));
+    if (!p) return NULL;
+    p->cfg = *cfg;
+    p->seen = 1;                    /* Distinta de generation: la primera vuelta arma la lista */
+    hist_init(&p->stats.error, "flancos PWM");
+    hist_init(&p->stats.period, "inicio de período PWM");
+    if (pthread_create(&p->thread, NULL, pwm_thread, p) != 0) {
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+void pwm_set_duty(pwm_t *p, size_t channel, double duty) {
+    if (channel >= p->cfg.out->count) return;
+    if (duty < 0.0) duty = 0.0;
+    if (duty > 1.0) duty = 1.0;
+    atomic_store_explicit(&p->on_ns[channel], (uint64_t)(duty * (double)p->cfg.period_ns + 0.5),
+                          memory_order_relaxed);
+    atomic_fetch_add_explicit(&p->generation, 1, memory_order_release);
+}
+
+void pwm_stop(pwm_t *p, pwm_stats_t *stats) {
+    atomic_store(&p->stop, true);
+    pthread_join(p->thread, NULL);
+    if (stats) *stats = p->stats;
+    free(p);
+}
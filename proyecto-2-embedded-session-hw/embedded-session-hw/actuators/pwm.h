@@ -0,0 +1,50 @@
+#ifndef PWM_H
+#define PWM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "actuator_group.h"
+#include "../common/hist.h"
+#include "../controller/rt.h"
+
+/* PWM por software: un hilo de tiempo real maneja todos los canales de un
+ * ActuatorGroup (canal i = salida i). Cada período empieza encendiendo los
+ * canales con ciclo útil > 0 y sigue con una lista de flancos de apagado
+ * ordenada por instante; los canales que se apagan juntos comparten flanco
+ * y salen en un solo actuator_group_apply. La lista se recalcula solo
+ * cuando cambia algún ciclo útil. */
+
+#define PWM_MAX_CHANNELS 256
+#define PWM_WORDS ACTUATOR_GROUP_WORDS(PWM_MAX_CHANNELS)
+
+typedef struct {
+    ActuatorGroup *out;         /* Salidas; solo el hilo de PWM las toca */
+    uint64_t period_ns;         /* 1000000 = 1 kHz */
+    uint64_t spin_ns;           /* Dormir hasta spin_ns antes de cada flanco y esperar activamente el resto */
+    rt_config_t rt;             /* Prioridad, CPU y mlockall del hilo (period_ns no se usa) */
+} pwm_config_t;
+
+typedef struct {
+    unsigned long periods;
+    unsigned long edges;        /* Flancos aplicados (incluido el encendido de cada período) */
+    unsigned long recomputes;   /* Veces que se rearmó la lista de flancos */
+    unsigned long overruns;     /* Períodos enteros perdidos por atraso */
+    hist_t error;               /* ns de atraso de cada flanco respecto a su instante */
+    hist_t period;              /* ns de atraso del encendido de cada período (jitter del período) */
+} pwm_stats_t;
+
+typedef struct pwm pwm_t;
+
+/* Arranca el hilo con todos los canales en 0; NULL si no se pudo */
+extern pwm_t *pwm_start(const pwm_config_t *cfg);
+
+/* Ciclo útil del canal (0 a 1), desde cualquier hilo; rige desde el
+ * próximo período */
+extern void pwm_set_duty(pwm_t *p, size_t channel, double duty);
+
+/* Detiene el hilo, deja las salidas apagadas, copia las estadísticas (si
+ * stats no es NULL) y libera p */
+extern void pwm_stop(pwm_t *p, pwm_stats_t *stats);
+
+#endif /* PWM_H */
@@ -0,0 +1,41 @@
+#include "bench.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Benchmarks disponibles: bench64 <nombre> [args...] */
+static const struct {
+    const char *name;
+    int (*run)(int argc, char *argv[]);
+    const char *usage;
+} benches[] = {
+    {"csv", bench_csv, "[archivo.csv | MB]  cargador original vs mmap vs streaming"},
+    {"frames", bench_frames, "[M canal-muestras]  umbral multicanal SoA de 1 a 256 canales"},
+    {"timers", bench_timers, "rueda de timers: programar, cancelar y vencer"},
+    {"rules", bench_rules, "[ticks]  motor de reglas: reglas/s de 16 a 2048 reglas"},
+    {"filters", bench_filters, "[muestras]  filtros: double vs punto fijo Q15"},
+    {"arena", bench_arena, "[instancias]  actuadores: malloc por instancia vs arena"},
+    {"actuators", bench_actuators, "[salidas]  estado de N actuadores: vtable por actuador vs grupo"},
+    {"pwm", bench_pwm, "[canales] [s] [prio]  PWM por software a 1 kHz: atraso de los flancos"},
+    {"bus", bench_bus, "[eventos] [µs]  bus de estado: ciclo sin cambios y difusión a 1-64 suscriptores"},
+    {"matrix", bench_matrix, "<carga>  carga fija para bench/matrix.sh: csv, lotes, filtros, actuadores"},
+    {"synth", bench_synth, "[muestras]  generador sintético: rand() vs xoshiro vs bloques"},
+    {"pipeline", bench_pipeline, "[muestras/s] [µs] [s]  latencia muestra->actuación: serie vs tubería"},
+};
+
+int main(int argc, char *argv[]) {
+    size_t n = sizeof(benches) / sizeof(benches[0]);
+
+    if (argc > 1) {
+        for (size_t i = 0; i < n; i++) {
+            if (strcmp(argv[1], benches[i].name) == 0) {
+                return benches[i].run(argc - 2, argv + 2);
+            }
+        }
+    }
+
+    printf("Uso: %s <benchmark> [args]\n", argv[0]);
+    for (size_t i = 0; i < n; i++) {
+        printf("  %-8s %s\n", benches[i].name, benches[i].usage);
+    }
+    return 1;
+}
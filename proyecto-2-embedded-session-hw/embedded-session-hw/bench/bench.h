@@ -0,0 +1,32 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+/* Debe ser el primer include de cada bench_*.c */
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+
+/* Tiempo monotónico (segundos con decimales) */
+static inline double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* CSV sintético y determinista de aproximadamente mb megabytes en path */
+extern int bench_csv_generate(const char *path, long mb);
+
+/* Cada benchmark recibe los argumentos que siguen a su nombre */
+extern int bench_csv(int argc, char *argv[]);
+extern int bench_frames(int argc, char *argv[]);
+extern int bench_timers(int argc, char *argv[]);
+extern int bench_rules(int argc, char *argv[]);
+extern int bench_pipeline(int argc, char *argv[]);
+extern int bench_filters(int argc, char *argv[]);
+extern int bench_arena(int argc, char *argv[]);
+extern int bench_synth(int argc, char *argv[]);
+extern int bench_actuators(int argc, char *argv[]);
+extern int bench_pwm(int argc, char *argv[]);
+extern int bench_bus(int argc, char *argv[]);
+extern int bench_matrix(int argc, char *argv[]);
+
+#endif /* BENCH_H */
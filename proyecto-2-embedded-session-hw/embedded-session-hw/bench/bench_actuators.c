@@ -0,0 +1,132 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../actuators/actuator.h"
+#include "../actuators/actuator_group.h"
+#include "../common/arena.h"
+#include "../common/rng.h"
+
+#define GROUP_PATTERNS 16           /* Estados deseados que se recorren en ciclo */
+#define GROUP_TOTAL    (1u << 24)   /* Salidas actualizadas por medición */
+
+/* Secuencia de estados deseados: cada uno cambia cerca de una fracción
+ * frac de las salidas respecto al anterior */
+static uint64_t *make_patterns(size_t n, double frac, uint64_t seed) {
+    size_t words = ACTUATOR_GROUP_WORDS(n);
+    uint64_t *p = calloc(GROUP_PATTERNS * words, sizeof(uint64_t));
+    if (!p) return NULL;
+    rng_t r;
+    rng_seed(&r, seed);
+    for (size_t k = 0; k < GROUP_PATTERNS; k++) {
+        uint64_t *cur = p + k * words;
+        if (k > 0) {
+            for (size_t w = 0; w < words; w++) cur[w] = cur[w - words];
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (rng_uniform(&r) < frac) cur[i / 64] ^= (uint64_t)1 << (i % 64);
+        }
+    }
+    return p;
+}
+
+static size_t rounds_for(size_t n) {
+    size_t rounds = GROUP_TOTAL / n;
+    return rounds ? rounds : 1;
+}
+
+/* Camino actual: status() y activate/deactivate por actuador */
+static double per_actuator(Actuator *acts, size_t n, const uint64_t *patterns, bool diff) {
+    size_t words = ACTUATOR_GROUP_WORDS(n), rounds = rounds_for(n);
+    double t0 = bench_now();
+    for (size_t r = 0; r < rounds; r++) {
+        const uint64_t *want = patterns + (r % GROUP_PATTERNS) * words;
+        for (size_t i = 0; i < n; i++) {
+            bool on = (want[i / 64] >> (i % 64)) & 1u;
+            if (diff && on == acts[i].status(acts[i].params)) continue;
+            if (on) acts[i].activate(acts[i].params);
+            else acts[i].deactivate(acts[i].params);
+        }
+    }
+    return (bench_now() - t0) / ((double)rounds * n) * 1e9;
+}
+
+/* Grupo: un actuator_group_apply por ronda */
+static double grouped(ActuatorGroup *g, const uint64_t *patterns, size_t *changes) {
+    size_t rounds = rounds_for(g->count), total = 0;
+    double t0 = bench_now();
+    for (size_t r = 0; r < rounds; r++) total += actuator_group_apply(g, patterns + (r % GROUP_PATTERNS) * g->words);
+    double dt = bench_now() - t0;
+    *changes = total / rounds;
+    return dt / ((double)rounds * g->count) * 1e9;
+}
+
+static size_t count_on(const Actuator *acts, size_t n) {
+    size_t on = 0;
+    for (size_t i = 0; i < n; i++) on += acts[i].status(acts[i].params);
+    return on;
+}
+
+static size_t group_on(const ActuatorGroup *g) {
+    size_t on = 0;
+    for (size_t i = 0; i < g->count; i++) on += actuator_group_status(g, i);
+    return on;
+}
+
+int bench_actuators(int argc, char *argv[]) {
+    static const size_t sizes[] = {64, 1024, 16384, 262144};
+    static const double fracs[] = {0.001, 0.01, 0.1, 0.5};
+    size_t max = argc > 0 ? (size_t)atol(argv[0]) : 0;
+    int rc = 0;
+
+    actuator_set_quiet(true);
+    printf("[BENCH] Estado deseado de N actuadores por ronda: vtable por actuador vs grupo por lotes (ns por salida)\n");
+    printf("%8s %8s %9s %10s %10s %10s %10s %10s\n", "salidas", "cambian", "cambios", "vtable",
+           "vt + diff", "grupo adap", "grupo LED", "grupo none");
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        size_t n = sizes[k];
+        if (max && n > max) break;
+        for (size_t f = 0; f < sizeof(fracs) / sizeof(fracs[0]); f++) {
+            uint64_t *patterns = make_patterns(n, fracs[f], n + f);
+            arena_t arena;
+            arena_init(&arena, 0);
+            Actuator *a = arena_alloc(&arena, n * sizeof(Actuator));
+            Actuator *b = arena_alloc(&arena, n * sizeof(Actuator));
+            if (!patterns || !a || !b) {
+                printf("[BENCH] Sin memoria para %zu salidas\n", n);
+                return 1;
+            }
+            for (size_t i = 0; i < n; i++) {
+                a[i] = create_led_actuator(&arena);
+                b[i] = create_led_actuator(&arena);
+            }
+            ActuatorGroup wrap = actuator_group_wrap(&arena, b, n);
+            ActuatorGroup led = create_led_group(&arena, n);
+            ActuatorGroup none = create_none_group(&arena, n);
+            if (!wrap.state || !led.state || !none.state) {
+                printf("[BENCH] Sin memoria para %zu salidas\n", n);
+                return 1;
+            }
+
+            double t_plain = per_actuator(a, n, patterns, false);
+            double t_diff = per_actuator(a, n, patterns, true);
+            size_t changes;
+            double t_wrap = grouped(&wrap, patterns, &changes);
+            double t_led = grouped(&led, patterns, &changes);
+            double t_none = grouped(&none, patterns, &changes);
+
+            printf("%8zu %7.1f%% %9zu %7.2f ns %7.2f ns %7.2f ns %7.2f ns %7.2f ns\n", n, 100.0 * fracs[f],
+                   changes, t_plain, t_diff, t_wrap, t_led, t_none);
+
+            /* Todos los caminos terminan en el mismo estado */
+            size_t on = count_on(a, n);
+            if (count_on(b, n) != on || group_on(&led) != on || group_on(&none) != on) {
+                printf("[BENCH] ADVERTENCIA: los estados finales no coinciden\n");
+                rc = 1;
+            }
+            arena_free(&arena);
+            free(patterns);
+        }
+    }
+    return rc;
+}
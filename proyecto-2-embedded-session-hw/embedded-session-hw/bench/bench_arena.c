@@ -0,0 +1,102 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../actuators/actuator.h"
+#include "../common/arena.h"
+
+/* Instancias creadas por medición (repartidas en rondas del tamaño pedido) */
+#define ARENA_TOTAL 2000000
+
+/* Crear n actuadores y destruirlos: malloc/free uno por uno contra la arena
+ * con un solo reset por ronda. Devuelve ns por instancia. */
+static double churn(Actuator *acts, size_t n, arena_t *arena) {
+    size_t rounds = ARENA_TOTAL / n;
+    if (rounds == 0) rounds = 1;
+
+    double t0 = bench_now();
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < n; i++) acts[i] = create_led_actuator(arena);
+        if (arena) {
+            arena_reset(arena);
+        } else {
+            for (size_t i = 0; i < n; i++) free(acts[i].params);
+        }
+    }
+    return (bench_now() - t0) / ((double)rounds * n) * 1e9;
+}
+
+/* Recorrer status() de todas las instancias; ns por instancia */
+static double iterate(const Actuator *acts, size_t n, size_t *on) {
+    size_t passes = ARENA_TOTAL / n;
+    if (passes == 0) passes = 1;
+    size_t count = 0;
+
+    double t0 = bench_now();
+    for (size_t p = 0; p < passes; p++) {
+        for (size_t i = 0; i < n; i++) count += acts[i].status(acts[i].params);
+    }
+    double dt = bench_now() - t0;
+    *on = count / passes;
+    return dt / ((double)passes * n) * 1e9;
+}
+
+int bench_arena(int argc, char *argv[]) {
+    static const size_t sizes[] = {1000, 10000, 100000, 1000000};
+    size_t max = argc > 0 ? (size_t)atol(argv[0]) : 0;
+    arena_t arena;
+
+    printf("[BENCH] Instancias de actuadores: malloc por instancia vs arena\n");
+    printf("%10s %12s %12s %14s %14s %12s\n", "instancias", "crear malloc", "crear arena",
+           "recorrer mall.", "recorrer arena", "encendidos");
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        size_t n = sizes[k];
+        if (max && n > max) break;
+        Actuator *heap = malloc(n * sizeof(Actuator));
+        Actuator *packed = malloc(n * sizeof(Actuator));
+        void **junk = malloc(n * sizeof(void *));
+        if (!heap || !packed || !junk) {
+            printf("[BENCH] Sin memoria para %zu instancias\n", n);
+            return 1;
+        }
+
+        arena_init(&arena, 0);
+        double c_heap = churn(heap, n, NULL);
+        double c_arena = churn(packed, n, &arena);
+
+        /* Montículo realista: cada instancia queda entre asignaciones ajenas
+         * de tamaño variable, como en un proceso que ya lleva rato corriendo */
+        unsigned x = 88172645u;
+        for (size_t i = 0; i < n; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            heap[i] = create_led_actuator(NULL);
+            junk[i] = malloc(16 + x % 240);
+            packed[i] = create_led_actuator(&arena);
+            if (x % 3 == 0) {                               /* Sin imprimir: se marca directo */
+                *(bool *)heap[i].params = true;
+                *(bool *)packed[i].params = true;
+            }
+        }
+        size_t on_heap, on_arena;
+        double i_heap = iterate(heap, n, &on_heap);
+        double i_arena = iterate(packed, n, &on_arena);
+
+        printf("%10zu %10.1f ns %10.1f ns %11.2f ns %11.2f ns %12zu\n", n, c_heap, c_arena,
+               i_heap, i_arena, on_arena);
+        if (on_heap != on_arena) {
+            printf("[BENCH] ADVERTENCIA: los recorridos no coinciden (%zu / %zu)\n", on_heap, on_arena);
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            free(heap[i].params);
+            free(junk[i]);
+        }
+        arena_free(&arena);         /* Todas las instancias de la arena de una vez */
+        free(heap);
+        free(packed);
+        free(junk);
+    }
+    return 0;
+}
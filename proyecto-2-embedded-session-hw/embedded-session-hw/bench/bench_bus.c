@@ -0,0 +1,155 @@
+#include "bench.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../common/hist.h"
+#include "../common/state_bus.h"
+#include "../controller/rt.h"
+
+#define BUS_BENCH_QUEUE 4096
+#define BUS_IDLE_TICKS  2000000
+
+/* Suscriptor: espera con su eventfd y mide publicación -> lectura (el
+ * publicador pone su reloj en value) */
+typedef struct {
+    bus_sub_t sub;
+    atomic_bool *stop;
+    unsigned long events;
+    hist_t latency;
+    pthread_t thread;
+} bench_sub_t;
+
+static void *subscriber(void *arg) {
+    bench_sub_t *s = arg;
+    bus_event_t ev[64];
+    for (;;) {
+        bool stopping = atomic_load(s->stop);
+        size_t n = state_bus_read(&s->sub, ev, sizeof(ev) / sizeof(ev[0]));
+        uint64_t now = rt_now_ns();
+        for (size_t i = 0; i < n; i++) hist_record(&s->latency, now - (uint64_t)ev[i].value);
+        s->events += n;
+        if (n == 0) {
+            if (stopping) break;
+            state_bus_wait(&s->sub, 10);
+        }
+    }
+    return NULL;
+}
+
+static void hist_merge(hist_t *into, const hist_t *h) {
+    if (h->count == 0) return;
+    if (into->count == 0 || h->min < into->min) into->min = h->min;
+    if (h->max > into->max) into->max = h->max;
+    into->count += h->count;
+    into->sum += h->sum;
+    for (size_t i = 0; i < HIST_BUCKETS; i++) into->buckets[i] += h->buckets[i];
+}
+
+/* Lo que cuesta un ciclo sin cambios: la línea por muestra de antes contra
+ * las dos comparaciones de publish_changes */
+static void idle_tick(void) {
+    FILE *null = fopen("/dev/null", "w");
+    if (!null) return;
+    volatile uint16_t states = 3;
+    volatile bool above = true;
+    uint16_t published = 3;
+    bool was_above = true;
+    unsigned long events = 0;
+
+    double t0 = bench_now();
+    for (unsigned long i = 0; i < BUS_IDLE_TICKS; i++) {
+        fprintf(null, "[t=%.2f] Sensor=%.2f | LED=%s | BUZZER=%s\n", i * 0.1, 75.0,
+                states & 1u ? "ON" : "OFF", states & 2u ? "ON" : "OFF");
+    }
+    double t_print = (bench_now() - t0) / BUS_IDLE_TICKS * 1e9;
+
+    t0 = bench_now();
+    for (unsigned long i = 0; i < BUS_IDLE_TICKS; i++) {
+        if (above != was_above || states != published) events++;
+    }
+    double t_bus = (bench_now() - t0) / BUS_IDLE_TICKS * 1e9;
+    fclose(null);
+    printf("Ciclo sin cambios: línea por muestra %.1f ns, solo cambios %.2f ns (%lu eventos)\n",
+           t_print, t_bus, events);
+}
+
+int bench_bus(int argc, char *argv[]) {
+    static const size_t counts[] = {1, 4, 16, 64};
+    unsigned long events = argc > 0 ? strtoul(argv[0], NULL, 10) : 20000;
+    uint64_t gap_ns = argc > 1 ? strtoull(argv[1], NULL, 10) * 1000ull : 50000;
+    int rc = 0;
+
+    if (events == 0) {
+        printf("[BENCH] Uso: bus [eventos] [µs entre eventos]\n");
+        return 1;
+    }
+    printf("[BENCH] Bus de estado: %lu eventos cada %.0f µs a N suscriptores que esperan en su eventfd\n",
+           events, gap_ns / 1000.0);
+    idle_tick();
+    printf("%6s %14s %12s %12s %10s %10s %10s %10s\n", "subs", "publicar ns", "avisos/ev", "entregados",
+           "perdidos", "p50 µs", "p99 µs", "max µs");
+
+    for (size_t k = 0; k < sizeof(counts) / sizeof(counts[0]); k++) {
+        size_t nsubs = counts[k];
+        state_bus_t bus;
+        atomic_bool stop = false;
+        bench_sub_t *subs = calloc(nsubs, sizeof(bench_sub_t));
+        if (!subs || !state_bus_init(&bus, BUS_BENCH_QUEUE)) {
+            printf("[BENCH] Sin memoria\n");
+            free(subs);
+            return 1;
+        }
+        size_t started = 0;
+        for (; started < nsubs; started++) {
+            bench_sub_t *s = &subs[started];
+            if (!state_bus_subscribe(&bus, &s->sub)) break;
+            s->stop = &stop;
+            hist_init(&s->latency, "bus");
+            if (pthread_create(&s->thread, NULL, subscriber, s) != 0) {
+                state_bus_unsubscribe(&bus, &s->sub);
+                break;
+            }
+        }
+        if (started < nsubs) {
+            printf("[BENCH] Solo se pudieron crear %zu de %zu suscriptores\n", started, nsubs);
+            rc = 1;
+        }
+
+        /* Publicar a ritmo fijo; se mide solo state_bus_publish */
+        double spent = 0.0;
+        uint64_t next = rt_now_ns() + gap_ns;
+        for (unsigned long i = 0; i < events; i++) {
+            rt_sleep_until_ns(next);
+            next += gap_ns;
+            bus_event_t ev = {.kind = BUS_ACTUATORS, .seq = (uint32_t)i, .states = (uint16_t)(i & 1u), .changed = 1};
+            double t0 = bench_now();
+            ev.value = (double)rt_now_ns();
+            state_bus_publish(&bus, &ev);
+            spent += bench_now() - t0;
+        }
+        atomic_store(&stop, true);
+
+        hist_t all;
+        hist_init(&all, "bus");
+        unsigned long delivered = 0, lost = 0;
+        for (size_t i = 0; i < started; i++) {
+            pthread_join(subs[i].thread, NULL);
+            delivered += subs[i].events;
+            lost += subs[i].sub.lost;
+            hist_merge(&all, &subs[i].latency);
+            state_bus_unsubscribe(&bus, &subs[i].sub);
+        }
+        printf("%6zu %14.0f %12.2f %12lu %10lu %10.1f %10.1f %10.1f\n", started, spent / events * 1e9,
+               (double)bus.wakeups / events, delivered, lost, hist_percentile(&all, 50.0) / 1000.0,
+               hist_percentile(&all, 99.0) / 1000.0, all.max / 1000.0);
+        if (delivered + lost != (unsigned long)started * events) {
+            printf("[BENCH] ADVERTENCIA: faltan eventos (%lu de %lu)\n", delivered + lost,
+                   (unsigned long)started * events);
+            rc = 1;
+        }
+        state_bus_free(&bus);
+        free(subs);
+    }
+    return rc;
+}
@@ -0,0 +1,141 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "../sensor/csv.h"
+
+/* Cargador original de sensor.c (dos lecturas del archivo, fgets + atof),
+ * conservado aquí como referencia para comparar */
+static int legacy_count_lines(const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) return 0;
+    int count = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), file)) count++;
+    fclose(file);
+    return (count > 0) ? count - 1 : 0;
+}
+
+static size_t legacy_load(const char *filename, double **out) {
+    FILE *file = fopen(filename, "r");
+    if (!file) return 0;
+    int n = legacy_count_lines(filename);
+    double *values = malloc((size_t)(n > 0 ? n : 1) * sizeof(double));
+    char line[256];
+    int index = 0;
+    if (!fgets(line, sizeof(line), file)) n = 0;
+    while (fgets(line, sizeof(line), file) && index < n) {
+        char *comma = strchr(line, ',');
+        if (comma) values[index++] = atof(comma + 1);
+    }
+    fclose(file);
+    *out = values;
+    return (size_t)index;
+}
+
+static size_t mmap_load(const char *filename, double **out) {
+    size_t n = 0;
+    csv_load_values(filename, out, NULL, &n);
+    return n;
+}
+
+/* Streaming: nunca materializa el archivo, solo acumula */
+static size_t stream_sum(const char *filename, double *sum) {
+    csv_reader_t r;
+    double ts, v;
+    size_t n = 0;
+    *sum = 0.0;
+    if (!csv_open(&r, filename)) return 0;
+    while (csv_next_row(&r, &ts, &v)) {
+        *sum += v;
+        n++;
+    }
+    csv_close(&r);
+    return n;
+}
+
+/* Genera un CSV sintético de aproximadamente mb megabytes */
+int bench_csv_generate(const char *path, long mb) {
+    FILE *f = fopen(path, "w");
+    if (!f) return -1;
+    long target = mb << 20;
+    long written = fprintf(f, "timestamp,value\n");
+    unsigned x = 12345;
+    for (long i = 0; written < target; i++) {
+        x = x * 1103515245u + 12345u;
+        written += fprintf(f, "%.1f,%.2f\n", i * 0.1, (x >> 8) % 10001 / 100.0);
+    }
+    fclose(f);
+    return 0;
+}
+
+static double sum_of(const double *v, size_t n) {
+    double s = 0.0;
+    for (size_t i = 0; i < n; i++) s += v[i];
+    return s;
+}
+
+int bench_csv(int argc, char *argv[]) {
+    char tmp[] = "/tmp/bench_csv_XXXXXX";
+    const char *path = tmp;
+    long mb = 64;
+    struct stat st;
+
+    if (argc > 0 && stat(argv[0], &st) == 0) {
+        path = argv[0];                         /* Archivo existente */
+    } else {
+        if (argc > 0) mb = atol(argv[0]);
+        int fd = mkstemp(tmp);
+        if (fd < 0 || bench_csv_generate(tmp, mb) != 0) {
+            perror("[BENCH] No se pudo generar el CSV");
+            return 1;
+        }
+        close(fd);
+    }
+    stat(path, &st);
+    double size_mb = st.st_size / 1048576.0;
+    printf("[BENCH] CSV %s (%.1f MB)\n", path, size_mb);
+    printf("%-22s %12s %10s %10s\n", "cargador", "valores", "seg", "MB/s");
+
+    double best[3] = {1e9, 1e9, 1e9};
+    size_t counts[3] = {0};
+    double sums[3] = {0};
+    for (int rep = 0; rep < 3; rep++) {
+        double *v;
+        double t0 = bench_now();
+        counts[0] = legacy_load(path, &v);
+        double t1 = bench_now();
+        sums[0] = sum_of(v, counts[0]);
+        free(v);
+
+        v = NULL;
+        double t2 = bench_now();
+        counts[1] = mmap_load(path, &v);
+        double t3 = bench_now();
+        sums[1] = sum_of(v, counts[1]);
+        free(v);
+
+        double t4 = bench_now();
+        counts[2] = stream_sum(path, &sums[2]);
+        double t5 = bench_now();
+
+        if (t1 - t0 < best[0]) best[0] = t1 - t0;
+        if (t3 - t2 < best[1]) best[1] = t3 - t2;
+        if (t5 - t4 < best[2]) best[2] = t5 - t4;
+    }
+
+    const char *names[3] = {"original (fgets+atof)", "mmap una pasada", "mmap streaming"};
+    for (int i = 0; i < 3; i++) {
+        printf("%-22s %12zu %10.3f %10.1f\n", names[i], counts[i], best[i], size_mb / best[i]);
+    }
+    printf("Aceleración mmap vs original: x%.1f\n", best[0] / best[1]);
+    if (counts[0] != counts[1] || counts[1] != counts[2] || sums[0] != sums[1] || sums[1] != sums[2]) {
+        printf("[BENCH] ADVERTENCIA: los cargadores no coinciden (suma %.6f / %.6f / %.6f)\n",
+               sums[0], sums[1], sums[2]);
+    }
+
+    if (path == tmp) unlink(tmp);
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../sensor/filter.h"
+
+/* Muestras por pasada si no se indica otra cosa */
+#define FILTER_SAMPLES 2000000
+
+/* Señal de prueba: escalones entre 20 y 80 con ruido uniforme de ±5 y
+ * picos aislados de +50 (los que la mediana debería eliminar) */
+static void make_signal(double *x, size_t n) {
+    unsigned s = 2463534242u;
+    for (size_t i = 0; i < n; i++) {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        double base = (i / 5000) % 2 ? 80.0 : 20.0;
+        double noise = (s % 10001) / 1000.0 - 5.0;
+        x[i] = base + noise + (s % 997 == 0 ? 50.0 : 0.0);
+    }
+}
+
+typedef struct {
+    const char *name;
+    const char *spec;
+} filter_case_t;
+
+int bench_filters(int argc, char *argv[]) {
+    static const filter_case_t cases[] = {
+        {"avg:16", "avg:16"},
+        {"avg:256", "avg:256"},
+        {"median:5", "median:5"},
+        {"median:63", "median:63"},
+        {"ewma:0.1", "ewma:0.1"},
+        {"kalman:0.01:4", "kalman:0.01:4"},
+        {"median:5,ewma:0.2", "median:5,ewma:0.2"},
+    };
+    static filter_chain_t fc, qc;
+    size_t n = argc > 0 ? (size_t)atol(argv[0]) : FILTER_SAMPLES;
+    if (n == 0) n = FILTER_SAMPLES;
+
+    double *x = malloc(n * sizeof(double));
+    double *yf = malloc(n * sizeof(double));
+    int32_t *xq = malloc(n * sizeof(int32_t));
+    int32_t *yq = malloc(n * sizeof(int32_t));
+    if (!x || !yf || !xq || !yq) {
+        printf("[BENCH] Sin memoria para %zu muestras\n", n);
+        return 1;
+    }
+    make_signal(x, n);
+    for (size_t i = 0; i < n; i++) xq[i] = filter_to_q(x[i]);
+
+    printf("[BENCH] %zu muestras, %zu bits; Q15 = punto fijo con %d bits fraccionarios\n",
+           n, sizeof(void *) * 8, FILTER_Q);
+    printf("%-20s %14s %14s %10s %12s\n", "filtro", "double M/s", "Q15 M/s", "Q15/double", "error max");
+
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        char err[128];
+        double best_f = 1e9, best_q = 1e9;
+        for (int rep = 0; rep < 3; rep++) {
+            filter_chain_parse(&fc, cases[k].spec, false, err, sizeof(err));
+            filter_chain_parse(&qc, cases[k].spec, true, err, sizeof(err));
+
+            /* Una sola etapa: se llama al step directo, sin el despacho de la cadena */
+            double t0 = bench_now();
+            if (fc.n == 1) {
+                filter_t *f = &fc.stage[0];
+                switch (f->kind) {
+                case FILTER_AVG: for (size_t i = 0; i < n; i++) yf[i] = filter_avg_step(&f->u.avg, x[i]); break;
+                case FILTER_MEDIAN: for (size_t i = 0; i < n; i++) yf[i] = filter_median_step(&f->u.median, x[i]); break;
+                case FILTER_EWMA: for (size_t i = 0; i < n; i++) yf[i] = filter_ewma_step(&f->u.ewma, x[i]); break;
+                case FILTER_KALMAN: for (size_t i = 0; i < n; i++) yf[i] = filter_kalman_step(&f->u.kalman, x[i]); break;
+                }
+            } else {
+                for (size_t i = 0; i < n; i++) yf[i] = filter_chain_apply(&fc, x[i]);
+            }
+            double t1 = bench_now();
+            if (qc.n == 1) {
+                filter_t *f = &qc.stage[0];
+                switch (f->kind) {
+                case FILTER_AVG: for (size_t i = 0; i < n; i++) yq[i] = filter_avg_q_step(&f->u.avg_q, xq[i]); break;
+                case FILTER_MEDIAN: for (size_t i = 0; i < n; i++) yq[i] = filter_median_q_step(&f->u.median, xq[i]); break;
+                case FILTER_EWMA: for (size_t i = 0; i < n; i++) yq[i] = filter_ewma_q_step(&f->u.ewma_q, xq[i]); break;
+                case FILTER_KALMAN: for (size_t i = 0; i < n; i++) yq[i] = filter_kalman_q_step(&f->u.kalman_q, xq[i]); break;
+                }
+            } else {
+                for (size_t i = 0; i < n; i++) yq[i] = filter_to_q(filter_chain_apply(&qc, x[i]));
+            }
+            double t2 = bench_now();
+            if (t1 - t0 < best_f) best_f = t1 - t0;
+            if (t2 - t1 < best_q) best_q = t2 - t1;
+        }
+
+        double max_err = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double e = filter_from_q(yq[i]) - yf[i];
+            if (e < 0) e = -e;
+            if (e > max_err) max_err = e;
+        }
+        printf("%-20s %14.1f %14.1f %10.2f %12.6f\n", cases[k].name, n / best_f / 1e6, n / best_q / 1e6,
+               best_f / best_q, max_err);
+    }
+
+    free(x);
+    free(yf);
+    free(xq);
+    free(yq);
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../sensor/frame.h"
+#include "../controller/ctl_logic.h"
+
+/* Canal-muestras por configuración: las filas se ajustan a los canales */
+#define FRAMES_TOTAL ((size_t)1 << 25)
+#define FRAMES_BLOCK 4096
+
+/* Señal sintética: caminata acotada a [0, 100] por canal */
+static void fill(sensor_frame_t *f, double *row_major, size_t rows) {
+    unsigned x = 2463534242u;
+    double *v = malloc(f->channels * sizeof(double));
+    for (size_t c = 0; c < f->channels; c++) v[c] = 50.0;
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < f->channels; c++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            v[c] += (double)(x % 601) / 100.0 - 3.0;
+            if (v[c] < 0.0) v[c] = 0.0;
+            if (v[c] > 100.0) v[c] = 100.0;
+            row_major[r * f->channels + c] = v[c];
+        }
+        frame_push(f, r * 0.001, &row_major[r * f->channels]);
+    }
+    free(v);
+}
+
+/* Referencia por filas (AoS): ctl_step canal por canal en cada tick */
+static size_t run_rows(const double *row_major, const double *ts, size_t rows,
+                       size_t channels, ctl_state_t *st) {
+    size_t on = 0;
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < channels; c++) {
+            ctl_step(&st[c], ts[r], row_major[r * channels + c]);
+            on += st[c].led_on;
+        }
+    }
+    return on;
+}
+
+/* SoA: kernel de umbral por bloque y luego el paso de cada canal */
+static size_t run_frames(const sensor_frame_t *f, const double *th, uint8_t *above,
+                         ctl_state_t *st) {
+    size_t transitions = 0;
+    for (size_t row0 = 0; row0 < f->rows; row0 += FRAMES_BLOCK) {
+        size_t n = f->rows - row0 < FRAMES_BLOCK ? f->rows - row0 : FRAMES_BLOCK;
+        frame_threshold(f, row0, n, th, above);
+        for (size_t c = 0; c < f->channels; c++) {
+            transitions += ctl_run_channel(&st[c], c, row0, n, f->ts, above + c * n, NULL, NULL);
+        }
+    }
+    return transitions;
+}
+
+int bench_frames(int argc, char *argv[]) {
+    static const size_t configs[] = {1, 8, 32, 64, 128, 256};
+    size_t total = argc > 0 ? (size_t)atol(argv[0]) << 20 : FRAMES_TOTAL;
+
+    printf("[BENCH] %zu M canal-muestras por configuración, bloques de %d filas\n",
+           total >> 20, FRAMES_BLOCK);
+    printf("%8s %10s %14s %14s %14s\n", "canales", "filas", "umbral SoA", "SoA+pasos", "filas (AoS)");
+    printf("%8s %10s %14s %14s %14s\n", "", "", "M c-m/s", "M c-m/s", "M c-m/s");
+
+    for (size_t k = 0; k < sizeof(configs) / sizeof(configs[0]); k++) {
+        size_t channels = configs[k];
+        size_t rows = total / channels;
+        sensor_frame_t f;
+        double *row_major = malloc(rows * channels * sizeof(double));
+        double *th = malloc(channels * sizeof(double));
+        ctl_state_t *st = malloc(channels * sizeof(ctl_state_t));
+        uint8_t *above = malloc(channels * FRAMES_BLOCK);
+        if (!row_major || !th || !st || !above || !frame_init(&f, channels, rows)) {
+            printf("[BENCH] Sin memoria para %zu canales\n", channels);
+            free(row_major);
+            free(th);
+            free(st);
+            free(above);
+            return 1;
+        }
+        fill(&f, row_major, rows);
+        for (size_t c = 0; c < channels; c++) th[c] = 40.0 + (double)(c % 20);
+
+        /* Mejor de 3 para cada variante */
+        double best[3] = {1e9, 1e9, 1e9};
+        volatile size_t sink = 0;
+        for (int rep = 0; rep < 3; rep++) {
+            double t0 = bench_now();
+            for (size_t row0 = 0; row0 < rows; row0 += FRAMES_BLOCK) {
+                size_t n = rows - row0 < FRAMES_BLOCK ? rows - row0 : FRAMES_BLOCK;
+                frame_threshold(&f, row0, n, th, above);
+                sink += above[0];
+            }
+            double t1 = bench_now();
+
+            for (size_t c = 0; c < channels; c++) ctl_init(&st[c], th[c]);
+            sink += run_frames(&f, th, above, st);
+            double t2 = bench_now();
+
+            for (size_t c = 0; c < channels; c++) ctl_init(&st[c], th[c]);
+            sink += run_rows(row_major, f.ts, rows, channels, st);
+            double t3 = bench_now();
+
+            if (t1 - t0 < best[0]) best[0] = t1 - t0;
+            if (t2 - t1 < best[1]) best[1] = t2 - t1;
+            if (t3 - t2 < best[2]) best[2] = t3 - t2;
+        }
+
+        double cs = (double)rows * (double)channels / 1e6;
+        printf("%8zu %10zu %14.1f %14.1f %14.1f\n", channels, rows,
+               cs / best[0], cs / best[1], cs / best[2]);
+
+        frame_free(&f);
+        free(row_major);
+        free(th);
+        free(st);
+        free(above);
+    }
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "../actuators/actuator.h"
+#include "../actuators/actuator_group.h"
+#include "../common/arena.h"
+#include "../common/rng.h"
+#include "../controller/ctl_logic.h"
+#include "../sensor/csv.h"
+#include "../sensor/filter.h"
+
+/* Cargas fijas y deterministas para comparar bench32 con bench64 (ver
+ * bench/matrix.sh). Cada invocación corre una sola carga, así el pico de
+ * memoria del proceso es el de esa carga, e imprime líneas para el script:
+ *
+ *     resultado <carga> <métrica> <valor> <unidad>
+ *     control <carga> <suma de control>
+ *     memoria <carga> <KB de pico de RSS>
+ */
+
+#define MATRIX_CSV_MB    32
+#define MATRIX_REPS      3
+#define MATRIX_SAMPLES   4000000
+#define MATRIX_OUTPUTS   1024
+#define MATRIX_ROUNDS    4001     /* Impar: quedan salidas encendidas */
+
+static void result(const char *load, const char *metric, double value, const char *unit) {
+    printf("resultado %s %s %.2f %s\n", load, metric, value, unit);
+}
+
+/* Señal de las cargas sin archivo: la misma en 32 y 64 bits */
+static void make_values(double *v, size_t n) {
+    rng_t r;
+    rng_seed(&r, 2463534242u);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t x = rng_next(&r);
+        v[i] = (i / 5000) % 2 ? 70.0 + x % 2001 / 100.0 : 30.0 + x % 2001 / 100.0;
+    }
+}
+
+/* Carga completa del CSV (mmap y parser propio) */
+static int load_csv(void) {
+    char path[] = "/tmp/bench_matrix_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || bench_csv_generate(path, MATRIX_CSV_MB) != 0) {
+        perror("[BENCH] No se pudo generar el CSV");
+        return 1;
+    }
+    close(fd);
+
+    double best = 1e9, sum = 0.0;
+    size_t count = 0;
+    for (int rep = 0; rep < MATRIX_REPS; rep++) {
+        double *v = NULL, *t = NULL;
+        double t0 = bench_now();
+        bool ok = csv_load_values(path, &v, &t, &count);
+        double dt = bench_now() - t0;
+        if (!ok) {
+            unlink(path);
+            return 1;
+        }
+        if (dt < best) best = dt;
+        sum = 0.0;
+        for (size_t i = 0; i < count; i++) sum += v[i];
+        free(v);
+        free(t);
+    }
+    unlink(path);
+    result("csv", "carga", (double)count / best / 1e6, "M_filas/s");
+    printf("control csv %zu:%.2f\n", count, sum);
+    return 0;
+}
+
+/* Evaluación por lotes: barrido de umbrales con ctl_step, como ctl_batch --sweep */
+static int batch(void) {
+    double *v = malloc(MATRIX_SAMPLES * sizeof(double));
+    if (!v) return 1;
+    make_values(v, MATRIX_SAMPLES);
+
+    unsigned long transitions = 0;
+    double t0 = bench_now();
+    for (int th = 30; th <= 70; th += 5) {
+        ctl_state_t s;
+        ctl_init(&s, th);
+        bool led = false;
+        for (size_t i = 0; i < MATRIX_SAMPLES; i++) {
+            ctl_step(&s, i * 0.1, v[i]);
+            transitions += s.led_on != led;
+            led = s.led_on;
+        }
+    }
+    double dt = bench_now() - t0;
+    result("lotes", "ctl_step", 9.0 * MATRIX_SAMPLES / dt / 1e6, "M_muestras/s");
+    printf("control lotes %lu\n", transitions);
+    free(v);
+    return 0;
+}
+
+/* Cadena de filtros en double y en punto fijo Q15 */
+static int filters(void) {
+    static filter_chain_t fc;
+    const char *spec = "median:5,ewma:0.2,kalman:0.01:4";
+    double *v = malloc(MATRIX_SAMPLES * sizeof(double));
+    if (!v) return 1;
+    make_values(v, MATRIX_SAMPLES);
+
+    for (int fixed = 0; fixed < 2; fixed++) {
+        char err[128];
+        if (!filter_chain_parse(&fc, spec, fixed, err, sizeof(err))) {
+            printf("[BENCH] Error en %s: %s\n", spec, err);
+            free(v);
+            return 1;
+        }
+        double sum = 0.0;
+        double t0 = bench_now();
+        for (size_t i = 0; i < MATRIX_SAMPLES; i++) sum += filter_chain_apply(&fc, v[i]);
+        double dt = bench_now() - t0;
+        result("filtros", fixed ? "Q15" : "double", MATRIX_SAMPLES / dt / 1e6, "M_muestras/s");
+        printf("control filtros_%s %.6f\n", fixed ? "Q15" : "double", sum);
+    }
+    free(v);
+    return 0;
+}
+
+/* Cada ronda invierte una de cada 8 salidas, rotando cuál */
+static void flip_round(uint64_t *want, size_t r) {
+    for (size_t i = r % 8; i < MATRIX_OUTPUTS; i += 8) want[i / 64] ^= (uint64_t)1 << (i % 64);
+}
+
+/* Despacho a actuadores: vtable por actuador contra el grupo por lotes, cada
+ * uno cronometrado por separado con el mismo recorrido de salidas */
+static int actuators(void) {
+    size_t words = ACTUATOR_GROUP_WORDS(MATRIX_OUTPUTS);
+    uint64_t *want = calloc(words, sizeof(uint64_t));
+    arena_t arena;
+    arena_init(&arena, 0);
+    Actuator *acts = arena_alloc(&arena, MATRIX_OUTPUTS * sizeof(Actuator));
+    if (!want || !acts) {
+        arena_free(&arena);
+        free(want);
+        return 1;
+    }
+    for (size_t i = 0; i < MATRIX_OUTPUTS; i++) acts[i] = create_led_actuator(&arena);
+    ActuatorGroup g = create_led_group(&arena, MATRIX_OUTPUTS);
+    actuator_set_quiet(true);
+
+    double t0 = bench_now();
+    for (size_t r = 0; r < MATRIX_ROUNDS; r++) {
+        flip_round(want, r);
+        for (size_t i = 0; i < MATRIX_OUTPUTS; i++) {
+            bool b = (want[i / 64] >> (i % 64)) & 1u;
+            if (b == acts[i].status(acts[i].params)) continue;
+            if (b) acts[i].activate(acts[i].params);
+            else acts[i].deactivate(acts[i].params);
+        }
+    }
+    double vtable = bench_now() - t0;
+
+    memset(want, 0, words * sizeof(uint64_t));
+    t0 = bench_now();
+    for (size_t r = 0; r < MATRIX_ROUNDS; r++) {
+        flip_round(want, r);
+        actuator_group_apply(&g, want);
+    }
+    double grouped = bench_now() - t0;
+
+    double outputs = (double)MATRIX_ROUNDS * MATRIX_OUTPUTS;
+    result("actuadores", "vtable", outputs / vtable / 1e6, "M_salidas/s");
+    result("actuadores", "grupo", outputs / grouped / 1e6, "M_salidas/s");
+
+    /* Los dos recorridos terminan con las mismas salidas encendidas */
+    unsigned long on = 0, on_group = 0;
+    for (size_t i = 0; i < MATRIX_OUTPUTS; i++) {
+        on += acts[i].status(acts[i].params);
+        on_group += actuator_group_status(&g, i);
+    }
+    printf("control actuadores %lu:%lu\n", on, on_group);
+    arena_free(&arena);
+    free(want);
+    return 0;
+}
+
+int bench_matrix(int argc, char *argv[]) {
+    static const struct {
+        const char *name;
+        int (*run)(void);
+    } loads[] = {
+        {"csv", load_csv},
+        {"lotes", batch},
+        {"filtros", filters},
+        {"actuadores", actuators},
+    };
+    size_t n = sizeof(loads) / sizeof(loads[0]);
+
+    for (size_t i = 0; argc > 0 && i < n; i++) {
+        if (strcmp(argv[0], loads[i].name) != 0) continue;
+        int rc = loads[i].run();
+        struct rusage ru;
+        getrusage(RUSAGE_SELF, &ru);
+        printf("memoria %s %ld\n", loads[i].name, ru.ru_maxrss);
+        return rc;
+    }
+
+    printf("[BENCH] Uso: matrix <carga> (");
+    for (size_t i = 0; i < n; i++) printf("%s%s", i ? ", " : "", loads[i].name);
+    printf("); bench/matrix.sh corre todas en bench32 y bench64\n");
+    return 1;
+}
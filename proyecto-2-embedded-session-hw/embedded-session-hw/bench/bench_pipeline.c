@@ -0,0 +1,140 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef CTL_PIPELINE
+#include "../common/hist.h"
+#include "../controller/pipeline.h"
+#include "../controller/rt.h"
+
+/* Latencia muestra -> actuación, medida desde el instante en que la muestra
+ * debía leerse (no desde que se leyó), con un actuador lento que consume
+ * cost_ns de CPU en cada cambio de estado */
+typedef struct {
+    uint64_t start;
+    uint64_t period;
+    uint64_t cost;
+    size_t total;
+    size_t next;
+    size_t run;             /* Muestras seguidas del mismo lado del umbral */
+    hist_t latency;
+} lat_ctx_t;
+
+static double sample_value(const lat_ctx_t *lc, size_t i) {
+    return (i / lc->run) % 2 ? 80.0 : 20.0;
+}
+
+static void slow_actuator(uint64_t cost) {
+    uint64_t until = rt_now_ns() + cost;
+    while (rt_now_ns() < until) {
+    }
+}
+
+static void record(lat_ctx_t *lc, double t) {
+    hist_record(&lc->latency, rt_now_ns() - (lc->start + (uint64_t)(t * 1e9)));
+}
+
+static size_t lat_acquire(void *ctx, sensor_sample_t *buf, size_t n) {
+    lat_ctx_t *lc = ctx;
+    (void)n;
+    if (lc->next == lc->total) return 0;
+    uint64_t due = lc->start + lc->next * lc->period;
+    rt_sleep_until_ns(due);
+    buf[0].t = (due - lc->start) / 1e9;
+    buf[0].value = sample_value(lc, lc->next++);
+    return 1;
+}
+
+static uint16_t lat_control(void *ctx, double t, double *value) {
+    (void)ctx;
+    (void)t;
+    return *value >= 50.0 ? 3u : 0u;
+}
+
+static void lat_actuate(void *ctx, const pipe_item_t *item, uint16_t changed) {
+    lat_ctx_t *lc = ctx;
+    if (changed) slow_actuator(lc->cost);
+    record(lc, item->t);
+}
+
+/* Modo serie: leer, decidir y actuar en el mismo hilo */
+static void run_serial(lat_ctx_t *lc) {
+    sensor_sample_t s;
+    uint16_t applied = 0;
+    while (lat_acquire(lc, &s, 1) > 0) {
+        uint16_t states = lat_control(lc, s.t, &s.value);
+        if (states != applied) slow_actuator(lc->cost);
+        applied = states;
+        record(lc, s.t);
+    }
+}
+
+int bench_pipeline(int argc, char *argv[]) {
+    static lat_ctx_t lc;
+    static pipeline_t pipe;
+    double rate = argc > 0 ? atof(argv[0]) : 1000.0;
+    double cost_us = argc > 1 ? atof(argv[1]) : 3000.0;
+    double seconds = argc > 2 ? atof(argv[2]) : 2.0;
+    if (rate <= 0.0 || cost_us < 0.0 || seconds <= 0.0) {
+        printf("[BENCH] Uso: pipeline [muestras/s] [µs por actuación] [segundos]\n");
+        return 1;
+    }
+
+    printf("[BENCH] %.0f muestras/s durante %.1f s; cada cambio de actuador cuesta %.0f µs y ocurre cada 10 muestras\n",
+           rate, seconds, cost_us);
+    printf("[BENCH] En las filas \"saturada\" cambia en cada muestra: si el costo supera el período la cola se llena\n");
+    printf("%-22s %10s %10s %10s %10s %10s %10s\n", "modo", "actuadas", "descart.",
+           "p50 us", "p99 us", "max us", "prom us");
+
+    /* mode: 0 serie, 1 tubería con contrapresión, 2 tubería que descarta */
+    static const struct {
+        const char *name;
+        int mode;
+        size_t run;
+    } runs[] = {
+        {"serie", 0, 10},
+        {"tubería: bloquear", 1, 10},
+        {"tubería: descartar", 2, 10},
+        {"saturada: serie", 0, 1},
+        {"saturada: bloquear", 1, 1},
+        {"saturada: descartar", 2, 1},
+    };
+    for (size_t k = 0; k < sizeof(runs) / sizeof(runs[0]); k++) {
+        int mode = runs[k].mode;
+        lc.period = (uint64_t)(1e9 / rate);
+        lc.cost = (uint64_t)(cost_us * 1000.0);
+        lc.total = (size_t)(seconds * rate);
+        lc.next = 0;
+        lc.run = runs[k].run;
+        hist_init(&lc.latency, runs[k].name);
+        lc.start = rt_now_ns() + 1000000;
+        unsigned long dropped = 0;
+
+        if (mode == 0) {
+            run_serial(&lc);
+        } else {
+            pipeline_config_t cfg = {lat_acquire, lat_control, lat_actuate, &lc,
+                                     mode == 1 ? PIPE_BLOCK : PIPE_DROP_OLDEST, 16};
+            if (!pipeline_init(&pipe, &cfg)) return 1;
+            pipeline_run(&pipe);
+            for (int i = 0; i < PIPE_STAGES; i++) dropped += pipe.stage[i].dropped;
+            pipeline_free(&pipe);
+        }
+        printf("%-22s %10llu %10lu %10.1f %10.1f %10.1f %10.1f\n", runs[k].name,
+               (unsigned long long)lc.latency.count, dropped,
+               hist_percentile(&lc.latency, 50.0) / 1000.0, hist_percentile(&lc.latency, 99.0) / 1000.0,
+               lc.latency.max / 1000.0, lc.latency.sum / lc.latency.count / 1000.0);
+    }
+    return 0;
+}
+
+#else
+
+int bench_pipeline(int argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    printf("[BENCH] La tubería solo se compila en 64 bits (-DCTL_PIPELINE)\n");
+    return 1;
+}
+
+#endif /* CTL_PIPELINE */
@@ -0,0 +1,67 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../actuators/actuator.h"
+#include "../actuators/actuator_group.h"
+#include "../actuators/pwm.h"
+#include "../controller/rt.h"
+
+#define PWM_BENCH_PERIOD 1000000ull     /* 1 kHz */
+#define PWM_BENCH_CHANGE 100000000ull   /* Un cambio de ciclo útil cada 100 ms */
+
+/* Corre el PWM seconds segundos con n canales; spin_ns como en pwm_config_t */
+static int run(size_t n, double seconds, uint64_t spin_ns, int priority) {
+    arena_t arena;
+    arena_init(&arena, 0);
+    ActuatorGroup out = create_led_group(&arena, n);
+    pwm_config_t cfg = {&out, PWM_BENCH_PERIOD, spin_ns, {0, priority, -1, false}};
+    pwm_t *p = pwm_start(&cfg);
+    if (!p) {
+        printf("[BENCH] No se pudo arrancar el PWM con %zu canales\n", n);
+        arena_free(&arena);
+        return 1;
+    }
+
+    /* Ciclos útiles repartidos entre 0 y 1; cada tanto se mueve uno */
+    for (size_t ch = 0; ch < n; ch++) pwm_set_duty(p, ch, (double)(ch + 1) / (double)(n + 1));
+    uint64_t end = rt_now_ns() + (uint64_t)(seconds * 1e9);
+    size_t changes = 0;
+    for (uint64_t next = rt_now_ns() + PWM_BENCH_CHANGE; next < end; next += PWM_BENCH_CHANGE) {
+        rt_sleep_until_ns(next);
+        changes++;
+        pwm_set_duty(p, changes % n, (double)(changes % 10) / 10.0);
+    }
+    rt_sleep_until_ns(end);
+
+    pwm_stats_t st;
+    pwm_stop(p, &st);
+    printf("%8zu %8.0f %8lu %9lu %8lu %8lu %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", n, spin_ns / 1000.0,
+           st.periods, st.edges, st.recomputes, st.overruns, hist_percentile(&st.error, 50.0) / 1000.0,
+           hist_percentile(&st.error, 99.0) / 1000.0, hist_percentile(&st.error, 99.9) / 1000.0,
+           st.error.max / 1000.0, hist_percentile(&st.period, 99.0) / 1000.0, st.period.max / 1000.0);
+    arena_free(&arena);
+    return 0;
+}
+
+int bench_pwm(int argc, char *argv[]) {
+    static const size_t sizes[] = {8, 32, 64, 128};
+    size_t max = argc > 0 ? (size_t)atol(argv[0]) : 64;
+    double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+    int priority = argc > 2 ? atoi(argv[2]) : 0;
+    int rc = 0;
+
+    if (max == 0 || max > PWM_MAX_CHANNELS || seconds <= 0.0) {
+        printf("[BENCH] Uso: pwm [canales <= %d] [segundos] [prioridad SCHED_FIFO]\n", PWM_MAX_CHANNELS);
+        return 1;
+    }
+    actuator_set_quiet(true);
+    printf("[BENCH] PWM a 1 kHz durante %.1f s, un cambio de ciclo útil cada 100 ms; atraso de los flancos y del\n"
+           "        inicio de cada período (jitter del período) en µs\n", seconds);
+    printf("%8s %8s %8s %9s %8s %8s %9s %9s %9s %9s %9s %9s\n", "canales", "spin µs", "períodos", "flancos",
+           "rearmes", "perdidos", "p50", "p99", "p99.9", "max", "ini p99", "ini max");
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]) && sizes[k] <= max; k++) {
+        rc |= run(sizes[k], seconds, 0, priority);
+        rc |= run(sizes[k], seconds, 20000, priority);
+    }
+    return rc;
+}
@@ -0,0 +1,74 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../controller/rules.h"
+
+#define RULES_CHANNELS 64
+#define RULES_ACTUATORS 32
+
+/* Configuración sintética: reglas repartidas entre canales, características
+ * y actuadores sin salida */
+static char *make_config(size_t nrules) {
+    size_t cap = 256 + nrules * 96 + RULES_ACTUATORS * 32;
+    char *text = malloc(cap);
+    size_t len = 0;
+    static const char *feats[] = {"raw", "rate", "avg8", "avg32"};
+
+    for (unsigned a = 0; a < RULES_ACTUATORS; a++) {
+        len += (size_t)snprintf(text + len, cap - len, "actuator a%u none\n", a);
+    }
+    for (size_t i = 0; i < nrules; i++) {
+        unsigned ch = (unsigned)(i % RULES_CHANNELS);
+        const char *feat = feats[(i / RULES_CHANNELS) % 4];
+        double on = strcmp(feat, "rate") == 0 ? 2500.0 : 40.0 + (double)(i % 30);
+        unsigned a = (unsigned)(i % RULES_ACTUATORS);
+        len += (size_t)snprintf(text + len, cap - len,
+                                "rule %u %s %s %.1f %.1f : a%u=on : a%u=off@0.5\n",
+                                ch, feat, (i & 1) ? ">=" : "<=", on, (i & 1) ? on - 5.0 : on + 5.0, a, a);
+    }
+    return text;
+}
+
+int bench_rules(int argc, char *argv[]) {
+    static const size_t sizes[] = {16, 128, 512, 2048};
+    size_t ticks = argc > 0 ? (size_t)atol(argv[0]) : 200000;
+    double values[RULES_CHANNELS];
+    char err[256];
+
+    printf("[BENCH] %d canales, %zu ticks de 1 ms por configuración\n", RULES_CHANNELS, ticks);
+    printf("%8s %12s %14s %14s\n", "reglas", "flancos", "ns/tick", "M reglas/s");
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        rules_t r;
+        char *text = make_config(sizes[k]);
+        if (!rules_parse(&r, text, err, sizeof(err))) {
+            printf("[BENCH] Error en la configuración: %s\n", err);
+            free(text);
+            return 1;
+        }
+        free(text);
+
+        for (int c = 0; c < RULES_CHANNELS; c++) values[c] = 50.0;
+        unsigned x = 362436069u;
+        size_t edges = 0;
+
+        double t0 = bench_now();
+        for (size_t t = 0; t < ticks; t++) {
+            for (int c = 0; c < RULES_CHANNELS; c++) {
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                double v = values[c] + (double)(x % 601) / 100.0 - 3.0;
+                values[c] = v < 0.0 ? 0.0 : v > 100.0 ? 100.0 : v;
+            }
+            edges += rules_eval(&r, (double)t * 0.001, values);
+        }
+        double dt = bench_now() - t0;
+
+        printf("%8zu %12zu %14.1f %14.1f\n", r.nrules, edges, dt / ticks * 1e9,
+               (double)r.nrules * ticks / dt / 1e6);
+        rules_free(&r);
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../common/rng.h"
+#include "../sensor/synth.h"
+
+#define SYNTH_BLOCK 4096        /* Muestras por llamada a synth_fill */
+
+/* Media y varianza de todas las muestras de la corrida (control de que el
+ * generador no está roto). Las sumas se toman respecto de la primera
+ * muestra para no perder precisión al restar. */
+typedef struct {
+    double k, s, s2;
+    size_t n;
+} moments_t;
+
+static void moments_add(moments_t *m, const double *v, size_t n) {
+    if (m->n == 0 && n > 0) m->k = v[0];
+    double s = 0.0, s2 = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double d = v[i] - m->k;
+        s += d;
+        s2 += d * d;
+    }
+    m->s += s;
+    m->s2 += s2;
+    m->n += n;
+}
+
+static void report(const char *name, size_t n, double dt, const moments_t *m) {
+    double mean = m->s / (double)m->n;
+    double var = m->s2 / (double)m->n - mean * mean;
+    printf("%-28s %12.1f %12.3f %12.3f\n", name, n / dt / 1e6, m->k + mean, var);
+}
+
+/* Generadores que se comparan: llenan v con n muestras */
+typedef void (*fill_fn)(void *ctx, double *v, size_t n);
+
+/* Corre fill en bloques de SYNTH_BLOCK hasta n muestras; se mide solo la
+ * generación y los momentos se acumulan sobre toda la corrida */
+static void run_fill(const char *label, fill_fn fill, void *ctx, size_t n, double *v) {
+    moments_t m = {0};
+    double dt = 0.0;
+    for (size_t done = 0; done < n; done += SYNTH_BLOCK) {
+        double t0 = bench_now();
+        fill(ctx, v, SYNTH_BLOCK);
+        dt += bench_now() - t0;
+        moments_add(&m, v, SYNTH_BLOCK);
+    }
+    report(label, n, dt, &m);
+}
+
+/* Referencia: lo que hacía la fuente aleatoria (estado global, enteros) */
+static void fill_rand(void *ctx, double *v, size_t n) {
+    (void)ctx;
+    for (size_t i = 0; i < n; i++) v[i] = (double)(rand() % 101);
+}
+
+static void fill_uniform(void *ctx, double *v, size_t n) {
+    rng_t *r = ctx;
+    for (size_t i = 0; i < n; i++) v[i] = rng_uniform(r) * 100.0;
+}
+
+static void fill_gauss(void *ctx, double *v, size_t n) {
+    rng_t *r = ctx;
+    for (size_t i = 0; i < n; i++) v[i] = 50.0 + 10.0 * rng_gauss(r);
+}
+
+typedef struct {
+    synth_t *s;
+    double *t;
+} synth_ctx_t;
+
+static void fill_synth(void *ctx, double *v, size_t n) {
+    synth_ctx_t *c = ctx;
+    synth_fill(c->s, c->t, v, n);
+}
+
+/* Genera n muestras de la especificación dada en bloques de SYNTH_BLOCK */
+static int run_spec(const char *label, const char *spec, size_t n, double *t, double *v) {
+    synth_config_t cfg;
+    char err[128];
+    synth_defaults(&cfg);
+    if (!synth_parse(&cfg, spec, err, sizeof(err))) {
+        printf("[BENCH] Error en %s: %s\n", spec, err);
+        return 1;
+    }
+    synth_ctx_t c = {malloc(sizeof(synth_t)), t};
+    if (!c.s) return 1;
+    synth_init(c.s, &cfg);
+    run_fill(label, fill_synth, &c, n, v);
+    free(c.s);
+    return 0;
+}
+
+int bench_synth(int argc, char *argv[]) {
+    size_t n = argc > 0 ? (size_t)atol(argv[0]) : 50000000;
+    n = (n + SYNTH_BLOCK - 1) / SYNTH_BLOCK * SYNTH_BLOCK;
+    double *t = malloc(SYNTH_BLOCK * sizeof(double));
+    double *v = malloc(SYNTH_BLOCK * sizeof(double));
+    if (!t || !v) return 1;
+
+    printf("[BENCH] Generación de %zu muestras sintéticas\n", n);
+    printf("%-28s %12s %12s %12s\n", "generador", "M muestras/s", "media", "varianza");
+
+    srand(1);
+    run_fill("rand() % 101", fill_rand, NULL, n, v);
+    rng_t r;
+    rng_seed(&r, 1);
+    run_fill("xoshiro escalar, uniforme", fill_uniform, &r, n, v);
+    run_fill("xoshiro escalar, gaussiano", fill_gauss, &r, n, v);
+
+    int rc = 0;
+    rc |= run_spec("bloques, gaussiano", "noise=10", n, t, v);
+    rc |= run_spec("bloques, sinusoide", "sin=20:60", n, t, v);
+    rc |= run_spec("bloques, caminata", "walk=0.5", n, t, v);
+    rc |= run_spec("bloques, todos los modelos",
+                   "noise=2,walk=0.001,sin=20:60,step=30:10,spike=0.001:40,stuck=100:5,clamp=0:100", n, t, v);
+
+    free(t);
+    free(v);
+    return rc;
+}
@@ -0,0 +1,93 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "../common/timer_wheel.h"
+
+/* Horizonte de los timers: 60 s con ticks de 1 ms */
+#define TIMERS_HORIZON 60000u
+/* Ticks medidos para la referencia de recorrido lineal */
+#define SCAN_TICKS 200u
+
+typedef struct {
+    timer_wheel_t *wheel;
+    size_t fired;
+    size_t late;            /* Callbacks que no vencieron en su tick */
+} fire_ctx_t;
+
+static void on_fire(tw_timer_t *t, void *arg) {
+    fire_ctx_t *ctx = arg;
+    ctx->fired++;
+    ctx->late += (t->expires != ctx->wheel->now);
+}
+
+/* Referencia: un vencimiento por actuador revisado en cada tick, como los
+ * led_off_time/buzzer_off_time originales */
+static double linear_scan_tick_ns(const uint32_t *delays, size_t n) {
+    double *deadline = malloc(n * sizeof(double));
+    size_t fired = 0;
+    for (size_t i = 0; i < n; i++) deadline[i] = delays[i];
+
+    double t0 = bench_now();
+    for (unsigned tick = 1; tick <= SCAN_TICKS; tick++) {
+        for (size_t i = 0; i < n; i++) {
+            if (deadline[i] > 0.0 && tick >= deadline[i]) {
+                deadline[i] = 0.0;
+                fired++;
+            }
+        }
+    }
+    double dt = bench_now() - t0;
+    free(deadline);
+    if (fired == 0) printf("[BENCH] Aviso: la referencia lineal no venció ningún timer\n");
+    return dt / SCAN_TICKS * 1e9;
+}
+
+int bench_timers(int argc, char *argv[]) {
+    static const size_t sizes[] = {1000, 10000, 100000, 1000000};
+    static timer_wheel_t wheel;
+    (void)argc;
+    (void)argv;
+
+    printf("[BENCH] Timers con vencimiento aleatorio en [1, %u] ticks; se cancela la mitad\n", TIMERS_HORIZON);
+    printf("%9s %12s %12s %12s %14s %16s\n", "timers", "prog ns/op", "canc ns/op", "venc ns/op",
+           "rueda ns/tick", "lineal ns/tick");
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        size_t n = sizes[k];
+        tw_timer_t *timers = malloc(n * sizeof(tw_timer_t));
+        uint32_t *delays = malloc(n * sizeof(uint32_t));
+        fire_ctx_t ctx = {&wheel, 0, 0};
+        unsigned x = 88172645u;
+
+        for (size_t i = 0; i < n; i++) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            delays[i] = 1 + x % TIMERS_HORIZON;
+            tw_timer_init(&timers[i], on_fire, &ctx);
+        }
+
+        tw_init(&wheel, 0);
+        double t0 = bench_now();
+        for (size_t i = 0; i < n; i++) tw_schedule(&wheel, &timers[i], delays[i], 0);
+        double t1 = bench_now();
+        for (size_t i = 0; i < n; i += 2) tw_cancel(&wheel, &timers[i]);
+        double t2 = bench_now();
+        tw_advance(&wheel, TIMERS_HORIZON);
+        double t3 = bench_now();
+
+        size_t cancelled = (n + 1) / 2;
+        double scan = linear_scan_tick_ns(delays, n);
+        printf("%9zu %12.1f %12.1f %12.1f %14.1f %16.1f\n", n,
+               (t1 - t0) / n * 1e9, (t2 - t1) / cancelled * 1e9,
+               (t3 - t2) / (n - cancelled) * 1e9, (t3 - t2) / TIMERS_HORIZON * 1e9, scan);
+        if (ctx.fired != n - cancelled || ctx.late || wheel.pending) {
+            printf("[BENCH] ERROR: vencieron %zu de %zu (%zu fuera de tiempo, %zu pendientes)\n",
+                   ctx.fired, n - cancelled, ctx.late, wheel.pending);
+        }
+
+        free(timers);
+        free(delays);
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#!/bin/sh
+# Matriz de rendimiento 32 vs 64 bits: corre cada carga de "bench matrix" en
+# bench32 y en bench64 (un proceso por carga, para que el pico de RSS sea el
+# de esa carga) y arma la tabla comparativa. Uso: sh bench/matrix.sh [cargas]
+
+cd "$(dirname "$0")/.." || exit 1
+loads=${*:-"csv lotes filtros actuadores"}
+out=$(mktemp /tmp/bench_matrix_XXXXXX) || exit 1
+run="$out.run"
+trap 'rm -f "$out" "$run"' EXIT
+
+for arch in 32 64; do
+    if [ ! -x "./bench$arch" ]; then
+        echo "[MATRIX] No existe ./bench$arch: su columna queda vacía" >&2
+        continue
+    fi
+    for load in $loads; do
+        # La salida pasa por un archivo para ver el estado del bench y no el de sed
+        if ./bench$arch matrix "$load" >"$run"; then
+            sed "s/^/$arch /" "$run" >>"$out"
+        else
+            echo "[MATRIX] bench$arch falló en la carga $load" >&2
+        fi
+    done
+done
+
+awk -v loads="$loads" '
+$2 == "resultado" { v[$1, $3, $4] = $5; unit[$3, $4] = $6; if (!(($3, $4) in seen)) { seen[$3, $4] = 1; keys[$3] = keys[$3] " " $4 } }
+$2 == "control"   { sum[$1, $3] = $4; if (!($3 in ctl)) { ctl[$3] = 1; order[++nctl] = $3 } }
+$2 == "memoria"   { rss[$1, $3] = $4 }
+function cell(x) { return x == "" ? "-" : x }
+END {
+    printf "=== MATRIZ 32 vs 64 BITS ===\n"
+    printf "%-11s %-9s %-13s %10s %10s %7s %10s %10s\n", "carga", "medida", "unidad", "32 bits", "64 bits", "64/32", "RSS32 KB", "RSS64 KB"
+    n = split(loads, l, " ")
+    for (i = 1; i <= n; i++) {
+        m = split(keys[l[i]], k, " ")
+        for (j = 1; j <= m; j++) {
+            a = v[32, l[i], k[j]]; b = v[64, l[i], k[j]]
+            ratio = (a != "" && b != "" && a > 0) ? sprintf("%.2fx", b / a) : "-"
+            printf "%-11s %-9s %-13s %10s %10s %7s %10s %10s\n", l[i], k[j], unit[l[i], k[j]], cell(a), cell(b), ratio,
+                   j == 1 ? cell(rss[32, l[i]]) : "", j == 1 ? cell(rss[64, l[i]]) : ""
+        }
+    }
+    printf "\nSumas de control (deben coincidir; en double puede haber diferencias de redondeo con x87):\n"
+    for (i = 1; i <= nctl; i++) {
+        c = order[i]; a = sum[32, c]; b = sum[64, c]
+        printf "  %-16s %-24s %-24s %s\n", c, cell(a), cell(b), (a == "" || b == "") ? "" : (a == b ? "iguales" : "DISTINTAS")
+    }
+}' "$out"
@@ -0,0 +1,74 @@
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+#define ARENA_ALIGN alignof(max_align_t)
+
+/* Los datos empiezan después del encabezado, ya alineados */
+#define CHUNK_HEADER ((sizeof(arena_chunk_t) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1))
+
+static inline unsigned char *chunk_data(arena_chunk_t *c) {
+    return (unsigned char *)c + CHUNK_HEADER;
+}
+
+void arena_init(arena_t *a, size_t chunk_size) {
+    a->head = NULL;
+    a->chunk_size = chunk_size ? chunk_size : ARENA_CHUNK_DEFAULT;
+    a->allocated = 0;
+}
+
+void *arena_alloc(arena_t *a, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    if (size == 0) size = ARENA_ALIGN;
+
+    arena_chunk_t *c = a->head;
+    if (!c || c->size - c->used < size) {
+        /* Bloque nuevo; los pedidos más grandes que un bloque van en uno propio */
+        size_t cap = size > a->chunk_size ? size : a->chunk_size;
+        c = malloc(CHUNK_HEADER + cap);
+        if (!c) return NULL;
+        c->size = cap;
+        c->used = 0;
+        c->next = a->head;
+        a->head = c;
+    }
+    void *p = chunk_data(c) + c->used;
+    c->used += size;
+    a->allocated += size;
+    return memset(p, 0, size);
+}
+
+void arena_reset(arena_t *a) {
+    arena_chunk_t *c = a->head;
+    if (!c) return;
+    /* Se conserva un bloque de tamaño normal; los propios de pedidos
+     * grandes se liberan */
+    arena_chunk_t *keep = NULL;
+    while (c) {
+        arena_chunk_t *next = c->next;
+        if (!keep && c->size == a->chunk_size) {
+            keep = c;
+        } else {
+            free(c);
+        }
+        c = next;
+    }
+    if (keep) {
+        keep->used = 0;
+        keep->next = NULL;
+    }
+    a->head = keep;
+    a->allocated = 0;
+}
+
+void arena_free(arena_t *a) {
+    arena_chunk_t *c = a->head;
+    while (c) {
+        arena_chunk_t *next = c->next;
+        free(c);
+        c = next;
+    }
+    a->head = NULL;
+    a->allocated = 0;
+}
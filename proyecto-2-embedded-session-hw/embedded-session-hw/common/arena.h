@@ -0,0 +1,37 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/* Arena de memoria: reserva bloques grandes y entrega pedazos consecutivos
+ * con un puntero que avanza. No se libera objeto por objeto: todo se libera
+ * junto (arena_reset o arena_free), así que miles de instancias quedan
+ * contiguas en memoria y el apagado es una sola liberación. */
+
+#define ARENA_CHUNK_DEFAULT ((size_t)64 << 10)
+
+typedef struct arena_chunk {
+    struct arena_chunk *next;   /* Bloque anterior */
+    size_t size;                /* Bytes útiles del bloque */
+    size_t used;
+} arena_chunk_t;
+
+typedef struct {
+    arena_chunk_t *head;        /* Bloque actual */
+    size_t chunk_size;          /* Tamaño de los bloques nuevos */
+    size_t allocated;           /* Bytes entregados desde el último reset */
+} arena_t;
+
+/* Arena vacía; chunk_size 0 = ARENA_CHUNK_DEFAULT. No reserva nada todavía. */
+extern void arena_init(arena_t *a, size_t chunk_size);
+
+/* size bytes en cero, alineados para cualquier tipo; NULL si falta memoria */
+extern void *arena_alloc(arena_t *a, size_t size);
+
+/* Invalida todo lo entregado y conserva un solo bloque para reutilizarlo */
+extern void arena_reset(arena_t *a);
+
+/* Libera todos los bloques */
+extern void arena_free(arena_t *a);
+
+#endif /* ARENA_H */
@@ -0,0 +1,111 @@
+#define _POSIX_C_SOURCE 200809L
+#include <string.h>
+#include <time.h>
+#include "event_log.h"
+
+void event_log_format(FILE *out, const event_log_header_t *h, const event_record_t *rec) {
+    if (rec->kind == EVENT_DROPPED) {
+        fprintf(out, "[LOG] %.0f eventos descartados\n", rec->value);
+        return;
+    }
+    fprintf(out, "[t=%.2f] Sensor=%.2f", rec->t, rec->value);
+    for (uint32_t i = 0; i < h->nactuators; i++) {
+        fprintf(out, " | %.*s=%s", EVLOG_NAME_MAX, h->names[i], (rec->states >> i) & 1u ? "ON" : "OFF");
+    }
+    fputc('\n', out);
+}
+
+static void emit(event_log_t *log, const event_record_t *rec) {
+    if (log->text) event_log_format(log->out, &log->header, rec);
+    else fwrite(rec, sizeof(*rec), 1, log->out);
+    log->written++;
+}
+
+/* Hilo de fondo: vacía la cola; si no hay nada espera 1 ms */
+static void *writer(void *arg) {
+    event_log_t *log = arg;
+    event_record_t rec;
+    unsigned long long reported = 0;
+
+    for (;;) {
+        bool stopping = atomic_load_explicit(&log->stop, memory_order_acquire);
+        size_t n = 0;
+        while (spsc_pop(&log->ring, &rec)) {
+            emit(log, &rec);
+            n++;
+        }
+
+        /* Los descartes quedan marcados en el log donde ocurrieron */
+        unsigned long long dropped = atomic_load_explicit(&log->dropped, memory_order_relaxed);
+        if (dropped != reported) {
+            memset(&rec, 0, sizeof(rec));
+            rec.kind = EVENT_DROPPED;
+            rec.value = (double)(dropped - reported);
+            emit(log, &rec);
+            reported = dropped;
+        }
+
+        if (stopping && n == 0) break;
+        if (n == 0) {
+            struct timespec pause = {0, 1000000};
+            fflush(log->out);
+            nanosleep(&pause, NULL);
+        }
+    }
+    fflush(log->out);
+    return NULL;
+}
+
+bool event_log_open(event_log_t *log, const char *path, size_t capacity,
+                    const char *const *names, size_t nactuators) {
+    memset(log, 0, sizeof(*log));
+    atomic_init(&log->stop, false);
+    atomic_init(&log->dropped, 0);
+    if (nactuators > EVLOG_MAX_ACTUATORS) nactuators = EVLOG_MAX_ACTUATORS;
+
+    memcpy(log->header.magic, EVLOG_MAGIC, sizeof(log->header.magic));
+    log->header.version = EVLOG_VERSION;
+    log->header.record_size = sizeof(event_record_t);
+    log->header.nactuators = (uint32_t)nactuators;
+    for (size_t i = 0; i < nactuators; i++) {
+        strncpy(log->header.names[i], names[i], EVLOG_NAME_MAX - 1);
+    }
+
+    log->text = strcmp(path, "-") == 0;
+    log->out = log->text ? stdout : fopen(path, "wb");
+    if (!log->out) return false;
+    if (!spsc_init(&log->ring, sizeof(event_record_t), capacity)) {
+        if (!log->text) fclose(log->out);
+        return false;
+    }
+    if (!log->text) fwrite(&log->header, sizeof(log->header), 1, log->out);
+
+    if (pthread_create(&log->thread, NULL, writer, log) != 0) {
+        spsc_free(&log->ring);
+        if (!log->text) fclose(log->out);
+        return false;
+    }
+    return true;
+}
+
+void event_log_sample(event_log_t *log, double t, double value, uint16_t states) {
+    event_record_t rec;
+    rec.t = t;
+    rec.value = value;
+    rec.seq = log->seq++;
+    rec.kind = EVENT_SAMPLE;
+    rec.states = states;
+    if (!spsc_push(&log->ring, &rec)) {
+        atomic_fetch_add_explicit(&log->dropped, 1, memory_order_relaxed);
+    }
+}
+
+void event_log_close(event_log_t *log) {
+    atomic_store_explicit(&log->stop, true, memory_order_release);
+    pthread_join(log->thread, NULL);
+    spsc_free(&log->ring);
+    if (!log->text) fclose(log->out);
+    fprintf(stderr, "[LOG] %llu registros escritos, %llu descartados\n",
+            (unsigned long long)log->written,
+            (unsigned long long)atomic_load(&log->dropped));
+}
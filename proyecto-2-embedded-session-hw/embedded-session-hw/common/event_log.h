@@ -0,0 +1,70 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "spsc_ring.h"
+
+/* Log binario de eventos: el hilo de control escribe registros de tamaño
+ * fijo en una cola SPSC sin bloquearse nunca (si está llena, el registro se
+ * descarta y se cuenta) y un hilo de fondo los guarda o los formatea. */
+
+#define EVLOG_MAGIC         "CTLLOG1\n"
+#define EVLOG_VERSION       1
+#define EVLOG_MAX_ACTUATORS 16
+#define EVLOG_NAME_MAX      16
+
+typedef enum {
+    EVENT_SAMPLE  = 1,          /* Muestra: valor y estado de los actuadores */
+    EVENT_DROPPED = 2           /* Registros descartados desde el anterior (en value) */
+} event_kind_t;
+
+/* Registro de 24 bytes; el bit i de states es el actuador i del header */
+typedef struct {
+    double t;                   /* Segundos (reloj del bucle de control) */
+    double value;
+    uint32_t seq;               /* Número de muestra */
+    uint16_t kind;
+    uint16_t states;
+} event_record_t;
+
+/* Header del archivo binario */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t nactuators;
+    uint32_t reserved;
+    char names[EVLOG_MAX_ACTUATORS][EVLOG_NAME_MAX];
+} event_log_header_t;
+
+typedef struct {
+    spsc_ring_t ring;
+    pthread_t thread;
+    FILE *out;
+    bool text;                  /* Formatear a texto en vez de guardar binario */
+    atomic_bool stop;
+    atomic_ullong dropped;      /* Registros que no entraron en la cola */
+    uint64_t written;           /* Registros escritos (solo el hilo de fondo) */
+    uint32_t seq;
+    event_log_header_t header;
+} event_log_t;
+
+/* Abre el log en path ("-" = texto por stdout) con una cola de capacity
+ * registros y arranca el hilo de fondo. false si no se pudo. */
+extern bool event_log_open(event_log_t *log, const char *path, size_t capacity,
+                           const char *const *names, size_t nactuators);
+
+/* Hilo de control: encola una muestra sin bloquear */
+extern void event_log_sample(event_log_t *log, double t, double value, uint16_t states);
+
+/* Vacía la cola, detiene el hilo, cierra el archivo e informa en stderr */
+extern void event_log_close(event_log_t *log);
+
+/* Una línea de texto por registro (compartido con el decodificador) */
+extern void event_log_format(FILE *out, const event_log_header_t *h, const event_record_t *rec);
+
+#endif /* EVENT_LOG_H */
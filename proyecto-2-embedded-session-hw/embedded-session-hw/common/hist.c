@@ -0,0 +1,65 @@
+#include <string.h>
+#include "hist.h"
+
+/* Índice del bucket: exacto hasta 2*HIST_SUB, luego HIST_SUB por octava */
+static unsigned bucket_of(uint64_t v) {
+    if (v < 2 * HIST_SUB) return (unsigned)v;
+    unsigned msb = 63u - (unsigned)__builtin_clzll(v);
+    unsigned shift = msb - HIST_SUB_BITS;
+    return shift * HIST_SUB + (unsigned)(v >> shift);
+}
+
+/* Mayor valor que cae en el bucket idx */
+static uint64_t bucket_high(unsigned idx) {
+    if (idx < 2 * HIST_SUB) return idx;
+    unsigned shift = idx / HIST_SUB - 1;
+    uint64_t top = idx % HIST_SUB + HIST_SUB;
+    return ((top + 1) << shift) - 1;
+}
+
+void hist_init(hist_t *h, const char *name) {
+    memset(h, 0, sizeof(*h));
+    h->name = name;
+    h->min = UINT64_MAX;
+}
+
+void hist_record(hist_t *h, uint64_t value) {
+    h->buckets[bucket_of(value)]++;
+    h->count++;
+    h->sum += (double)value;
+    if (value < h->min) h->min = value;
+    if (value > h->max) h->max = value;
+}
+
+uint64_t hist_percentile(const hist_t *h, double p) {
+    if (h->count == 0) return 0;
+    uint64_t rank = (uint64_t)(p / 100.0 * (double)h->count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > h->count) rank = h->count;
+
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->buckets[i];
+        if (seen >= rank) {
+            uint64_t high = bucket_high(i);
+            return high < h->max ? high : h->max;
+        }
+    }
+    return h->max;
+}
+
+void hist_print(const hist_t *h, FILE *out, double scale, const char *unit) {
+    static const double pcts[] = {50.0, 90.0, 99.0, 99.9, 99.99};
+
+    if (h->count == 0) {
+        fprintf(out, "%-10s sin datos\n", h->name);
+        return;
+    }
+    fprintf(out, "%-10s n=%llu min=%.1f", h->name, (unsigned long long)h->count,
+            (double)h->min / scale);
+    for (size_t i = 0; i < sizeof(pcts) / sizeof(pcts[0]); i++) {
+        fprintf(out, " p%g=%.1f", pcts[i], (double)hist_percentile(h, pcts[i]) / scale);
+    }
+    fprintf(out, " max=%.1f prom=%.1f %s\n", (double)h->max / scale,
+            h->sum / (double)h->count / scale, unit);
+}
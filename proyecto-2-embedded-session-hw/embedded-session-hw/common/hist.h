@@ -0,0 +1,36 @@
+#ifndef HIST_H
+#define HIST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* Histograma estilo HDR: escala log-lineal con 32 sub-buckets por octava,
+ * error relativo menor al 3.2 % en todo el rango de uint64_t. Registrar es
+ * O(1) y sin memoria dinámica, apto para el bucle de tiempo real. */
+#define HIST_SUB_BITS 5
+#define HIST_SUB      (1u << HIST_SUB_BITS)
+#define HIST_BUCKETS  (64u * HIST_SUB)
+
+typedef struct {
+    const char *name;               /* Nombre para el volcado */
+    uint64_t count;                 /* Valores registrados */
+    uint64_t min;
+    uint64_t max;
+    double sum;                     /* Para el promedio */
+    uint64_t buckets[HIST_BUCKETS];
+} hist_t;
+
+/* Deja el histograma vacío */
+extern void hist_init(hist_t *h, const char *name);
+
+/* Registra un valor (por ejemplo nanosegundos) */
+extern void hist_record(hist_t *h, uint64_t value);
+
+/* Valor del percentil p (0-100): cota superior del bucket que lo contiene */
+extern uint64_t hist_percentile(const hist_t *h, double p);
+
+/* Imprime conteo, min, percentiles y max; scale divide los valores
+ * (1000 para mostrar ns como µs) y unit es la unidad resultante */
+extern void hist_print(const hist_t *h, FILE *out, double scale, const char *unit);
+
+#endif /* HIST_H */
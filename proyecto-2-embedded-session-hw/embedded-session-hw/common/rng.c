@@ -0,0 +1,68 @@
+#include "rng.h"
+
+void rng_jump(rng_t *r) {
+    static const uint64_t jump[] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                    0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & (1ull << b)) {
+                s0 ^= r->s[0];
+                s1 ^= r->s[1];
+                s2 ^= r->s[2];
+                s3 ^= r->s[3];
+            }
+            rng_next(r);
+        }
+    }
+    r->s[0] = s0;
+    r->s[1] = s1;
+    r->s[2] = s2;
+    r->s[3] = s3;
+}
+
+void rng_lanes_seed(rng_lanes_t *r, uint64_t seed) {
+    rng_t g;
+    rng_seed(&g, seed);
+    for (int l = 0; l < RNG_LANES; l++) {
+        for (int i = 0; i < 4; i++) r->s[i][l] = g.s[i];
+        rng_jump(&g);
+    }
+}
+
+/* Con SSE2 (2 palabras por registro) los 8 carriles no le ganan al
+ * generador escalar; se compila también una versión AVX2 y el cargador
+ * elige según la CPU */
+__attribute__((target_clones("avx2", "default")))
+void rng_lanes_fill(rng_lanes_t *r, uint64_t *out, size_t n) {
+    /* Estado en variables locales para que el compilador lo deje en registros */
+    uint64_t s0[RNG_LANES], s1[RNG_LANES], s2[RNG_LANES], s3[RNG_LANES];
+    for (int l = 0; l < RNG_LANES; l++) {
+        s0[l] = r->s[0][l];
+        s1[l] = r->s[1][l];
+        s2[l] = r->s[2][l];
+        s3[l] = r->s[3][l];
+    }
+    for (size_t i = 0; i + RNG_LANES <= n; i += RNG_LANES) {
+        for (int l = 0; l < RNG_LANES; l++) {
+            /* x * 5 y r * 9 como desplazamientos: SSE2/AVX2 no multiplican
+             * enteros de 64 bits */
+            uint64_t x = s1[l] + (s1[l] << 2);
+            uint64_t r5 = (x << 7) | (x >> 57);
+            out[i + l] = r5 + (r5 << 3);
+            uint64_t t = s1[l] << 17;
+            s2[l] ^= s0[l];
+            s3[l] ^= s1[l];
+            s1[l] ^= s2[l];
+            s0[l] ^= s3[l];
+            s2[l] ^= t;
+            s3[l] = (s3[l] << 45) | (s3[l] >> 19);
+        }
+    }
+    for (int l = 0; l < RNG_LANES; l++) {
+        r->s[0][l] = s0[l];
+        r->s[1][l] = s1[l];
+        r->s[2][l] = s2[l];
+        r->s[3][l] = s3[l];
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Generador pseudoaleatorio xoshiro256** con estado por instancia: misma
+ * semilla, misma secuencia, sin estado global y reentrante. La semilla se
+ * expande con splitmix64, así que cualquier valor (incluso 0) sirve. */
+
+typedef struct {
+    uint64_t s[4];
+} rng_t;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_splitmix(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline void rng_seed(rng_t *r, uint64_t seed) {
+    for (int i = 0; i < 4; i++) r->s[i] = rng_splitmix(&seed);
+}
+
+static inline uint64_t rng_next(rng_t *r) {
+    uint64_t *s = r->s;
+    uint64_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return result;
+}
+
+/* Uniforme en [0, 1) con 53 bits */
+static inline double rng_uniform_bits(uint64_t x) {
+    return (double)(x >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Normal estándar aproximada a partir de 128 bits: suma de 8 uniformes de
+ * 16 bits (Irwin-Hall) centrada y escalada a desvío 1. Colas hasta ±4.9σ;
+ * solo operaciones enteras y una conversión, así que los bucles que la usan
+ * se vectorizan (sin libm). */
+static inline double rng_gauss_bits(uint64_t a, uint64_t b) {
+    const uint64_t m = 0x0000FFFF0000FFFFull;
+    uint64_t s = (a & m) + ((a >> 16) & m) + (b & m) + ((b >> 16) & m);
+    int32_t sum = (int32_t)((uint32_t)s + (uint32_t)(s >> 32));
+    return ((double)sum - 262140.0) * (1.224744871391589 / 65536.0);
+}
+
+static inline double rng_uniform(rng_t *r) {
+    return rng_uniform_bits(rng_next(r));
+}
+
+static inline double rng_gauss(rng_t *r) {
+    uint64_t a = rng_next(r);
+    return rng_gauss_bits(a, rng_next(r));
+}
+
+/* Varios generadores en paralelo (estado SoA): cada carril es el mismo
+ * xoshiro256** adelantado 2^128 pasos respecto al anterior, así que las
+ * secuencias no se solapan, y el bucle sobre los carriles se vectoriza. */
+#define RNG_LANES 8
+
+typedef struct {
+    uint64_t s[4][RNG_LANES];
+} rng_lanes_t;
+
+extern void rng_lanes_seed(rng_lanes_t *r, uint64_t seed);
+
+/* Llena out con n palabras (n múltiplo de RNG_LANES), carriles intercalados */
+extern void rng_lanes_fill(rng_lanes_t *r, uint64_t *out, size_t n);
+
+/* Adelanta el generador 2^128 pasos */
+extern void rng_jump(rng_t *r);
+
+#endif /* RNG_H */
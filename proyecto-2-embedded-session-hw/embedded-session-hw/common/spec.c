@@ -0,0 +1,45 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "spec.h"
+
+bool spec_fail(char *err, size_t errlen, const char *what, const char *msg) {
+    snprintf(err, errlen, "'%.*s': %s", SPEC_ITEM - 1, what, msg);
+    return false;
+}
+
+bool spec_open(spec_t *s, const char *spec, char *err, size_t errlen) {
+    s->save = NULL;
+    s->started = false;
+    s->item[0] = '\0';
+    if (strlen(spec) >= sizeof(s->buf)) return spec_fail(err, errlen, spec, "especificación demasiado larga");
+    strcpy(s->buf, spec);
+    return true;
+}
+
+char *spec_next(spec_t *s, char sep, char **arg) {
+    char *tok = strtok_r(s->started ? NULL : s->buf, ",", &s->save);
+    s->started = true;
+    if (!tok) return NULL;
+    snprintf(s->item, sizeof(s->item), "%s", tok);
+    *arg = strchr(tok, sep);
+    if (*arg) *(*arg)++ = '\0';
+    return tok;
+}
+
+int spec_values(const spec_t *s, const char *arg, double *a, double *b, char *err, size_t errlen) {
+    char *end;
+    *a = strtod(arg, &end);
+    *b = 0.0;
+    if (end == arg) return spec_fail(err, errlen, s->item, "valor inválido");
+    int n = 1;
+    if (*end == ':') {
+        const char *arg2 = end + 1;
+        *b = strtod(arg2, &end);
+        if (end == arg2) return spec_fail(err, errlen, s->item, "segundo valor inválido");
+        n = 2;
+    }
+    if (*end != '\0') return spec_fail(err, errlen, s->item, "sobran caracteres");
+    return n;
+}
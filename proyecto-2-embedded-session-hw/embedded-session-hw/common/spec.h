@@ -0,0 +1,37 @@
+#ifndef SPEC_H
+#define SPEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Especificaciones de la línea de comandos con la forma
+ * "nombre<sep>valor,nombre<sep>valor,..." (cadena de filtros, señal
+ * sintética, fuente IIO). Se copian a un buffer propio y se recorren
+ * elemento por elemento; los errores dejan "'elemento': mensaje" en err,
+ * con el elemento recortado a SPEC_ITEM - 1 caracteres. */
+
+#define SPEC_MAX  1024          /* Largo máximo de la especificación */
+#define SPEC_ITEM 64            /* Elemento completo que se cita en los mensajes */
+
+typedef struct {
+    char buf[SPEC_MAX];
+    char *save;
+    bool started;
+    char item[SPEC_ITEM];       /* Elemento actual sin partir, para los mensajes */
+} spec_t;
+
+/* Copia spec; false (y mensaje en err) si es demasiado larga */
+extern bool spec_open(spec_t *s, const char *spec, char *err, size_t errlen);
+
+/* Próximo elemento, o NULL al terminar. Devuelve el nombre y deja en *arg
+ * lo que sigue al primer sep (NULL si no hay sep). */
+extern char *spec_next(spec_t *s, char sep, char **arg);
+
+/* Valor numérico "a" o "a:b": retorna cuántos leyó (1 o 2), o 0 con el
+ * mensaje en err */
+extern int spec_values(const spec_t *s, const char *arg, double *a, double *b, char *err, size_t errlen);
+
+/* Deja "'what': msg" en err y retorna false */
+extern bool spec_fail(char *err, size_t errlen, const char *what, const char *msg);
+
+#endif /* SPEC_H */
@@ -0,0 +1,88 @@
+#include <stdlib.h>
+#include <string.h>
+#include "spsc_ring.h"
+
+bool spsc_init(spsc_ring_t *r, size_t elem_size, size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+
+    memset(r, 0, sizeof(*r));
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    r->mask = cap - 1;
+    r->elem_size = elem_size;
+    r->buf = malloc(cap * elem_size);
+    return r->buf != NULL;
+}
+
+void spsc_free(spsc_ring_t *r) {
+    free(r->buf);
+    r->buf = NULL;
+}
+
+bool spsc_push(spsc_ring_t *r, const void *elem) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    if (head - r->tail_cache > r->mask) {
+        /* Aparentemente llena: se refresca la copia del índice del consumidor */
+        r->tail_cache = atomic_load_explicit(&r->tail, memory_order_acquire);
+        if (head - r->tail_cache > r->mask) return false;
+    }
+    memcpy(r->buf + (head & r->mask) * r->elem_size, elem, r->elem_size);
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_pop(spsc_ring_t *r, void *elem) {
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    if (tail == r->head_cache) {
+        r->head_cache = atomic_load_explicit(&r->head, memory_order_acquire);
+        if (tail == r->head_cache) return false;
+    }
+    memcpy(elem, r->buf + (tail & r->mask) * r->elem_size, r->elem_size);
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_push_overwrite(spsc_ring_t *r, const void *elem) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    bool dropped = false;
+
+    if (head - r->tail_cache > r->mask) {
+        r->tail_cache = atomic_load_explicit(&r->tail, memory_order_acquire);
+        if (head - r->tail_cache > r->mask) {
+            /* Llena: se descarta el más viejo. Si el CAS falla, el consumidor
+             * acaba de leer uno y ya hay lugar. El registro se escribe después
+             * del CAS, así que una lectura en curso de esa ranura no podrá
+             * confirmarse. */
+            size_t tail = r->tail_cache;
+            dropped = atomic_compare_exchange_strong_explicit(&r->tail, &tail, tail + 1,
+                                                              memory_order_acq_rel, memory_order_acquire);
+            r->tail_cache = dropped ? tail + 1 : tail;
+        }
+    }
+    memcpy(r->buf + (head & r->mask) * r->elem_size, elem, r->elem_size);
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+    return dropped;
+}
+
+bool spsc_pop_shared(spsc_ring_t *r, void *elem) {
+    for (;;) {
+        size_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+        if (r->head_cache - tail - 1 > r->mask) {
+            /* Vacía según la copia (o el productor descartó más allá de ella) */
+            r->head_cache = atomic_load_explicit(&r->head, memory_order_acquire);
+            if (tail == r->head_cache) return false;
+        }
+        memcpy(elem, r->buf + (tail & r->mask) * r->elem_size, r->elem_size);
+        if (atomic_compare_exchange_strong_explicit(&r->tail, &tail, tail + 1,
+                                                    memory_order_acq_rel, memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+size_t spsc_size(spsc_ring_t *r) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    return head - tail;
+}
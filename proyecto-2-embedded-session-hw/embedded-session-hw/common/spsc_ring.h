@@ -0,0 +1,54 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SPSC_CACHE_LINE 64
+
+/* Cola circular sin locks de un productor y un consumidor, con registros de
+ * tamaño fijo. Cada índice vive en su propia línea de caché y cada lado
+ * guarda una copia del índice del otro, así que solo se lee la variable
+ * compartida cuando la copia indica cola llena o vacía. */
+typedef struct {
+    _Alignas(SPSC_CACHE_LINE) _Atomic size_t head;     /* Próxima escritura (productor) */
+    size_t tail_cache;                                  /* Copia de tail del productor */
+    _Alignas(SPSC_CACHE_LINE) _Atomic size_t tail;     /* Próxima lectura (consumidor) */
+    size_t head_cache;                                  /* Copia de head del consumidor */
+    _Alignas(SPSC_CACHE_LINE) size_t mask;              /* Capacidad - 1 */
+    size_t elem_size;
+    unsigned char *buf;
+} spsc_ring_t;
+
+/* Reserva capacity registros de elem_size bytes (capacity se redondea a
+ * potencia de 2). false si falta memoria. */
+extern bool spsc_init(spsc_ring_t *r, size_t elem_size, size_t capacity);
+
+/* Libera el buffer */
+extern void spsc_free(spsc_ring_t *r);
+
+/* Productor: copia elem; false si la cola está llena (no bloquea) */
+extern bool spsc_push(spsc_ring_t *r, const void *elem);
+
+/* Consumidor: copia el registro más viejo en elem; false si está vacía */
+extern bool spsc_pop(spsc_ring_t *r, void *elem);
+
+/* Productor con política "descartar el más viejo": si la cola está llena
+ * avanza tail con CAS y reemplaza el registro más viejo. Devuelve true si
+ * descartó uno. El consumidor de estas colas debe usar spsc_pop_shared. */
+extern bool spsc_push_overwrite(spsc_ring_t *r, const void *elem);
+
+/* Consumidor de colas con spsc_push_overwrite: confirma la lectura con CAS y
+ * reintenta si el productor descartó ese registro mientras se copiaba */
+extern bool spsc_pop_shared(spsc_ring_t *r, void *elem);
+
+/* Registros en la cola (aproximado si se llama mientras ambos lados trabajan) */
+extern size_t spsc_size(spsc_ring_t *r);
+
+/* Capacidad en registros */
+static inline size_t spsc_capacity(const spsc_ring_t *r) {
+    return r->mask + 1;
+}
+
+#endif /* SPSC_RING_H */
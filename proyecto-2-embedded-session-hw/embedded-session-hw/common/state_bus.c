@@ -0,0 +1,373 @@
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "state_bus.h"
+
+#define BUS_FIFO_PREFIX "/tmp/ctlbus."
+
+static uint32_t round_capacity(size_t capacity) {
+    uint32_t cap = 1;
+    while (cap < capacity && cap < (1u << 24)) cap <<= 1;
+    return cap;
+}
+
+static void bus_setup(state_bus_t *b, bus_ring_t *r, uint32_t cap) {
+    memcpy(r->magic, BUS_SHM_MAGIC, sizeof(r->magic));
+    r->capacity = cap;
+    r->event_size = sizeof(bus_event_t);
+    b->ring = r;
+    b->mask = cap - 1;
+    for (size_t i = 0; i < BUS_MAX_SUBSCRIBERS; i++) b->wfd[i] = -1;
+}
+
+bool state_bus_init(state_bus_t *b, size_t capacity) {
+    uint32_t cap = round_capacity(capacity);
+    size_t bytes = (bus_ring_bytes(cap) + 63) & ~(size_t)63;
+    memset(b, 0, sizeof(*b));
+    bus_ring_t *r = aligned_alloc(64, bytes);
+    if (!r) return false;
+    memset(r, 0, bytes);
+    bus_setup(b, r, cap);
+    return true;
+}
+
+bool state_bus_init_shared(state_bus_t *b, size_t capacity, const char *name) {
+    uint32_t cap = round_capacity(capacity);
+    memset(b, 0, sizeof(*b));
+    if (strlen(name) >= sizeof(b->shm)) return false;
+
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+    if (ftruncate(fd, (off_t)bus_ring_bytes(cap)) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return false;
+    }
+    void *m = mmap(NULL, bus_ring_bytes(cap), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) {
+        shm_unlink(name);
+        return false;
+    }
+    strcpy(b->shm, name);
+    signal(SIGPIPE, SIG_IGN);   /* Aviso a un suscriptor muerto: EPIPE en vez de la señal */
+    bus_setup(b, (bus_ring_t *) m, cap);
+    return true;
+}
+
+void state_bus_free(state_bus_t *b) {
+    if (!b->ring) return;
+    atomic_store(&b->ring->closed, 1);
+    for (size_t i = 0; i < BUS_MAX_SUBSCRIBERS; i++) {
+        if ((b->opened >> i) & 1u) close(b->wfd[i]);
+    }
+    if (b->shm[0]) {
+        munmap(b->ring, bus_ring_bytes(b->ring->capacity));
+        shm_unlink(b->shm);     /* Los suscriptores conectados conservan su mapeo */
+    } else {
+        free(b->ring);
+    }
+    b->ring = NULL;
+}
+
+void state_bus_set_names(state_bus_t *b, const char *const *names, size_t n) {
+    bus_ring_t *r = b->ring;
+    if (n > BUS_MAX_NAMES) n = BUS_MAX_NAMES;
+    for (size_t i = 0; i < n; i++) {
+        strncpy(r->names[i], names[i], BUS_NAME_LEN - 1);
+        r->names[i][BUS_NAME_LEN - 1] = '\0';
+    }
+    r->nnames = (uint32_t)n;
+}
+
+/* Un lugar ocupado cuyo dueño ya no existe (murió sin darse de baja) */
+static bool port_dead(bus_port_t *p, int32_t *pid) {
+    *pid = atomic_load(&p->pid);
+    return *pid > 0 && kill(*pid, 0) != 0 && errno == ESRCH;
+}
+
+/* Ocupa un lugar libre del anillo, o el de un suscriptor muerto (su FIFO
+ * queda en stale, si no es NULL); -1 si están todos en uso */
+static int claim_port(bus_ring_t *r, const char *fifo, char *stale) {
+    uint32_t gen = atomic_fetch_add(&r->gens, 1) + 1;
+    if (gen == 0) gen = atomic_fetch_add(&r->gens, 1) + 1;
+    if (stale) stale[0] = '\0';
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (uint32_t i = 0; i < BUS_MAX_SUBSCRIBERS; i++) {
+            bus_port_t *p = &r->ports[i];
+            uint32_t cur = pass == 0 ? 0 : atomic_load(&p->gen);
+            int32_t pid;
+            /* Segunda vuelta: se anula primero pid, así ningún otro lo da
+             * por muerto después de que cambie de dueño */
+            if (pass == 1 && (cur == 0 || !port_dead(p, &pid) ||
+                              !atomic_compare_exchange_strong(&p->pid, &pid, 0))) continue;
+            if (!atomic_compare_exchange_strong(&p->gen, &cur, gen)) continue;
+
+            /* El publicador lee fifo solo después de ver armed, que se
+             * escribe después */
+            if (stale && pass == 1) memcpy(stale, p->fifo, BUS_FIFO_PATH);
+            strcpy(p->fifo, fifo);
+            atomic_store(&p->armed, 0);
+            atomic_store(&p->pid, (int32_t)getpid());
+            uint32_t n = atomic_load(&r->nports);
+            while (n < i + 1 && !atomic_compare_exchange_weak(&r->nports, &n, i + 1)) {
+            }
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static void release_port(bus_ring_t *r, size_t i) {
+    atomic_store(&r->ports[i].armed, 0);
+    atomic_store(&r->ports[i].pid, 0);
+    atomic_store(&r->ports[i].gen, 0);
+}
+
+static void sub_init(bus_sub_t *s, bus_ring_t *r) {
+    memset(s, 0, sizeof(*s));
+    s->ring = r;
+    s->mask = r->capacity - 1;
+    s->fd = s->wfd = -1;
+}
+
+bool state_bus_subscribe(state_bus_t *b, bus_sub_t *s) {
+    sub_init(s, b->ring);
+    s->bus = b;
+    s->fd = s->wfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (s->fd < 0) {
+        int p[2];
+        if (pipe(p) != 0) return false;
+        for (int i = 0; i < 2; i++) fcntl(p[i], F_SETFL, O_NONBLOCK);
+        s->fd = p[0];
+        s->wfd = p[1];
+    }
+
+    int i = claim_port(b->ring, "", NULL);
+    if (i < 0) {
+        state_bus_unsubscribe(NULL, s);
+        return false;
+    }
+    s->port = (size_t)i;
+    if ((b->opened >> i) & 1u) close(b->wfd[i]);
+    b->opened &= ~((uint64_t)1 << i);
+    b->wfd[i] = s->wfd;
+    b->wgen[i] = atomic_load(&b->ring->ports[i].gen);
+    s->next = atomic_load(&b->ring->head);
+    return true;
+}
+
+void state_bus_unsubscribe(state_bus_t *b, bus_sub_t *s) {
+    if (b && s->fd >= 0) {
+        release_port(b->ring, s->port);
+        b->wfd[s->port] = -1;
+    }
+    if (s->wfd != s->fd) close(s->wfd);
+    close(s->fd);
+    s->fd = s->wfd = -1;
+}
+
+bool state_bus_attach(bus_sub_t *s, const char *name) {
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) return false;
+    bus_ring_t hdr;
+    if (pread(fd, &hdr, offsetof(bus_ring_t, names), 0) != (ssize_t)offsetof(bus_ring_t, names) ||
+        memcmp(hdr.magic, BUS_SHM_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.event_size != sizeof(bus_event_t) || hdr.capacity == 0 ||
+        (hdr.capacity & (hdr.capacity - 1)) != 0) {
+        close(fd);
+        return false;
+    }
+    void *m = mmap(NULL, bus_ring_bytes(hdr.capacity), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) return false;
+    sub_init(s, (bus_ring_t *) m);
+
+    /* FIFO de aviso: se abre también para escribir, así el lado de lectura
+     * nunca ve fin de archivo y el publicador puede abrirlo sin esperar */
+    static _Atomic unsigned attached;
+    char fifo[BUS_FIFO_PATH];
+    char stale[BUS_FIFO_PATH];
+    snprintf(fifo, sizeof(fifo), BUS_FIFO_PREFIX "%ld.%u", (long)getpid(), atomic_fetch_add(&attached, 1));
+    unlink(fifo);
+    if (mkfifo(fifo, 0600) == 0) {
+        s->fd = open(fifo, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        s->wfd = s->fd >= 0 ? open(fifo, O_WRONLY | O_NONBLOCK | O_CLOEXEC) : -1;
+    }
+    int i = s->wfd >= 0 ? claim_port(s->ring, fifo, stale) : -1;
+    if (i < 0) {
+        if (s->wfd >= 0) close(s->wfd);
+        if (s->fd >= 0) close(s->fd);
+        unlink(fifo);
+        munmap(m, bus_ring_bytes(hdr.capacity));
+        return false;
+    }
+    s->port = (size_t)i;
+    s->next = atomic_load(&s->ring->head);
+
+    /* FIFO que dejó un suscriptor muerto: se borra si es uno de los nuestros */
+    struct stat st;
+    if (strnlen(stale, sizeof(stale)) < sizeof(stale) &&
+        strncmp(stale, BUS_FIFO_PREFIX, strlen(BUS_FIFO_PREFIX)) == 0 &&
+        !strchr(stale + strlen(BUS_FIFO_PREFIX), '/') &&
+        lstat(stale, &st) == 0 && S_ISFIFO(st.st_mode)) {
+        unlink(stale);
+    }
+    return true;
+}
+
+void state_bus_detach(bus_sub_t *s) {
+    bus_port_t *p = &s->ring->ports[s->port];
+    unlink(p->fifo);
+    release_port(s->ring, s->port);
+    close(s->wfd);
+    close(s->fd);
+    munmap(s->ring, bus_ring_bytes(s->ring->capacity));
+    s->fd = s->wfd = -1;
+    s->ring = NULL;
+}
+
+/* Descriptor de aviso del lugar i; el FIFO de un suscriptor externo se
+ * abre la primera vez que hay que avisarle */
+static int port_fd(state_bus_t *b, size_t i) {
+    bus_port_t *p = &b->ring->ports[i];
+    uint32_t gen = atomic_load(&p->gen);
+    if (gen == 0) return -1;
+    if (b->wgen[i] == gen && b->wfd[i] >= 0) return b->wfd[i];
+    if ((b->opened >> i) & 1u) close(b->wfd[i]);
+    b->opened &= ~((uint64_t)1 << i);
+    b->wfd[i] = -1;
+    b->wgen[i] = gen;
+
+    /* La ruta la escribió otro proceso: tiene que estar terminada y ser un
+     * FIFO del mismo usuario, nunca un archivo cualquiera */
+    char path[BUS_FIFO_PATH];
+    memcpy(path, p->fifo, sizeof(path));
+    if (!path[0] || strnlen(path, sizeof(path)) == sizeof(path)) return -1;
+    int fd = open(path, O_WRONLY | O_NONBLOCK | O_CLOEXEC | O_NOCTTY | O_NOFOLLOW);
+    struct stat st;
+    if (fd >= 0 && (fstat(fd, &st) != 0 || !S_ISFIFO(st.st_mode) || st.st_uid != geteuid())) {
+        close(fd);
+        fd = -1;
+    }
+    b->wfd[i] = fd;
+    if (fd >= 0) b->opened |= (uint64_t)1 << i;
+    return fd;
+}
+
+void state_bus_publish(state_bus_t *b, const bus_event_t *ev) {
+    bus_ring_t *r = b->ring;
+    uint64_t idx = atomic_load_explicit(&r->head, memory_order_relaxed);
+    bus_slot_t *slot = &r->slots[idx & b->mask];
+
+    /* El lector que copie este lugar mientras se escribe ve seq distinto */
+    atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->ev = *ev;
+    atomic_store_explicit(&slot->seq, idx + 1, memory_order_release);
+
+    /* Dekker con state_bus_wait: allá se escribe armed y se lee head, acá
+     * se escribe head y se lee armed. Las cuatro operaciones son seq_cst;
+     * con una carga relajada de armed, en ARM ambos lados pueden no verse
+     * y el suscriptor dormiría con un evento pendiente. */
+    atomic_store(&r->head, idx + 1);
+
+    /* Avisar solo a los que esperan; el resto verá head al leer */
+    size_t n = atomic_load(&r->nports);
+    for (size_t i = 0; i < n; i++) {
+        bus_port_t *p = &r->ports[i];
+        if (!atomic_load(&p->armed) || !atomic_exchange(&p->armed, 0)) continue;
+        int fd = port_fd(b, i);
+        if (fd < 0) continue;
+        uint64_t one = 1;
+        if (write(fd, &one, sizeof(one)) < 0 && errno == EPIPE) {
+            /* Suscriptor externo muerto sin darse de baja: se libera su
+             * lugar (el FIFO lo borra quien lo ocupe después). pid se anula
+             * antes que gen, como en claim_port. */
+            uint32_t gen = b->wgen[i];
+            int32_t pid = atomic_load(&p->pid);
+            if (atomic_load(&p->gen) == gen) {
+                atomic_compare_exchange_strong(&p->pid, &pid, 0);
+                atomic_compare_exchange_strong(&p->gen, &gen, 0);
+            }
+            continue;
+        }
+        b->wakeups++;           /* Pipe lleno o contador al máximo: ya hay aviso pendiente */
+    }
+}
+
+size_t state_bus_read(bus_sub_t *s, bus_event_t *out, size_t n) {
+    bus_ring_t *r = s->ring;
+    size_t cap = s->mask + 1, got = 0;
+
+    while (got < n) {
+        uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+        if (s->next == head) break;
+        if (head - s->next > cap) {
+            /* El publicador dio la vuelta: se salta a lo más viejo que queda */
+            s->lost += head - s->next - cap;
+            s->next = head - cap;
+        }
+        bus_slot_t *slot = &r->slots[s->next & s->mask];
+        uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        out[got] = slot->ev;
+        atomic_thread_fence(memory_order_acquire);
+        if (seq != s->next + 1 || atomic_load_explicit(&slot->seq, memory_order_relaxed) != seq) {
+            /* Se pisó mientras se copiaba: se pierde y se relee head */
+            s->lost++;
+            s->next++;
+            continue;
+        }
+        s->next++;
+        got++;
+    }
+    return got;
+}
+
+bool state_bus_wait(bus_sub_t *s, int timeout_ms) {
+    bus_ring_t *r = s->ring;
+    bus_port_t *p = &r->ports[s->port];
+
+    /* Armar antes de mirar head: o el publicador ve armed o acá se ve el
+     * evento nuevo */
+    atomic_store(&p->armed, 1);
+    if (atomic_load(&r->head) != s->next) {
+        atomic_store(&p->armed, 0);
+        return true;
+    }
+    struct pollfd pfd = {.fd = s->fd, .events = POLLIN};
+    if (poll(&pfd, 1, timeout_ms) > 0) {
+        uint64_t drain;
+        while (read(s->fd, &drain, sizeof(drain)) > 0) {
+        }
+    }
+    atomic_store(&p->armed, 0);
+    return atomic_load(&r->head) != s->next;
+}
+
+bool state_bus_closed(const bus_sub_t *s) {
+    return atomic_load(&s->ring->closed) != 0;
+}
+
+void state_bus_print(FILE *out, const bus_ring_t *r, const bus_event_t *ev) {
+    if (ev->kind == BUS_CROSSING) {
+        fprintf(out, "[t=%.2f] Sensor=%.2f cruza el umbral hacia %s\n", ev->t, ev->value,
+                ev->changed ? "arriba" : "abajo");
+        return;
+    }
+    fprintf(out, "[t=%.2f] Sensor=%.2f", ev->t, ev->value);
+    for (uint32_t i = 0; i < r->nnames && i < BUS_MAX_NAMES; i++) {
+        fprintf(out, " | %.*s=%s", BUS_NAME_LEN, r->names[i], (ev->states >> i) & 1u ? "ON" : "OFF");
+    }
+    fprintf(out, "\n");
+}
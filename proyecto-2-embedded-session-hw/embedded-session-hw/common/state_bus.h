@@ -0,0 +1,150 @@
+#ifndef STATE_BUS_H
+#define STATE_BUS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* Bus de cambios de estado: un publicador (el bucle de control) y hasta
+ * BUS_MAX_SUBSCRIBERS consumidores (interfaz, logger, puente remoto) en
+ * otros hilos u otros procesos. Solo se publican transiciones de los
+ * actuadores y cruces del umbral; un ciclo sin cambios no publica nada.
+ *
+ * Los eventos van a un anillo de difusión: el publicador nunca espera y
+ * pisa los eventos más viejos; cada suscriptor lee con su propio cursor y
+ * cuenta los que se perdió. Cada suscriptor tiene un descriptor que se
+ * vuelve legible cuando hay eventos, así que puede esperar con poll/epoll
+ * junto a sus otros descriptores: un eventfd (o un pipe) en el mismo
+ * proceso, un FIFO si viene de otro proceso. El publicador solo escribe en
+ * el descriptor de los suscriptores que están esperando.
+ *
+ * Con state_bus_init_shared el anillo vive en memoria compartida (shm_open)
+ * y los procesos externos se suscriben con state_bus_attach. El diseño no
+ * depende del tamaño de puntero, así que ctl32 y ctl64 comparten segmento.
+ * El segmento se crea 0600: solo procesos del mismo usuario se suscriben, y
+ * el publicador solo avisa por FIFOs de ese usuario. */
+
+#define BUS_MAX_SUBSCRIBERS 64
+#define BUS_SHM_MAGIC       "CTLBUS2"
+#define BUS_FIFO_PATH       64      /* Ruta del FIFO de aviso de un suscriptor externo */
+#define BUS_MAX_NAMES       16      /* Un nombre por bit de states */
+#define BUS_NAME_LEN        16
+
+typedef enum {
+    BUS_ACTUATORS = 1,          /* Cambió el estado de algún actuador */
+    BUS_CROSSING  = 2           /* El valor cruzó el umbral */
+} bus_kind_t;
+
+/* Evento de 32 bytes */
+typedef struct {
+    double t;                   /* Reloj del controlador */
+    double value;               /* Valor que vio la lógica */
+    uint32_t seq;               /* Número de muestra */
+    uint16_t kind;
+    uint16_t states;            /* Estado de los actuadores (bit i = actuador i) */
+    uint16_t changed;           /* BUS_ACTUATORS: bits que cambiaron; BUS_CROSSING: 1 = hacia arriba */
+    uint16_t reserved[3];
+} bus_event_t;
+
+typedef struct {
+    _Alignas(8) _Atomic uint64_t seq;   /* Índice + 1 del evento guardado (0 = escribiéndose) */
+    bus_event_t ev;
+} bus_slot_t;
+
+/* Lugar de un suscriptor dentro del anillo */
+typedef struct {
+    _Atomic uint32_t gen;       /* 0 = libre; si no, número del alta que lo ocupa */
+    _Atomic uint32_t armed;     /* El suscriptor espera: hay que avisarle */
+    _Atomic int32_t pid;        /* Proceso del suscriptor (0 = sin anotar) */
+    char fifo[BUS_FIFO_PATH];   /* Suscriptor externo: FIFO de aviso ("" = mismo proceso) */
+} bus_port_t;
+
+/* Anillo: en el heap, o en un segmento de memoria compartida */
+typedef struct {
+    char magic[8];
+    uint32_t capacity;          /* Potencia de 2 */
+    uint32_t event_size;        /* sizeof(bus_event_t) */
+    uint32_t nnames;
+    char names[BUS_MAX_NAMES][BUS_NAME_LEN];    /* Nombre del actuador de cada bit */
+    _Atomic uint32_t closed;    /* El publicador terminó */
+    _Atomic uint32_t gens;      /* Último número de alta */
+    _Atomic uint32_t nports;    /* Lugares en uso alguna vez (cota del recorrido) */
+    _Alignas(64) _Atomic uint64_t head;     /* Eventos publicados */
+    _Alignas(64) bus_port_t ports[BUS_MAX_SUBSCRIBERS];
+    _Alignas(64) bus_slot_t slots[];
+} bus_ring_t;
+
+/* Bytes que ocupa un anillo de capacity eventos */
+static inline size_t bus_ring_bytes(uint32_t capacity) {
+    return sizeof(bus_ring_t) + (size_t)capacity * sizeof(bus_slot_t);
+}
+
+/* Lado del publicador */
+typedef struct state_bus {
+    bus_ring_t *ring;
+    size_t mask;                /* Capacidad - 1 */
+    char shm[64];               /* Nombre del segmento ("" = anillo en el heap) */
+    unsigned long wakeups;      /* Avisos escritos (solo el publicador) */
+    int wfd[BUS_MAX_SUBSCRIBERS];           /* Descriptor de aviso de cada lugar (-1 = ninguno) */
+    uint32_t wgen[BUS_MAX_SUBSCRIBERS];     /* Alta para la que vale wfd */
+    uint64_t opened;            /* Lugares cuyo wfd abrió el publicador (FIFO externo) */
+} state_bus_t;
+
+typedef struct {
+    bus_ring_t *ring;
+    size_t mask;
+    state_bus_t *bus;           /* Mismo proceso; NULL si se conectó con state_bus_attach */
+    size_t port;                /* Lugar en ring->ports */
+    int fd;                     /* Legible cuando hay eventos nuevos */
+    int wfd;                    /* eventfd: el mismo fd; pipe o FIFO: el lado de escritura */
+    uint64_t next;              /* Próximo evento a leer */
+    unsigned long lost;         /* Eventos pisados antes de leerlos */
+} bus_sub_t;
+
+/* Anillo de capacity eventos (se redondea a potencia de 2) en el heap */
+extern bool state_bus_init(state_bus_t *b, size_t capacity);
+
+/* Igual, en el segmento de memoria compartida name (se crea o se recrea).
+ * Ignora SIGPIPE: si un suscriptor externo muere, su lugar se libera al
+ * fallar el aviso. */
+extern bool state_bus_init_shared(state_bus_t *b, size_t capacity, const char *name);
+
+/* Cierra el bus (los suscriptores externos lo ven en state_bus_closed) y
+ * libera el anillo; un segmento compartido se borra */
+extern void state_bus_free(state_bus_t *b);
+
+/* Nombres de los actuadores para los suscriptores (hasta BUS_MAX_NAMES) */
+extern void state_bus_set_names(state_bus_t *b, const char *const *names, size_t n);
+
+/* Alta de un suscriptor del mismo proceso; recibe solo los eventos
+ * publicados desde ahora. Las altas y bajas no pueden cruzarse con
+ * state_bus_publish. */
+extern bool state_bus_subscribe(state_bus_t *b, bus_sub_t *s);
+extern void state_bus_unsubscribe(state_bus_t *b, bus_sub_t *s);
+
+/* Alta de un suscriptor de otro proceso en el segmento name; a diferencia
+ * de state_bus_subscribe, puede hacerse mientras el publicador publica.
+ * Si no hay lugar libre, recupera el de un suscriptor cuyo proceso ya no
+ * existe (mismo espacio de PIDs) */
+extern bool state_bus_attach(bus_sub_t *s, const char *name);
+extern void state_bus_detach(bus_sub_t *s);
+
+/* Publicador: copia el evento al anillo y avisa a quien espera */
+extern void state_bus_publish(state_bus_t *b, const bus_event_t *ev);
+
+/* Suscriptor: copia hasta n eventos pendientes sin bloquear */
+extern size_t state_bus_read(bus_sub_t *s, bus_event_t *out, size_t n);
+
+/* Suscriptor: espera hasta timeout_ms (-1 = sin límite) a que haya eventos;
+ * true si los hay */
+extern bool state_bus_wait(bus_sub_t *s, int timeout_ms);
+
+/* Suscriptor: el publicador cerró el bus */
+extern bool state_bus_closed(const bus_sub_t *s);
+
+/* Una línea por evento, con los nombres que dejó el publicador */
+extern void state_bus_print(FILE *out, const bus_ring_t *r, const bus_event_t *ev);
+
+#endif /* STATE_BUS_H */
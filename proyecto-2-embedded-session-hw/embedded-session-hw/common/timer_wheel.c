@@ -0,0 +1,113 @@
+#include <string.h>
+#include "timer_wheel.h"
+
+#define TW_MASK (TW_SLOTS - 1)
+
+static void unlink_timer(tw_timer_t *t) {
+    *t->pprev = t->next;
+    if (t->next) t->next->pprev = t->pprev;
+    t->next = NULL;
+    t->pprev = NULL;
+}
+
+static void push(tw_timer_t **head, tw_timer_t *t) {
+    t->next = *head;
+    if (*head) (*head)->pprev = &t->next;
+    *head = t;
+    t->pprev = head;
+}
+
+/* Ranura según la distancia al vencimiento: el nivel l guarda los timers
+ * que vencen dentro de menos de 2^(8(l+1)) ticks */
+static void add(timer_wheel_t *w, tw_timer_t *t) {
+    uint64_t delta;
+    unsigned level = 0;
+
+    if (t->expires < w->now) t->expires = w->now;   /* Vencido: ranura del tick actual */
+    delta = t->expires - w->now;
+    while (level < TW_LEVELS - 1 && delta >= ((uint64_t)1 << (TW_SLOT_BITS * (level + 1)))) level++;
+
+    /* Más allá de la rueda: queda en el último nivel y se reubica al volver
+     * a pasar por su ranura */
+    unsigned idx = (unsigned)(t->expires >> (TW_SLOT_BITS * level)) & TW_MASK;
+    if (delta >= ((uint64_t)1 << (TW_SLOT_BITS * TW_LEVELS))) {
+        idx = (unsigned)((w->now >> (TW_SLOT_BITS * level)) - 1) & TW_MASK;
+    }
+    push(&w->slots[level][idx], t);
+}
+
+/* Redistribuye la ranura actual del nivel l en los niveles inferiores */
+static void cascade(timer_wheel_t *w, unsigned level) {
+    unsigned idx = (unsigned)(w->now >> (TW_SLOT_BITS * level)) & TW_MASK;
+    tw_timer_t *list = w->slots[level][idx];
+
+    w->slots[level][idx] = NULL;
+    if (list) list->pprev = &list;
+    while (list) {
+        tw_timer_t *t = list;
+        unlink_timer(t);
+        add(w, t);
+    }
+}
+
+void tw_init(timer_wheel_t *w, uint64_t now) {
+    memset(w, 0, sizeof(*w));
+    w->now = now;
+}
+
+void tw_timer_init(tw_timer_t *t, tw_callback fn, void *arg) {
+    memset(t, 0, sizeof(*t));
+    t->fn = fn;
+    t->arg = arg;
+}
+
+void tw_schedule(timer_wheel_t *w, tw_timer_t *t, uint64_t delay, uint64_t period) {
+    if (tw_pending(t)) unlink_timer(t);
+    else w->pending++;
+    t->expires = w->now + (delay ? delay : 1);
+    t->period = period;
+    add(w, t);
+}
+
+void tw_cancel(timer_wheel_t *w, tw_timer_t *t) {
+    if (!tw_pending(t)) return;
+    unlink_timer(t);
+    w->pending--;
+}
+
+size_t tw_advance(timer_wheel_t *w, uint64_t now) {
+    size_t fired = 0;
+
+    while (w->now < now) {
+        if (w->pending == 0) {
+            w->now = now;                   /* Nada pendiente: saltar directo */
+            break;
+        }
+        w->now++;
+
+        /* Al completar una vuelta de un nivel se baja la ranura del siguiente */
+        for (unsigned level = 1; level < TW_LEVELS; level++) {
+            if ((w->now >> (TW_SLOT_BITS * (level - 1))) & TW_MASK) break;
+            cascade(w, level);
+        }
+
+        /* Se separa la ranura antes de ejecutar: los callbacks pueden
+         * cancelar o programar otros timers sin romper el recorrido */
+        tw_timer_t *list = w->slots[0][w->now & TW_MASK];
+        w->slots[0][w->now & TW_MASK] = NULL;
+        if (list) list->pprev = &list;
+        while (list) {
+            tw_timer_t *t = list;
+            unlink_timer(t);
+            if (t->period) {
+                t->expires += t->period;
+                add(w, t);
+            } else {
+                w->pending--;
+            }
+            t->fn(t, t->arg);
+            fired++;
+        }
+    }
+    return fired;
+}
@@ -0,0 +1,59 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Rueda de timers jerárquica: 4 niveles de 256 ranuras, cubre 2^32 ticks.
+ * Programar y cancelar son O(1); al avanzar solo se visita la ranura del
+ * tick actual (y, cada 256 ticks, se redistribuye una ranura del nivel
+ * superior), así que no hay recorrido lineal de los timers pendientes.
+ * La unidad del tick la decide quien llama (por ejemplo 1 ms). */
+#define TW_LEVELS     4
+#define TW_SLOT_BITS  8
+#define TW_SLOTS      (1u << TW_SLOT_BITS)
+
+typedef struct tw_timer tw_timer_t;
+typedef void (*tw_callback)(tw_timer_t *timer, void *arg);
+
+/* Timer intrusivo: lo reserva quien lo usa (sin memoria dinámica) */
+struct tw_timer {
+    tw_timer_t *next;
+    tw_timer_t **pprev;         /* NULL si no está pendiente */
+    uint64_t expires;           /* Tick de vencimiento */
+    uint64_t period;            /* 0 = una vez; si no, se reprograma solo */
+    tw_callback fn;
+    void *arg;
+};
+
+typedef struct {
+    uint64_t now;               /* Último tick procesado */
+    size_t pending;             /* Timers programados */
+    tw_timer_t *slots[TW_LEVELS][TW_SLOTS];
+} timer_wheel_t;
+
+/* Inicializa la rueda vacía en el tick now */
+extern void tw_init(timer_wheel_t *w, uint64_t now);
+
+/* Prepara un timer con su callback (no lo programa) */
+extern void tw_timer_init(tw_timer_t *t, tw_callback fn, void *arg);
+
+/* Programa t para dentro de delay ticks (mínimo 1) y, si period > 0, cada
+ * period ticks a partir de ahí. Si ya estaba pendiente se reprograma. */
+extern void tw_schedule(timer_wheel_t *w, tw_timer_t *t, uint64_t delay, uint64_t period);
+
+/* Cancela t si estaba pendiente (también desde dentro de un callback) */
+extern void tw_cancel(timer_wheel_t *w, tw_timer_t *t);
+
+/* true si t está programado */
+static inline bool tw_pending(const tw_timer_t *t) {
+    return t->pprev != NULL;
+}
+
+/* Avanza hasta el tick now ejecutando los callbacks vencidos en orden de
+ * tick. Los periódicos se reprograman antes de llamar al callback, así que
+ * el callback puede cancelarlos. Devuelve cuántos callbacks se llamaron. */
+extern size_t tw_advance(timer_wheel_t *w, uint64_t now);
+
+#endif /* TIMER_WHEEL_H */
@@ -0,0 +1,192 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include "work_steal.h"
+
+#define WS_MASK (WS_DEQUE_CAPACITY - 1)
+
+static inline uint64_t pack(size_t begin, size_t end) {
+    return (uint64_t)begin << 32 | (uint32_t)end;
+}
+
+static inline void unpack(uint64_t v, size_t *begin, size_t *end) {
+    *begin = (size_t)(v >> 32);
+    *end = (size_t)(uint32_t)v;
+}
+
+/* Dueño: agrega un rango abajo; false si la deque está llena */
+static bool deque_push(ws_deque_t *d, uint64_t v) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= WS_DEQUE_CAPACITY) return false;
+    atomic_store_explicit(&d->items[b & WS_MASK], v, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return true;
+}
+
+/* Dueño: saca el rango de abajo; compite con los ladrones solo por el último */
+static bool deque_take(ws_deque_t *d, uint64_t *v) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {                                    /* Vacía */
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return false;
+    }
+    *v = atomic_load_explicit(&d->items[b & WS_MASK], memory_order_relaxed);
+    if (t == b) {
+        bool won = atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                           memory_order_relaxed);
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+/* Ladrón: saca el rango de arriba; false si está vacía o perdió la carrera */
+static bool deque_steal(ws_deque_t *d, uint64_t *v) {
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return false;
+    *v = atomic_load_explicit(&d->items[t & WS_MASK], memory_order_relaxed);
+    return atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1, memory_order_seq_cst,
+                                                   memory_order_relaxed);
+}
+
+typedef struct ws_pool ws_pool_t;
+
+typedef struct {
+    ws_pool_t *pool;
+    unsigned id;
+    uint32_t rng;               /* Elección de víctimas */
+    pthread_t thread;
+    ws_worker_stats_t stats;
+} ws_worker_t;
+
+struct ws_pool {
+    ws_deque_t *deques;
+    ws_worker_t *workers;
+    unsigned nthreads;
+    size_t grain;
+    ws_range_fn fn;
+    void *ctx;
+    _Atomic size_t remaining;   /* Índices sin procesar */
+};
+
+/* Parte el rango mientras sea más grande que grain, dejando las mitades
+ * altas en la deque propia, y procesa lo que queda */
+static void run_range(ws_worker_t *w, size_t begin, size_t end) {
+    ws_pool_t *p = w->pool;
+    ws_deque_t *d = &p->deques[w->id];
+
+    while (end - begin > p->grain) {
+        size_t mid = begin + (end - begin) / 2;
+        if (!deque_push(d, pack(mid, end))) break;      /* Llena: se procesa entero */
+        end = mid;
+    }
+    p->fn(p->ctx, begin, end, w->id);
+    w->stats.ranges++;
+    w->stats.items += end - begin;
+    atomic_fetch_sub_explicit(&p->remaining, end - begin, memory_order_release);
+}
+
+/* Busca trabajo en las demás deques empezando por una víctima al azar */
+static bool steal_any(ws_worker_t *w, uint64_t *v) {
+    ws_pool_t *p = w->pool;
+    w->rng ^= w->rng << 13;
+    w->rng ^= w->rng >> 17;
+    w->rng ^= w->rng << 5;
+    unsigned start = w->rng % p->nthreads;
+    for (unsigned k = 0; k < p->nthreads; k++) {
+        unsigned victim = (start + k) % p->nthreads;
+        if (victim == w->id) continue;
+        if (deque_steal(&p->deques[victim], v)) {
+            w->stats.steals++;
+            return true;
+        }
+        w->stats.failed++;
+    }
+    return false;
+}
+
+static void *worker_main(void *arg) {
+    ws_worker_t *w = arg;
+    ws_pool_t *p = w->pool;
+    uint64_t v;
+    size_t begin, end;
+
+    for (;;) {
+        if (deque_take(&p->deques[w->id], &v) || steal_any(w, &v)) {
+            unpack(v, &begin, &end);
+            run_range(w, begin, end);
+            continue;
+        }
+        if (atomic_load_explicit(&p->remaining, memory_order_acquire) == 0) break;
+        sched_yield();
+    }
+    return NULL;
+}
+
+bool ws_parallel_for(size_t n, size_t grain, unsigned nthreads,
+                     ws_range_fn fn, void *ctx, ws_worker_stats_t *stats) {
+    ws_pool_t p;
+    bool ok = true;
+
+    if (n == 0) return true;
+    if (n > UINT32_MAX) return false;
+    if (nthreads == 0) nthreads = 1;
+    if (nthreads > WS_MAX_THREADS) nthreads = WS_MAX_THREADS;
+    if (grain == 0) grain = 1;
+
+    p.deques = aligned_alloc(64, nthreads * sizeof(ws_deque_t));
+    p.workers = calloc(nthreads, sizeof(ws_worker_t));
+    if (!p.deques || !p.workers) {
+        free(p.deques);
+        free(p.workers);
+        return false;
+    }
+    p.nthreads = nthreads;
+    p.grain = grain;
+    p.fn = fn;
+    p.ctx = ctx;
+    atomic_init(&p.remaining, n);
+
+    /* Reparto inicial en bloques contiguos; el robo corrige el desbalance.
+     * Los primeros n % nthreads bloques llevan uno más (sin n * i, que
+     * desborda size_t en 32 bits) */
+    size_t chunk = n / nthreads, extra = n % nthreads;
+    for (unsigned i = 0; i < nthreads; i++) {
+        ws_deque_t *d = &p.deques[i];
+        atomic_init(&d->top, 0);
+        atomic_init(&d->bottom, 0);
+        size_t begin = i * chunk + (i < extra ? i : extra);
+        size_t end = begin + chunk + (i < extra);
+        if (end > begin) deque_push(d, pack(begin, end));
+        p.workers[i].pool = &p;
+        p.workers[i].id = i;
+        p.workers[i].rng = 2463534242u + 97u * i;
+    }
+
+    unsigned started = 1;
+    for (; started < nthreads; started++) {
+        if (pthread_create(&p.workers[started].thread, NULL, worker_main, &p.workers[started]) != 0) {
+            ok = false;         /* Los hilos que sí arrancaron terminan el trabajo */
+            break;
+        }
+    }
+    worker_main(&p.workers[0]);
+    for (unsigned i = 1; i < started; i++) pthread_join(p.workers[i].thread, NULL);
+
+    if (stats) {
+        for (unsigned i = 0; i < nthreads; i++) stats[i] = p.workers[i].stats;
+    }
+    free(p.deques);
+    free(p.workers);
+    return ok;
+}
@@ -0,0 +1,44 @@
+#ifndef WORK_STEAL_H
+#define WORK_STEAL_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Reparto de trabajo con robo (work stealing) para bucles paralelos sobre
+ * rangos de índices. Cada hilo tiene una deque de Chase-Lev: el dueño empuja
+ * y saca por abajo sin locks (LIFO, lo más caliente en caché) y los demás
+ * roban por arriba con un CAS (FIFO, los rangos más grandes). Un rango más
+ * grande que grain se parte a la mitad: una mitad queda en la deque para
+ * quien la quiera y la otra se sigue partiendo. */
+
+#define WS_DEQUE_CAPACITY 1024  /* Rangos pendientes por hilo (potencia de 2) */
+#define WS_MAX_THREADS    256
+
+/* Deque de Chase-Lev de capacidad fija; cada rango va empacado en 64 bits
+ * (begin en la parte alta) para que el robo lea el registro de una vez */
+typedef struct {
+    _Alignas(64) _Atomic int64_t top;       /* Extremo de los ladrones */
+    _Alignas(64) _Atomic int64_t bottom;    /* Extremo del dueño */
+    _Atomic uint64_t items[WS_DEQUE_CAPACITY];
+} ws_deque_t;
+
+/* Trabajo de un rango [begin, end) en el hilo worker */
+typedef void (*ws_range_fn)(void *ctx, size_t begin, size_t end, unsigned worker);
+
+/* Contadores por hilo */
+typedef struct {
+    unsigned long ranges;       /* Rangos ejecutados */
+    unsigned long steals;       /* Robos exitosos */
+    unsigned long failed;       /* Intentos de robo sin éxito */
+    size_t items;               /* Índices procesados */
+} ws_worker_stats_t;
+
+/* Ejecuta fn sobre [0, n) con nthreads hilos (el que llama es el hilo 0) y
+ * rangos de a lo sumo grain índices. stats (opcional) recibe nthreads
+ * entradas. false si no se pudieron crear los hilos. */
+extern bool ws_parallel_for(size_t n, size_t grain, unsigned nthreads,
+                            ws_range_fn fn, void *ctx, ws_worker_stats_t *stats);
+
+#endif /* WORK_STEAL_H */
@@ -1,86 +1,940 @@
 #define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>   /* usleep */
+#include "../sensor/filter.h"
 #include "../sensor/sensor.h"
 #include "../actuators/actuator.h"
+#include "../common/event_log.h"
+#include "../common/hist.h"
+#include "../common/state_bus.h"
+#include "ctl_logic.h"
+#include "rt.h"
+#include "rules.h"
+#include "trace.h"
+#ifdef CTL_PIPELINE
+#include "pipeline.h"
+#endif
 
-/* Prototipos de las fábricas de actuadores */
-Actuator create_led_actuator(void);
-Actuator create_buzzer_actuator(void);
+/* Capacidad de la cola del log de eventos (registros de 24 bytes) */
+#define LOG_QUEUE 65536
 
-/* Tiempo monotónico (segundos con decimales) */
-static double now(void) {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return ts.tv_sec + ts.tv_nsec / 1e9;
+/* Capacidad del anillo del bus de cambios (eventos de 32 bytes) */
+#define BUS_QUEUE 4096
+
+/* Muestras que se drenan de la fuente por llamada */
+#define SENSOR_BATCH 64
+
+/* Lo que comparten los bucles de control */
+typedef struct {
+    Sensor sensor;
+    ctl_state_t ctl;            /* Umbral fijo (sin --rules) */
+    Actuator led;
+    Actuator buzzer;
+    rules_t *rules;             /* Reglas de --rules, o NULL */
+    filter_chain_t *filter;     /* Filtros de --filter, o NULL */
+    event_log_t *log;           /* Log de eventos de --log, o NULL */
+    trace_writer_t *trace;      /* Traza de --record, o NULL */
+    state_bus_t *bus;           /* Bus de cambios de --changes, o NULL */
+    uint16_t published;         /* Último estado publicado en el bus */
+    bool above;                 /* El último valor publicado estaba sobre el umbral */
+    uint32_t seq;               /* Muestras vistas por el bus */
+    arena_t arena;              /* Instancias del sensor y los actuadores */
+} controller_t;
+
+/* Señales: SIGUSR1 pide volcar los histogramas de tiempo real y
+ * SIGINT/SIGTERM terminan el bucle (el trabajo se hace fuera del handler) */
+static volatile sig_atomic_t rt_dump = 0;
+static volatile sig_atomic_t rt_stop = 0;
+
+static void on_rt_signal(int sig) {
+    if (sig == SIGUSR1) rt_dump = 1;
+    else rt_stop = 1;
+}
+
+static void install_signals(void) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_rt_signal;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGUSR1, &sa, NULL);
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+}
+
+/* Estado de los actuadores como máscara (bit i = actuador i del log) */
+static uint16_t actuator_states(const controller_t *c) {
+    uint16_t states = 0;
+    if (c->rules) {
+        for (size_t i = 0; i < c->rules->nactuators && i < EVLOG_MAX_ACTUATORS; i++) {
+            const Actuator *a = &c->rules->actuators[i];
+            states |= (uint16_t)(a->status(a->params) << i);
+        }
+    } else {
+        states = (uint16_t)(c->led.status(c->led.params) | (c->buzzer.status(c->buzzer.params) << 1));
+    }
+    return states;
+}
+
+/* Publica en el bus lo que cambió con esta muestra: el cruce del umbral
+ * (solo con umbral fijo) y la transición de los actuadores. Sin cambios no
+ * hace nada más que dos comparaciones. */
+static void publish_changes(controller_t *c, double t, double val, uint16_t states) {
+    bus_event_t ev = {.t = t, .value = val, .seq = c->seq++, .states = states};
+
+    if (!c->rules) {
+        bool above = val >= c->ctl.threshold;
+        if (above != c->above) {
+            ev.kind = BUS_CROSSING;
+            ev.changed = above;
+            state_bus_publish(c->bus, &ev);
+            c->above = above;
+        }
+    }
+    if (states != c->published) {
+        ev.kind = BUS_ACTUATORS;
+        ev.changed = (uint16_t)(states ^ c->published);
+        state_bus_publish(c->bus, &ev);
+        c->published = states;
+    }
+}
+
+/* Lee hasta n muestras; las fuentes finitas (CSV) vuelven a empezar al final */
+static size_t read_wrapping(Sensor *s, sensor_sample_t *buf, size_t n) {
+    size_t got = s->read_batch(s->params, buf, n);
+    if (got == 0 && s->eof(s->params)) {
+        s->reset(s->params);
+        got = s->read_batch(s->params, buf, n);
+    }
+    return got;
+}
+
+/* Espera datos de una fuente en vivo: poll sobre su descriptor o, si no
+ * tiene (memoria compartida), una pausa corta */
+static void wait_for_data(Sensor *s, int timeout_ms) {
+    int fd = s->fd(s->params);
+    if (fd >= 0) {
+        struct pollfd pfd = {.fd = fd, .events = POLLIN};
+        poll(&pfd, 1, timeout_ms);
+    } else {
+        struct timespec pause = {0, 1000000};
+        nanosleep(&pause, NULL);
+    }
+}
+
+/* Filtros y lógica (umbral fijo o reglas) de una muestra; devuelve el valor
+ * filtrado, que es el que ve el controlador */
+static double control_logic(controller_t *c, double t, double val) {
+    Actuator *led = &c->led, *buzzer = &c->buzzer;
+
+    if (c->filter) val = filter_chain_apply(c->filter, val);
+
+    if (c->rules) {
+        rules_eval(c->rules, t, &val);
+    } else {
+        /* Aplicar las acciones del paso en el mismo orden que antes */
+        unsigned actions = ctl_step(&c->ctl, t, val);
+        if (actions & CTL_LED_ACTIVATE) led->activate(led->params);
+        if (actions & CTL_BUZZER_ACTIVATE) buzzer->activate(buzzer->params);
+        if (actions & CTL_BUZZER_DEACTIVATE) buzzer->deactivate(buzzer->params);
+        if (actions & CTL_LED_DEACTIVATE) led->deactivate(led->params);
+    }
+    return val;
+}
+
+/* Un paso del bucle de muestreo: lógica, traza y log de estado */
+static void control_sample(controller_t *c, double t, double raw) {
+    Actuator *led = &c->led, *buzzer = &c->buzzer;
+    rules_t *rules = c->rules;
+
+    double val = control_logic(c, t, raw);
+    uint16_t states = c->trace || c->log || c->bus ? actuator_states(c) : 0;
+    if (c->trace) trace_sample(c->trace, t, raw, states);
+    if (c->bus) publish_changes(c, t, val, states);
+
+    if (c->log) {
+        event_log_sample(c->log, t, val, states);
+    } else if (c->bus) {
+        /* Solo cambios: los imprime el suscriptor */
+    } else if (rules) {
+        /* Log de estado con los actuadores de las reglas */
+        printf("[t=%.2f] Sensor=%.2f", t, val);
+        for (size_t i = 0; i < rules->nactuators; i++) {
+            Actuator *a = &rules->actuators[i];
+            printf(" | %s=%s", rules->names[i], a->status(a->params) ? "ON" : "OFF");
+        }
+        printf("\n");
+    } else {
+        /* Log de estado */
+        printf("[t=%.2f] Sensor=%.2f | LED=%s | BUZZER=%s\n",
+               t, val,
+               led->status(led->params) ? "ON" : "OFF",
+               buzzer->status(buzzer->params) ? "ON" : "OFF");
+    }
+}
+
+/* Reloj del bucle de muestreo. En replay y con fuentes en vivo, t es el
+ * tiempo de los datos relativo a la primera muestra, así los apagados
+ * diferidos (1 s / 5 s) siguen el reloj de los datos sin importar la
+ * velocidad. Si no, una muestra cada 100 ms con el reloj monotónico. */
+typedef struct {
+    Sensor *sensor;
+    bool replay;
+    bool live;
+    double speed;               /* Multiplicador de velocidad; 0 = sin pausas */
+    double wall_start;
+    double data_start;
+    double t_last;
+    unsigned long samples;
+} sampler_t;
+
+/* Siguiente lote de hasta n muestras con t en el reloj del controlador,
+ * esperando lo que corresponda; 0 al terminar los datos o con SIGINT */
+static size_t sampler_next(sampler_t *s, sensor_sample_t *buf, size_t n) {
+    Sensor *sensor = s->sensor;
+    size_t got;
+
+    if (!s->replay && !s->live) {
+        if (s->samples++ > 0) {
+            /* Esperar 100 ms */
+            struct timespec delay = {0, 100000000}; /* 100ms = 100,000,000 ns */
+            nanosleep(&delay, NULL);
+        }
+        if (rt_stop) return 0;
+        got = read_wrapping(sensor, buf, 1);
+        buf[0].t = rt_now_ns() / 1e9;
+        return got;
+    }
+
+    if (s->speed > 0.0 && !s->live) n = 1;     /* Cada muestra espera su instante */
+    for (;;) {
+        if (rt_stop) return 0;
+        got = sensor->read_batch(sensor->params, buf, n);
+        if (got > 0) break;
+        if (!s->live) return 0;                 /* Fin de los datos */
+        wait_for_data(sensor, 100);
+    }
+    for (size_t i = 0; i < got; i++) {
+        if (s->samples++ == 0) s->data_start = buf[i].t;
+        double t = buf[i].t - s->data_start;
+        if (t < s->t_last) t = s->t_last;       /* El reloj nunca retrocede */
+        buf[i].t = s->t_last = t;
+    }
+    if (s->speed > 0.0 && !s->live) rt_sleep_until_ns((uint64_t)((s->wall_start + buf[0].t / s->speed) * 1e9));
+    return got;
+}
+
+static void rt_report(const hist_t *wake, const hist_t *exec, unsigned long overruns) {
+    fprintf(stderr, "=== HISTOGRAMAS RT ===\n");
+    hist_print(wake, stderr, 1000.0, "us");
+    hist_print(exec, stderr, 1000.0, "us");
+    fprintf(stderr, "Ciclos perdidos: %lu\n", overruns);
+}
+
+/* Bucle de tiempo real: plazos absolutos sobre CLOCK_MONOTONIC, sin log por
+ * ciclo y con la misma lógica que el bucle normal (control_logic); los
+ * actuadores no imprimen (ver main) y los cambios salen por --log o
+ * --changes, desde otro hilo. Mide la latencia de despertar (despertar -
+ * plazo) y el tiempo de ejecución. Las fuentes en vivo se drenan en cada
+ * ciclo; las demás dan una muestra. */
+static void run_rt(const rt_config_t *cfg, double duration, controller_t *c) {
+    static hist_t wake, exec;       /* 16 KB cada uno: fuera del stack */
+    unsigned long overruns = 0;
+    sensor_sample_t buf[SENSOR_BATCH];
+
+    install_signals();
+
+    hist_init(&wake, "despertar");
+    hist_init(&exec, "ejecucion");
+    rt_setup(cfg);
+
+    uint64_t start = rt_now_ns();
+    uint64_t end = duration > 0.0 ? start + (uint64_t)(duration * 1e9) : UINT64_MAX;
+    uint64_t next = start + cfg->period_ns;
+
+    while (!rt_stop && next < end) {
+        rt_sleep_until_ns(next);
+        uint64_t woke = rt_now_ns();
+
+        size_t n = c->sensor.live ? c->sensor.read_batch(c->sensor.params, buf, SENSOR_BATCH)
+                                  : read_wrapping(&c->sensor, buf, 1);
+        for (size_t i = 0; i < n; i++) {
+            double val = control_logic(c, woke / 1e9, buf[i].value);
+            uint16_t states = c->trace || c->log || c->bus ? actuator_states(c) : 0;
+            if (c->trace) trace_sample(c->trace, woke / 1e9, buf[i].value, states);
+            if (c->log) event_log_sample(c->log, woke / 1e9, val, states);
+            if (c->bus) publish_changes(c, woke / 1e9, val, states);
+        }
+
+        uint64_t done = rt_now_ns();
+        hist_record(&wake, woke - next);
+        hist_record(&exec, done - woke);
+
+        /* Próximo plazo; si el ciclo se pasó, se saltan los plazos perdidos
+         * en vez de encadenar despertares atrasados */
+        next += cfg->period_ns;
+        if (done >= next) {
+            uint64_t missed = (done - next) / cfg->period_ns + 1;
+            overruns += missed;
+            next += missed * cfg->period_ns;
+        }
+
+        if (rt_dump) {
+            rt_dump = 0;
+            rt_report(&wake, &exec, overruns);
+        }
+    }
+
+    rt_report(&wake, &exec, overruns);
+}
+
+#ifdef CTL_PIPELINE
+/* Capacidad de cada cola de la tubería */
+#define PIPE_QUEUE 4096
+
+/* Actuador sombra: las reglas corren en el hilo de control y solo dejan el
+ * estado deseado en una máscara; los actuadores reales quedan para el hilo
+ * de actuación */
+typedef struct {
+    uint16_t *mask;
+    uint16_t bit;
+} shadow_actuator_t;
+
+static void shadow_on(void *params) {
+    shadow_actuator_t *s = params;
+    *s->mask |= s->bit;
+}
+
+static void shadow_off(void *params) {
+    shadow_actuator_t *s = params;
+    *s->mask &= (uint16_t)~s->bit;
+}
+
+static bool shadow_status(void *params) {
+    shadow_actuator_t *s = params;
+    return (*s->mask & s->bit) != 0;
+}
+
+typedef struct {
+    controller_t *c;
+    sampler_t *sampler;
+    pipeline_t *pipe;
+    uint16_t shadow;                                    /* Hilo de control */
+    shadow_actuator_t bits[EVLOG_MAX_ACTUATORS];
+    Actuator real[EVLOG_MAX_ACTUATORS];                 /* Hilo de actuación */
+} pipe_ctx_t;
+
+static size_t pipe_acquire(void *ctx, sensor_sample_t *buf, size_t n) {
+    pipe_ctx_t *pc = ctx;
+    if (rt_dump) {
+        rt_dump = 0;
+        pipeline_report(pc->pipe, stderr);
+    }
+    return sampler_next(pc->sampler, buf, n);
+}
+
+static uint16_t pipe_control(void *ctx, double t, double *value) {
+    pipe_ctx_t *pc = ctx;
+    controller_t *c = pc->c;
+    double raw = *value;
+    uint16_t states;
+    if (c->filter) *value = filter_chain_apply(c->filter, *value);
+    if (c->rules) {
+        rules_eval(c->rules, t, value);
+        states = pc->shadow;
+    } else {
+        ctl_step(&c->ctl, t, *value);
+        states = (uint16_t)(c->ctl.led_on | (c->ctl.buzzer_on << 1));
+    }
+    if (c->trace) trace_sample(c->trace, t, raw, states);   /* El estado que decidió la lógica */
+    return states;
+}
+
+/* Aplica solo los cambios de estado y escribe el log con el estado aplicado */
+static void pipe_actuate(void *ctx, const pipe_item_t *item, uint16_t changed) {
+    pipe_ctx_t *pc = ctx;
+    controller_t *c = pc->c;
+    size_t nact = c->rules ? c->rules->nactuators : 2;
+
+    for (size_t i = 0; i < nact; i++) {
+        if (!((changed >> i) & 1u)) continue;
+        Actuator *a = c->rules ? &pc->real[i] : i == 0 ? &c->led : &c->buzzer;
+        if ((item->states >> i) & 1u) a->activate(a->params);
+        else a->deactivate(a->params);
+    }
+
+    if (c->bus) publish_changes(c, item->t, item->value, item->states);
+    if (c->log) {
+        event_log_sample(c->log, item->t, item->value, item->states);
+        return;
+    }
+    if (c->bus) return;
+    printf("[t=%.2f] Sensor=%.2f", item->t, item->value);
+    for (size_t i = 0; i < nact; i++) {
+        printf(" | %s=%s", c->rules ? c->rules->names[i] : i == 0 ? "LED" : "BUZZER",
+               (item->states >> i) & 1u ? "ON" : "OFF");
+    }
+    printf("\n");
+}
+
+/* Modo en tubería; false si no se pudo armar (se sigue en modo serie) */
+static bool run_pipeline(controller_t *c, sampler_t *smp, pipe_policy_t policy) {
+    static pipeline_t pipe;     /* Histogramas de 16 KB: fuera del stack */
+    static pipe_ctx_t pc;
+    rules_t *rules = c->rules;
+
+    if (rules && rules->nactuators > EVLOG_MAX_ACTUATORS) {
+        fprintf(stderr, "[CTL] La tubería admite hasta %d actuadores; se sigue en modo serie\n",
+                EVLOG_MAX_ACTUATORS);
+        return false;
+    }
+    pipeline_config_t cfg = {pipe_acquire, pipe_control, pipe_actuate, &pc, policy, PIPE_QUEUE};
+    if (!pipeline_init(&pipe, &cfg)) {
+        fprintf(stderr, "[CTL] No se pudo crear la tubería; se sigue en modo serie\n");
+        return false;
+    }
+    memset(&pc, 0, sizeof(pc));
+    pc.c = c;
+    pc.sampler = smp;
+    pc.pipe = &pipe;
+    for (size_t i = 0; rules && i < rules->nactuators; i++) {
+        pc.real[i] = rules->actuators[i];
+        pc.bits[i].mask = &pc.shadow;
+        pc.bits[i].bit = (uint16_t)(1u << i);
+        Actuator shadow = {&pc.bits[i], shadow_on, shadow_off, shadow_status};
+        rules->actuators[i] = shadow;
+    }
+
+    bool ok = pipeline_run(&pipe);
+    fflush(stdout);
+    pipeline_report(&pipe, stderr);
+
+    for (size_t i = 0; rules && i < rules->nactuators; i++) rules->actuators[i] = pc.real[i];
+    pipeline_free(&pipe);
+    return ok;
+}
+#endif /* CTL_PIPELINE */
+
+/* Divergencias que se detallan al repetir una traza */
+#define TRACE_REPORT 10
+
+static void print_states(const trace_header_t *h, uint16_t states) {
+    for (uint32_t i = 0; i < h->nactuators; i++) {
+        printf(" %.*s=%s", EVLOG_NAME_MAX, h->names[i], (states >> i) & 1u ? "ON" : "OFF");
+    }
+}
+
+/* Comparación de la traza grabada con la repetida */
+typedef struct {
+    uint16_t recorded;          /* Estado grabado después de la última entrada */
+    uint16_t replayed;          /* Estado de la repetición */
+    bool differing;             /* La muestra anterior ya difería */
+    unsigned long samples;
+    unsigned long diverged;     /* Muestras con estado distinto */
+    unsigned long onsets;       /* Tramos de muestras distintas */
+    unsigned long rec_edges;
+    unsigned long rep_edges;
+    double t_first;             /* Reloj de la lógica en la primera entrada */
+    trace_record_t last;        /* Última entrada repetida */
+} trace_diff_t;
+
+static void trace_compare(trace_diff_t *d, const trace_header_t *h) {
+    bool differs = d->recorded != d->replayed;
+    if (differs) {
+        d->diverged++;
+        if (!d->differing && d->onsets++ < TRACE_REPORT) {
+            printf("[TRACE] Difiere desde la muestra %u (t=%.3f): grabado", d->last.seq, d->last.t);
+            print_states(h, d->recorded);
+            printf(" | repetido");
+            print_states(h, d->replayed);
+            printf("\n");
+        }
+    }
+    d->differing = differs;
+}
+
+/* Repite una traza de --record: las entradas pasan por la misma lógica en
+ * tiempo virtual (sin pausas ni salida por muestra) y el estado de los
+ * actuadores se compara muestra a muestra con el grabado. Las reglas y los
+ * filtros salen de la traza salvo que se den --rules o --filter.
+ * Retorna 0 si coincide, 2 si difiere y 1 si hubo un error. */
+static int replay_trace(const char *path, const char *rules_path, const char *filter_spec) {
+    static rules_t rules_storage;
+    static filter_chain_t filter_storage;
+    static trace_record_t buf[4096];
+    trace_reader_t tr;
+    controller_t c;
+    char err[256];
+
+    if (!trace_reader_open(&tr, path, err, sizeof(err))) {
+        fprintf(stderr, "[TRACE] Error: %s\n", err);
+        return 1;
+    }
+    const trace_header_t *h = &tr.header;
+    memset(&c, 0, sizeof(c));
+    arena_init(&c.arena, 0);
+
+    bool ok = true;
+    if (rules_path) ok = rules_load(&rules_storage, rules_path, err, sizeof(err));
+    else if (tr.rules_text) ok = rules_parse(&rules_storage, tr.rules_text, err, sizeof(err));
+    if (!ok) {
+        fprintf(stderr, "[TRACE] Error en las reglas: %s\n", err);
+        trace_reader_close(&tr);
+        return 1;
+    }
+    if (rules_path || tr.rules_text) c.rules = &rules_storage;
+
+    bool fixed = filter_spec ? FILTER_DEFAULT_FIXED : h->fixed;
+    if (!filter_spec && h->filter[0]) filter_spec = h->filter;
+    if (filter_spec) {
+        if (!filter_chain_parse(&filter_storage, filter_spec, fixed, err, sizeof(err))) {
+            fprintf(stderr, "[TRACE] Error en --filter %s\n", err);
+            if (c.rules) rules_free(c.rules);
+            trace_reader_close(&tr);
+            return 1;
+        }
+        c.filter = &filter_storage;
+    }
+    c.led = create_led_actuator(&c.arena);
+    c.buzzer = create_buzzer_actuator(&c.arena);
+    ctl_init(&c.ctl, h->threshold);
+    actuator_set_quiet(true);
+
+    printf("=== REPETICIÓN DE TRAZA ===\n");
+    printf("Traza: %s (%s", path, c.rules ? "reglas" : "umbral fijo");
+    if (c.filter) printf(", filtros %s", filter_spec);
+    printf(")\n");
+
+    /* El registro de transición de la muestra s viene después de su entrada,
+     * así que cada muestra se compara al llegar la siguiente (o al final) */
+    trace_diff_t d;
+    memset(&d, 0, sizeof(d));
+    double wall_start = rt_now_ns() / 1e9;
+    size_t n;
+    while ((n = trace_read(&tr, buf, sizeof(buf) / sizeof(buf[0]))) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            const trace_record_t *rec = &buf[i];
+            if (rec->kind == TRACE_OUTPUT) {
+                d.recorded = rec->states;
+                d.rec_edges++;
+                continue;
+            }
+            if (d.samples > 0) trace_compare(&d, h);
+            else d.t_first = rec->t;
+            uint16_t before = d.replayed;
+            control_logic(&c, rec->t, rec->value);
+            d.replayed = actuator_states(&c);
+            if (d.replayed != before) d.rep_edges++;
+            d.last = *rec;
+            d.samples++;
+        }
+    }
+    if (d.samples > 0) trace_compare(&d, h);
+    double wall = rt_now_ns() / 1e9 - wall_start;
+    double span = d.last.t - d.t_first;
+
+    printf("%lu muestras, %lu transiciones grabadas y %lu repetidas\n", d.samples, d.rec_edges, d.rep_edges);
+    printf("%.2f s de datos (grabados en %.3f s) repetidos en %.3f s (x%.0f)\n",
+           span, d.last.mono_ns / 1e9, wall, wall > 0.0 ? span / wall : 0.0);
+    if (d.diverged) printf("=== DIFIERE: %lu muestras en %lu tramos ===\n", d.diverged, d.onsets);
+    else printf("=== COINCIDE ===\n");
+
+    trace_reader_close(&tr);
+    if (c.rules) rules_free(c.rules);
+    arena_free(&c.arena);
+    return d.diverged ? 2 : 0;
+}
+
+/* Suscriptor de --changes: imprime los eventos del bus desde su hilo */
+typedef struct {
+    bus_sub_t sub;
+    atomic_bool stop;
+    unsigned long events;
+    pthread_t thread;
+} change_printer_t;
+
+static void *change_printer(void *arg) {
+    change_printer_t *p = arg;
+    bus_event_t ev[64];
+
+    for (;;) {
+        bool stopping = atomic_load(&p->stop);
+        size_t n = state_bus_read(&p->sub, ev, sizeof(ev) / sizeof(ev[0]));
+        for (size_t i = 0; i < n; i++) state_bus_print(stdout, p->sub.ring, &ev[i]);
+        p->events += n;
+        if (n == 0) {
+            if (stopping) break;
+            fflush(stdout);
+            state_bus_wait(&p->sub, 100);
+        }
+    }
+    fflush(stdout);
+    return NULL;
+}
+
+/* Detiene el suscriptor después de que vacíe el bus */
+static void stop_changes(change_printer_t *p, state_bus_t *bus) {
+    atomic_store(&p->stop, true);
+    pthread_join(p->thread, NULL);
+    fprintf(stderr, "[CTL] Cambios: %lu eventos publicados, %lu impresos, %lu perdidos, %lu avisos\n",
+            (unsigned long)atomic_load(&bus->ring->head), p->events, p->sub.lost, bus->wakeups);
+    state_bus_unsubscribe(bus, &p->sub);
+    state_bus_free(bus);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [--rules archivo] [--log archivo] [--record traza]\n"
+            "        [--changes | --bus /nombre] [--source F | [--stream] archivo.csv]\n"
+            "        [--speed X | --afap | --rt [opciones RT]]\n"
+            "     %s [--rules archivo] [--filter F] --replay-trace traza\n"
+            "  --source F      Fuente del sensor: random, csv:ruta, stream:ruta, fifo:ruta,\n"
+            "                  unix:ruta, shm:/nombre (las tres últimas reciben datos en vivo)\n"
+            "                  o synth:parámetros (señal sintética, p. ej. synth:noise=5,sin=20:60)\n"
+            "                  o iio:parámetros (Linux IIO, p. ej. iio:dev=0,chan=voltage0[,buffer=256])\n"
+            "  --rules F       Reglas desde el archivo F en vez del umbral fijo (ver config/default.rules)\n"
+            "  --filter F      Cadena de filtros antes del controlador, p. ej. median:5,ewma:0.2\n"
+            "                  (avg:N, median:N, ewma:ALFA, kalman:Q:R; en punto fijo en ctl32)\n"
+            "  --log F         Log de eventos binario en F (\"-\" = texto por stdout, en un hilo aparte)\n"
+            "  --record F      Traza binaria en F: cada entrada del sensor y cada transición\n"
+            "  --changes       Imprimir solo los cambios (transiciones y cruces del umbral) desde\n"
+            "                  un suscriptor del bus de estado, en vez de una línea por muestra\n"
+            "  --bus /NOMBRE   Como --changes, con el bus en la memoria compartida /NOMBRE para\n"
+            "                  suscriptores de otros procesos (ctl_watch64 /NOMBRE)\n"
+            "  --replay-trace F  Repetir la traza F en tiempo virtual y comparar los actuadores\n"
+            "                  (con --rules/--filter, contra otra configuración); sale con 2 si difiere\n"
+#ifdef CTL_PIPELINE
+            "  --pipeline P    Adquisición, control y actuación en tres hilos; P = block (esperar)\n"
+            "                  o drop (descartar el más viejo si una cola se llena)\n"
+#endif
+            "Opciones RT:\n"
+            "  --period-us N   Período del bucle en µs (por defecto 100000)\n"
+            "  --prio N        Prioridad SCHED_FIFO (1-99)\n"
+            "  --cpu N         Fijar el proceso a la CPU N\n"
+            "  --mlock         Bloquear la memoria (mlockall)\n"
+            "  --duration S    Terminar después de S segundos\n",
+            prog, prog);
 }
 
 int main(int argc, char *argv[]) {
-    /* Umbral fijo para este ejemplo */
+    /* Umbral fijo si no se da --rules */
     const double THRESHOLD = 50.0;
 
-    /* Inicializar sensor según argumentos */
-    if (argc > 1) {
+    /* Inicializar sensor según argumentos: [--stream] [--speed X | --afap] [archivo.csv] */
+    const char *csv_path = NULL;
+    bool stream = false;
+    bool replay = false;        /* Usar los timestamps del sensor como reloj */
+    double speed = 0.0;         /* Multiplicador de velocidad; 0 = sin pausas */
+    bool rt = false;            /* Modo de tiempo real */
+    rt_config_t rt_cfg = {100000000ull, 0, -1, false};
+    double duration = 0.0;
+    const char *rules_path = NULL;
+    const char *log_path = NULL;
+    const char *source = NULL;
+    const char *filter_spec = NULL;
+    const char *record_path = NULL;
+    const char *trace_path = NULL;
+    bool changes = false;       /* Solo cambios, por el bus de estado */
+    const char *bus_name = NULL;    /* Bus en memoria compartida (--bus) */
+#ifdef CTL_PIPELINE
+    bool pipelined = false;
+    pipe_policy_t policy = PIPE_BLOCK;
+#endif
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rules") == 0 && i + 1 < argc) {
+            rules_path = argv[++i];
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            log_path = argv[++i];
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter_spec = argv[++i];
+        } else if (strcmp(argv[i], "--source") == 0 && i + 1 < argc) {
+            source = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay-trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--changes") == 0) {
+            changes = true;
+        } else if (strcmp(argv[i], "--bus") == 0 && i + 1 < argc) {
+            bus_name = argv[++i];
+            changes = true;
+#ifdef CTL_PIPELINE
+        } else if (strcmp(argv[i], "--pipeline") == 0 && i + 1 < argc) {
+            pipelined = true;
+            i++;
+            if (strcmp(argv[i], "drop") == 0) {
+                policy = PIPE_DROP_OLDEST;
+            } else if (strcmp(argv[i], "block") != 0) {
+                usage(argv[0]);
+                return 1;
+            }
+#endif
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            stream = true;      /* Leer el CSV sin cargarlo completo en memoria */
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            speed = atof(argv[++i]);
+            replay = true;
+            if (speed <= 0.0) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--afap") == 0) {
+            speed = 0.0;        /* Lo más rápido posible, en tiempo virtual */
+            replay = true;
+        } else if (strcmp(argv[i], "--rt") == 0) {
+            rt = true;
+        } else if (strcmp(argv[i], "--period-us") == 0 && i + 1 < argc) {
+            rt_cfg.period_ns = strtoull(argv[++i], NULL, 10) * 1000ull;
+        } else if (strcmp(argv[i], "--prio") == 0 && i + 1 < argc) {
+            rt_cfg.priority = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            rt_cfg.cpu = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--mlock") == 0) {
+            rt_cfg.lock_memory = true;
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            duration = atof(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            csv_path = argv[i];
+        }
+    }
+    if ((rt && replay) || rt_cfg.period_ns == 0 || (source && csv_path)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (trace_path) {
+        /* Solo la lógica: sin fuente, pausas ni salidas */
+        if (source || csv_path || replay || rt || log_path || record_path || changes) {
+            usage(argv[0]);
+            return 1;
+        }
+        return replay_trace(trace_path, rules_path, filter_spec);
+    }
+#ifdef CTL_PIPELINE
+    if (pipelined && rt) {
+        usage(argv[0]);
+        return 1;
+    }
+#endif
+
+    /* Reglas: un solo canal, el del sensor */
+    static rules_t rules_storage;
+    controller_t c;
+    memset(&c, 0, sizeof(c));
+    arena_init(&c.arena, 0);
+    if (rules_path) {
+        char err[256];
+        if (!rules_load(&rules_storage, rules_path, err, sizeof(err))) {
+            fprintf(stderr, "[CTL] Error en %s: %s\n", rules_path, err);
+            return 1;
+        }
+        if (rules_storage.channels > 1) {
+            fprintf(stderr, "[CTL] Error: las reglas usan %zu canales y el sensor tiene 1\n",
+                    rules_storage.channels);
+            rules_free(&rules_storage);
+            return 1;
+        }
+        c.rules = &rules_storage;
+    }
+    rules_t *rules = c.rules;
+
+    static filter_chain_t filter_storage;
+    if (filter_spec) {
+        char err[256];
+        if (!filter_chain_parse(&filter_storage, filter_spec, FILTER_DEFAULT_FIXED, err, sizeof(err))) {
+            fprintf(stderr, "[CTL] Error en --filter %s\n", err);
+            if (rules) rules_free(rules);
+            return 1;
+        }
+        c.filter = &filter_storage;
+    }
+
+    if (source) {
+        c.sensor = create_sensor_from_spec(&c.arena, source);
+    } else if (csv_path) {
         /* Usar archivo CSV si se proporciona */
-        sensor_init_csv(argv[1]);
-    } else {
+        c.sensor = create_csv_sensor(&c.arena, csv_path, stream);
+        if (!c.sensor.params) printf("[SENSOR] Error al cargar CSV, cambiando a modo aleatorio\n");
+    }
+    if (!c.sensor.params && !source) {
         /* Usar modo aleatorio por defecto */
-        sensor_init();
+        c.sensor = create_random_sensor(&c.arena);
+    }
+    if (!c.sensor.params) {
+        if (rules) rules_free(rules);
+        arena_free(&c.arena);
+        return 1;
     }
+    Sensor *sensor = &c.sensor;
+    bool live = sensor->live;   /* Los datos llegan solos: se espera con poll */
+    printf("[SENSOR] Inicializado en modo %s\n", sensor->name);
 
     /* Crear actuadores */
-    Actuator led = create_led_actuator();
-    Actuator buzzer = create_buzzer_actuator();
+    c.led = create_led_actuator(&c.arena);
+    c.buzzer = create_buzzer_actuator(&c.arena);
 
-    /* Variables para tiempos de apagado diferido */
-    double led_off_time = 0.0;
-    double buzzer_off_time = 0.0;
+    /* Estado del controlador (umbral y apagados diferidos) */
+    ctl_init(&c.ctl, THRESHOLD);
 
-    printf("=== CONTROLADOR INICIADO ===\n");
-    printf("Modo del sensor: %s\n", 
-           sensor_get_mode() == SENSOR_MODE_RANDOM ? "ALEATORIO" : "CSV");
-
-    /* Bucle infinito de muestreo cada 100 ms */
-    while (1) {
-        double t = now();
-        double val = sensor_read();
-
-        if (val >= THRESHOLD) {
-            /* Si supera el umbral, encender de inmediato y cancelar apagados */
-            led.activate(led.params);
-            buzzer.activate(buzzer.params);
-            led_off_time = 0.0;
-            buzzer_off_time = 0.0;
-        } else {
-            /* Si no supera el umbral, programar apagados diferidos */
-            if (buzzer_off_time == 0.0) buzzer_off_time = t + 1.0; /* 1 s */
-            if (led_off_time == 0.0) led_off_time = t + 5.0;       /* 5 s */
+    /* Log de eventos: reemplaza el printf por iteración y los mensajes de
+     * los actuadores; SIGINT termina el bucle para vaciar la cola */
+    const char *names[EVLOG_MAX_ACTUATORS] = {"LED", "BUZZER"};
+    size_t nnames = 2;
+    if (rules) {
+        nnames = rules->nactuators < EVLOG_MAX_ACTUATORS ? rules->nactuators : EVLOG_MAX_ACTUATORS;
+        for (size_t i = 0; i < nnames; i++) names[i] = rules->names[i];
+    }
+    static event_log_t log_storage;
+    if (log_path) {
+        if (!event_log_open(&log_storage, log_path, LOG_QUEUE, names, nnames)) {
+            fprintf(stderr, "[CTL] Error: No se pudo abrir el log %s\n", log_path);
+            sensor->close(sensor->params);
+            if (rules) rules_free(rules);
+            arena_free(&c.arena);
+            return 1;
         }
+        c.log = &log_storage;
+        actuator_set_quiet(true);
+        install_signals();
+    }
 
-        /* Revisar si ya se cumplió el tiempo para apagar */
-        if (buzzer_off_time > 0.0 && t >= buzzer_off_time) {
-            buzzer.deactivate(buzzer.params);
-            buzzer_off_time = 0.0;
+    /* Traza completa para repetir la corrida con --replay-trace; guarda
+     * también la configuración de la lógica */
+    static trace_writer_t trace_storage;
+    if (record_path) {
+        char err[256];
+        bool fits = !filter_spec || strlen(filter_spec) < TRACE_SPEC_MAX;
+        if (!fits) {
+            fprintf(stderr, "[CTL] Error: --filter demasiado largo para la traza (máximo %d caracteres)\n",
+                    TRACE_SPEC_MAX - 1);
+        }
+        char *text = fits && rules_path ? rules_read_file(rules_path, err, sizeof(err)) : NULL;
+        bool opened = fits && (!rules_path || text) &&
+                      trace_open(&trace_storage, record_path, THRESHOLD, filter_spec,
+                                 c.filter && c.filter->fixed, text, names, nnames);
+        free(text);
+        if (!opened) {
+            if (fits) fprintf(stderr, "[CTL] Error: No se pudo crear la traza %s\n", record_path);
+            if (c.log) event_log_close(c.log);
+            sensor->close(sensor->params);
+            if (rules) rules_free(rules);
+            arena_free(&c.arena);
+            return 1;
         }
+        c.trace = &trace_storage;
+        install_signals();      /* SIGINT termina el bucle y cierra la traza */
+    }
 
-        if (led_off_time > 0.0 && t >= led_off_time) {
-            led.deactivate(led.params);
-            led_off_time = 0.0;
+    /* Bus de cambios: el bucle publica solo transiciones y cruces, y un
+     * suscriptor en otro hilo los imprime; con --bus, otros procesos también
+     * se suscriben */
+    static state_bus_t bus_storage;
+    static change_printer_t printer;
+    if (changes) {
+        bool ok = bus_name ? state_bus_init_shared(&bus_storage, BUS_QUEUE, bus_name)
+                           : state_bus_init(&bus_storage, BUS_QUEUE);
+        if (ok) state_bus_set_names(&bus_storage, names, nnames);
+        if (ok && !state_bus_subscribe(&bus_storage, &printer.sub)) {
+            state_bus_free(&bus_storage);
+            ok = false;
         }
+        if (ok && pthread_create(&printer.thread, NULL, change_printer, &printer) != 0) {
+            state_bus_unsubscribe(&bus_storage, &printer.sub);
+            state_bus_free(&bus_storage);
+            ok = false;
+        }
+        if (!ok) {
+            fprintf(stderr, "[CTL] Error: No se pudo crear el bus de cambios\n");
+            if (c.log) event_log_close(c.log);
+            if (c.trace) trace_close(c.trace);
+            sensor->close(sensor->params);
+            if (rules) rules_free(rules);
+            arena_free(&c.arena);
+            return 1;
+        }
+        c.bus = &bus_storage;
+        actuator_set_quiet(true);   /* Los mensajes de los actuadores saldrían de otro hilo */
+    }
+    if (live) install_signals();    /* SIGINT cierra la fuente (socket, shm) */
+    if (bus_name) install_signals();    /* SIGINT borra el segmento y avisa a los suscriptores */
+#ifdef CTL_PIPELINE
+    if (pipelined) install_signals();   /* SIGUSR1 vuelca los contadores de la tubería */
+#endif
 
-        /* Log de estado */
-        printf("[t=%.2f] Sensor=%.2f | LED=%s | BUZZER=%s\n",
-               t, val,
-               led.status(led.params) ? "ON" : "OFF",
-               buzzer.status(buzzer.params) ? "ON" : "OFF");
+    printf("=== CONTROLADOR INICIADO ===\n");
+    printf("Modo del sensor: %s\n", sensor->name);
+    if (c.filter) {
+        printf("Filtros: %s (%s)\n", filter_spec, c.filter->fixed ? "punto fijo Q15" : "double");
+    }
+    if (rules) {
+        printf("Reglas: %zu de %s (%zu actuadores)\n", rules->nrules, rules_path, rules->nactuators);
+    }
+    if (c.trace) printf("Grabando traza en %s\n", record_path);
+    if (c.bus && bus_name) printf("Salida: solo cambios (bus de estado en %s)\n", bus_name);
+    else if (c.bus) printf("Salida: solo cambios (bus de estado)\n");
+#ifdef CTL_PIPELINE
+    if (pipelined) {
+        printf("Tubería de tres hilos: colas de %d registros, %s\n", PIPE_QUEUE,
+               policy == PIPE_BLOCK ? "esperar si se llenan" : "descartar el más viejo");
+    }
+#endif
+    if (replay) {
+        if (speed > 0.0) printf("Replay con timestamps: velocidad x%g\n", speed);
+        else printf("Replay con timestamps: lo más rápido posible (tiempo virtual)\n");
+    }
+    if (rt) {
+        actuator_set_quiet(true);   /* Sin printf dentro del ciclo */
+        printf("Tiempo real: período %.3f ms, SCHED_FIFO %d, CPU %d, mlock %s\n",
+               rt_cfg.period_ns / 1e6, rt_cfg.priority, rt_cfg.cpu, rt_cfg.lock_memory ? "sí" : "no");
+        printf("Enviar SIGUSR1 (kill -USR1 %ld) para volcar los histogramas\n", (long)getpid());
+        fflush(stdout);
+        run_rt(&rt_cfg, duration, &c);
+        if (c.bus) stop_changes(&printer, c.bus);
+        if (c.log) event_log_close(c.log);
+        if (c.trace) trace_close(c.trace);
+        sensor->close(sensor->params);
+        if (rules) rules_free(rules);
+        arena_free(&c.arena);
+        return 0;
+    }
+
+    sampler_t smp = {sensor, replay, live, speed, rt_now_ns() / 1e9, 0.0, 0.0, 0};
+    bool done = false;
+#ifdef CTL_PIPELINE
+    if (pipelined) done = run_pipeline(&c, &smp, policy);
+#endif
+    if (!done) {
+        /* Bucle de muestreo: cada 100 ms, según los timestamps en replay, o
+         * drenando las ráfagas que lleguen de una fuente en vivo */
+        sensor_sample_t buf[SENSOR_BATCH];
+        size_t n;
+        while ((n = sampler_next(&smp, buf, SENSOR_BATCH)) > 0) {
+            for (size_t i = 0; i < n && !rt_stop; i++) control_sample(&c, buf[i].t, buf[i].value);
+        }
+    }
 
-        /* Esperar 100 ms */
-        struct timespec delay = {0, 100000000}; /* 100ms = 100,000,000 ns */
-        nanosleep(&delay, NULL);
+    if (c.bus) stop_changes(&printer, c.bus);
+    if (c.log) event_log_close(c.log);
+    if (c.trace) trace_close(c.trace);
+    sensor->close(sensor->params);
+    if (replay || live) {
+        double wall = rt_now_ns() / 1e9 - smp.wall_start;
+        printf(replay ? "=== REPLAY TERMINADO ===\n" : "=== FUENTE EN VIVO TERMINADA ===\n");
+        printf("%lu muestras, %.2f s de datos en %.3f s reales (x%.1f)\n",
+               smp.samples, smp.t_last, wall, wall > 0.0 ? smp.t_last / wall : 0.0);
     }
+    if (rules) rules_free(rules);
+    arena_free(&c.arena);           /* Sensor y actuadores de una vez */
 
     return 0;
 }
@@ -0,0 +1,265 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../sensor/csv.h"
+#include "../sensor/frame.h"
+#include "ctl_logic.h"
+#include "rt.h"
+
+/* Evaluador offline: corre ctl_step sobre un CSV completo sin dormir ni
+ * imprimir por muestra. Solo se emiten las transiciones de los actuadores. */
+
+/* Resultado de evaluar un umbral sobre todo el archivo */
+typedef struct {
+    size_t led_transitions;
+    size_t buzzer_transitions;
+    size_t led_on_samples;      /* Muestras con el LED encendido */
+    double seconds;             /* Tiempo de evaluación */
+} batch_result_t;
+
+/* Mismo reloj que el replay de ctl: relativo a la primera fila y monotónico */
+static void normalize_times(double *ts, size_t n) {
+    double start = n ? ts[0] : 0.0;
+    double last = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double t = ts[i] - start;
+        if (t < last) t = last;
+        ts[i] = last = t;
+    }
+}
+
+static batch_result_t run(const double *ts, const double *values, size_t n,
+                          double threshold, FILE *timeline) {
+    batch_result_t r = {0, 0, 0, 0.0};
+    ctl_state_t s;
+    ctl_init(&s, threshold);
+
+    double t0 = rt_now_ns() / 1e9;
+    for (size_t i = 0; i < n; i++) {
+        bool led = s.led_on, buzzer = s.buzzer_on;
+        ctl_step(&s, ts[i], values[i]);
+        if (s.led_on != led) {
+            r.led_transitions++;
+            if (timeline) fprintf(timeline, "%.3f LED %s\n", ts[i], s.led_on ? "ON" : "OFF");
+        }
+        if (s.buzzer_on != buzzer) {
+            r.buzzer_transitions++;
+            if (timeline) fprintf(timeline, "%.3f BUZZER %s\n", ts[i], s.buzzer_on ? "ON" : "OFF");
+        }
+        r.led_on_samples += s.led_on;
+    }
+    r.seconds = rt_now_ns() / 1e9 - t0;
+    return r;
+}
+
+/* Filas por bloque en modo multicanal: la máscara de un bloque
+ * (canales x filas bytes) queda en caché entre el umbral y los pasos */
+#define MULTI_BLOCK 4096
+
+/* Evento de la línea de tiempo multicanal */
+typedef struct {
+    size_t row;
+    size_t channel;
+    unsigned changed;
+    bool led_on;
+    bool buzzer_on;
+} multi_event_t;
+
+typedef struct {
+    multi_event_t *events;
+    size_t count;
+    size_t cap;
+} multi_timeline_t;
+
+static void collect_event(void *ctx, size_t row, size_t channel,
+                          unsigned changed, const ctl_state_t *s) {
+    multi_timeline_t *tl = ctx;
+    if (tl->count == tl->cap) {
+        size_t cap = tl->cap ? tl->cap * 2 : 256;
+        multi_event_t *bigger = realloc(tl->events, cap * sizeof(*bigger));
+        if (!bigger) return;
+        tl->events = bigger;
+        tl->cap = cap;
+    }
+    tl->events[tl->count++] = (multi_event_t){row, channel, changed, s->led_on, s->buzzer_on};
+}
+
+/* Orden por fila y luego por canal (cada par es único) */
+static int event_cmp(const void *a, const void *b) {
+    const multi_event_t *x = a, *y = b;
+    if (x->row != y->row) return x->row < y->row ? -1 : 1;
+    return (x->channel > y->channel) - (x->channel < y->channel);
+}
+
+/* Evalúa todos los canales de un frame por bloques: primero el kernel de
+ * umbral (vectorizable, por columnas) y luego el paso de cada canal */
+static int run_multi(const char *path, const double *thresholds, size_t nthresholds) {
+    sensor_frame_t f;
+    double t0 = rt_now_ns() / 1e9;
+    if (!frame_load_csv(&f, path)) {
+        fprintf(stderr, "[BATCH] Error: No se pudo cargar %s como frames multicanal\n", path);
+        return 1;
+    }
+    double load = rt_now_ns() / 1e9 - t0;
+    normalize_times(f.ts, f.rows);
+    fprintf(stderr, "[BATCH] %zu filas x %zu canales cargadas en %.3f s (%.2f s de datos)\n",
+            f.rows, f.channels, load, f.rows ? f.ts[f.rows - 1] : 0.0);
+
+    /* Umbral por canal: si se dieron menos, el último se repite */
+    double *th = malloc(f.channels * sizeof(double));
+    ctl_state_t *states = malloc(f.channels * sizeof(ctl_state_t));
+    uint8_t *above = malloc(f.channels * MULTI_BLOCK);
+    if (!th || !states || !above) {
+        fprintf(stderr, "[BATCH] Error: Sin memoria\n");
+        free(th);
+        free(states);
+        free(above);
+        frame_free(&f);
+        return 1;
+    }
+    for (size_t c = 0; c < f.channels; c++) {
+        th[c] = thresholds[c < nthresholds ? c : nthresholds - 1];
+        ctl_init(&states[c], th[c]);
+    }
+
+    static char buf[1 << 16];
+    setvbuf(stdout, buf, _IOFBF, sizeof(buf));
+    multi_timeline_t tl = {NULL, 0, 0};
+    size_t transitions = 0;
+    double eval = 0.0;
+    for (size_t row0 = 0; row0 < f.rows; row0 += MULTI_BLOCK) {
+        size_t n = f.rows - row0 < MULTI_BLOCK ? f.rows - row0 : MULTI_BLOCK;
+        double b0 = rt_now_ns() / 1e9;
+        frame_threshold(&f, row0, n, th, above);
+        tl.count = 0;
+        for (size_t c = 0; c < f.channels; c++) {
+            transitions += ctl_run_channel(&states[c], c, row0, n, f.ts, above + c * n,
+                                           collect_event, &tl);
+        }
+        eval += rt_now_ns() / 1e9 - b0;
+
+        /* Las transiciones salen por canal; se ordenan por tiempo para imprimir */
+        qsort(tl.events, tl.count, sizeof(*tl.events), event_cmp);
+        for (size_t i = 0; i < tl.count; i++) {
+            const multi_event_t *e = &tl.events[i];
+            if (e->changed & CTL_CHANGED_LED) {
+                printf("%.3f ch%zu LED %s\n", f.ts[e->row], e->channel, e->led_on ? "ON" : "OFF");
+            }
+            if (e->changed & CTL_CHANGED_BUZZER) {
+                printf("%.3f ch%zu BUZZER %s\n", f.ts[e->row], e->channel, e->buzzer_on ? "ON" : "OFF");
+            }
+        }
+    }
+    fflush(stdout);
+
+    double cs = (double)f.rows * (double)f.channels;
+    fprintf(stderr, "[BATCH] %zu transiciones | %.3f s, %.1f M canal-muestras/s\n",
+            transitions, eval, eval > 0.0 ? cs / eval / 1e6 : 0.0);
+
+    free(tl.events);
+    free(th);
+    free(states);
+    free(above);
+    frame_free(&f);
+    return 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [--threshold X | --sweep desde:hasta:paso | --multi [--thresholds a,b,...]] archivo.csv\n"
+            "  --threshold X   Umbral (por defecto 50); imprime la línea de tiempo de transiciones\n"
+            "  --sweep a:b:p   Barre umbrales de a a b con paso p; imprime una tabla resumen\n"
+            "  --multi         Evalúa todas las columnas del CSV como canales independientes\n"
+            "  --thresholds    Umbral por canal en modo --multi (el último se repite)\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = NULL;
+    double threshold = 50.0;
+    double from = 0.0, to = 0.0, step = 0.0;
+    bool sweep = false;
+    bool multi = false;
+    double thresholds[FRAME_MAX_CHANNELS];
+    size_t nthresholds = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--multi") == 0) {
+            multi = true;
+        } else if (strcmp(argv[i], "--thresholds") == 0 && i + 1 < argc) {
+            char *p = argv[++i];
+            nthresholds = 0;
+            while (*p && nthresholds < FRAME_MAX_CHANNELS) {
+                thresholds[nthresholds++] = strtod(p, &p);
+                if (*p != ',') break;
+                p++;
+            }
+        } else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%lf:%lf:%lf", &from, &to, &step) != 3 || step <= 0.0 || to < from) {
+                usage(argv[0]);
+                return 1;
+            }
+            sweep = true;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path || (multi && sweep)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (multi) {
+        if (nthresholds == 0) thresholds[nthresholds++] = threshold;
+        return run_multi(path, thresholds, nthresholds);
+    }
+
+    double *values, *ts;
+    size_t n;
+    double t0 = rt_now_ns() / 1e9;
+    if (!csv_load_values(path, &values, &ts, &n)) {
+        fprintf(stderr, "[BATCH] Error: No se pudo abrir el archivo %s\n", path);
+        return 1;
+    }
+    double load = rt_now_ns() / 1e9 - t0;
+    normalize_times(ts, n);
+    fprintf(stderr, "[BATCH] %zu muestras cargadas en %.3f s (%.2f s de datos)\n",
+            n, load, n ? ts[n - 1] : 0.0);
+
+    if (!sweep) {
+        static char buf[1 << 16];
+        setvbuf(stdout, buf, _IOFBF, sizeof(buf));
+        batch_result_t r = run(ts, values, n, threshold, stdout);
+        fflush(stdout);
+        fprintf(stderr, "[BATCH] umbral %.2f: %zu transiciones LED, %zu buzzer | %.3f s, %.1f M muestras/s\n",
+                threshold, r.led_transitions, r.buzzer_transitions,
+                r.seconds, r.seconds > 0.0 ? n / r.seconds / 1e6 : 0.0);
+    } else {
+        size_t total = 0;
+        double total_s = 0.0;
+        printf("%10s %12s %12s %8s %14s\n", "umbral", "trans LED", "trans buzz", "LED %", "M muestras/s");
+        /* Índice entero para no acumular error de punto flotante en el paso */
+        for (long k = 0; from + k * step <= to + step * 1e-9; k++) {
+            double th = from + k * step;
+            batch_result_t r = run(ts, values, n, th, NULL);
+            printf("%10.2f %12zu %12zu %8.2f %14.1f\n", th, r.led_transitions, r.buzzer_transitions,
+                   n ? 100.0 * r.led_on_samples / n : 0.0,
+                   r.seconds > 0.0 ? n / r.seconds / 1e6 : 0.0);
+            total += n;
+            total_s += r.seconds;
+        }
+        fflush(stdout);
+        fprintf(stderr, "[BATCH] %zu evaluaciones en %.3f s (%.1f M muestras/s)\n",
+                total, total_s, total_s > 0.0 ? total / total_s / 1e6 : 0.0);
+    }
+
+    free(values);
+    free(ts);
+    return 0;
+}
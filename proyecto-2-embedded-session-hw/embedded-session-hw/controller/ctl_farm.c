@@ -0,0 +1,277 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include "../sensor/csv.h"
+#include "../sensor/sensor.h"
+#include "../actuators/actuator.h"
+#include "../common/arena.h"
+#include "../common/work_steal.h"
+#include "ctl_logic.h"
+#include "rt.h"
+
+/* Granja de simulación: miles de controladores independientes (un sensor,
+ * la lógica de ctl y un par LED/buzzer cada uno) en un solo proceso,
+ * repartidos entre hilos con robo de trabajo. Todo corre en tiempo virtual:
+ * el reloj de cada instancia es el de sus propias muestras. */
+
+#define FARM_THRESHOLD 50.0
+#define FARM_BATCH     64       /* Muestras por lectura del sensor */
+
+/* Un controlador de la granja */
+typedef struct {
+    Sensor sensor;
+    ctl_state_t ctl;
+    Actuator led;
+    Actuator buzzer;
+    unsigned long transitions;  /* LED y buzzer por separado */
+    unsigned long led_on;       /* Muestras con el LED encendido */
+} farm_instance_t;
+
+/* CSV cargado una sola vez y compartido (solo lectura) por las instancias */
+typedef struct {
+    double *t;                  /* Relativo a la primera fila y monotónico */
+    double *v;
+    size_t count;
+    double lap;                 /* Duración de una vuelta completa */
+} farm_csv_t;
+
+/* Fuente de una instancia sobre el CSV compartido: cursor propio que
+ * empieza en una fila elegida por la semilla y da la vuelta al final,
+ * con el reloj siempre hacia adelante */
+typedef struct {
+    const farm_csv_t *csv;
+    size_t start;
+    size_t next;
+    double base;
+} CsvViewParams;
+
+static size_t view_read_batch(void *params, sensor_sample_t *buf, size_t n) {
+    CsvViewParams *p = params;
+    const farm_csv_t *csv = p->csv;
+    for (size_t i = 0; i < n; i++) {
+        if (p->next == csv->count) {
+            p->next = 0;
+            p->base += csv->lap;
+        }
+        buf[i].t = p->base + csv->t[p->next];
+        buf[i].value = csv->v[p->next];
+        p->next++;
+    }
+    return n;
+}
+
+static bool view_eof(void *params) {
+    (void)params;
+    return false;
+}
+
+static void view_reset(void *params) {
+    CsvViewParams *p = params;
+    p->next = p->start;
+    p->base = -p->csv->t[p->start];
+}
+
+static int view_fd(void *params) {
+    (void)params;
+    return -1;
+}
+
+static void view_close(void *params) {
+    (void)params;
+}
+
+static Sensor create_csv_view_sensor(arena_t *arena, const farm_csv_t *csv, uint64_t seed) {
+    Sensor sensor = {NULL, "CSV compartido", false, view_read_batch, view_eof, view_reset, view_fd, view_close};
+    CsvViewParams *p = arena_alloc(arena, sizeof(CsvViewParams));
+    if (!p) return sensor;
+    p->csv = csv;
+    p->start = (size_t)(seed % csv->count);
+    view_reset(p);
+    sensor.params = p;
+    return sensor;
+}
+
+static bool load_csv(farm_csv_t *csv, const char *path) {
+    if (!csv_load_values(path, &csv->v, &csv->t, &csv->count) || csv->count == 0) return false;
+    double start = csv->t[0], last = 0.0;
+    for (size_t i = 0; i < csv->count; i++) {
+        double t = csv->t[i] - start;
+        if (t < last) t = last;
+        csv->t[i] = last = t;
+    }
+    /* Una vuelta dura lo que el archivo más un paso promedio */
+    double step = csv->count > 1 ? last / (double)(csv->count - 1) : 0.1;
+    csv->lap = last + (step > 0.0 ? step : 0.1);
+    return true;
+}
+
+typedef struct {
+    farm_instance_t *inst;
+    size_t steps;               /* Muestras por instancia */
+} farm_t;
+
+/* Trabajo de un rango de instancias: cada una corre todos sus pasos */
+static void farm_range(void *ctx, size_t begin, size_t end, unsigned worker) {
+    farm_t *f = ctx;
+    sensor_sample_t buf[FARM_BATCH];
+    (void)worker;
+
+    for (size_t i = begin; i < end; i++) {
+        farm_instance_t *in = &f->inst[i];
+        Actuator *led = &in->led, *buzzer = &in->buzzer;
+        size_t done = 0;
+        while (done < f->steps) {
+            size_t want = f->steps - done < FARM_BATCH ? f->steps - done : FARM_BATCH;
+            size_t got = in->sensor.read_batch(in->sensor.params, buf, want);
+            if (got == 0) break;
+            for (size_t k = 0; k < got; k++) {
+                bool led_was = in->ctl.led_on, buzzer_was = in->ctl.buzzer_on;
+                unsigned actions = ctl_step(&in->ctl, buf[k].t, buf[k].value);
+                /* Mismo orden que el bucle de ctl */
+                if (actions & CTL_LED_ACTIVATE) led->activate(led->params);
+                if (actions & CTL_BUZZER_ACTIVATE) buzzer->activate(buzzer->params);
+                if (actions & CTL_BUZZER_DEACTIVATE) buzzer->deactivate(buzzer->params);
+                if (actions & CTL_LED_DEACTIVATE) led->deactivate(led->params);
+                in->transitions += (in->ctl.led_on != led_was) + (in->ctl.buzzer_on != buzzer_was);
+                in->led_on += led->status(led->params);
+            }
+            done += got;
+        }
+    }
+}
+
+/* Crea las instancias desde cero en la arena (reciclada entre corridas) */
+static farm_instance_t *create_farm(arena_t *arena, size_t n, const farm_csv_t *csv, uint64_t seed) {
+    arena_reset(arena);
+    farm_instance_t *inst = arena_alloc(arena, n * sizeof(farm_instance_t));
+    if (!inst) return NULL;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t s = seed * 0x9E3779B97F4A7C15ull + i + 1;
+        inst[i].sensor = csv ? create_csv_view_sensor(arena, csv, s) : create_seeded_random_sensor(arena, s);
+        if (!inst[i].sensor.params) return NULL;
+        ctl_init(&inst[i].ctl, FARM_THRESHOLD);
+        inst[i].led = create_led_actuator(arena);
+        inst[i].buzzer = create_buzzer_actuator(arena);
+        if (!inst[i].led.params || !inst[i].buzzer.params) return NULL;
+    }
+    return inst;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [--instances N] [--steps S] [--threads T] [--grain G] [--seed X] [--csv archivo.csv]\n"
+            "  --instances N   Controladores simulados (por defecto 4096)\n"
+            "  --steps S       Muestras por controlador (por defecto 5000)\n"
+            "  --threads T     Hilos máximos; se mide con 1, 2, 4, ... hasta T (por defecto, las CPUs)\n"
+            "  --grain G       Instancias por rango indivisible del reparto (por defecto 16)\n"
+            "  --seed X        Semilla de las fuentes (cada instancia deriva la suya)\n"
+            "  --csv F         Todas las instancias recorren F, cada una desde su propia fila;\n"
+            "                  sin --csv cada una tiene su fuente aleatoria\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    size_t instances = 4096, steps = 5000, grain = 16;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned max_threads = cpus > 0 ? (unsigned)cpus : 1;
+    uint64_t seed = 1;
+    const char *csv_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--instances") == 0 && i + 1 < argc) {
+            instances = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            steps = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            max_threads = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--grain") == 0 && i + 1 < argc) {
+            grain = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_path = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (instances == 0 || steps == 0 || grain == 0 || max_threads == 0 || max_threads > WS_MAX_THREADS) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    farm_csv_t csv_storage, *csv = NULL;
+    if (csv_path) {
+        if (!load_csv(&csv_storage, csv_path)) {
+            fprintf(stderr, "[FARM] Error: No se pudo cargar %s\n", csv_path);
+            return 1;
+        }
+        csv = &csv_storage;
+    }
+    actuator_set_quiet(true);
+
+    ws_worker_stats_t *stats = calloc(max_threads, sizeof(ws_worker_stats_t));
+    arena_t arena;
+    arena_init(&arena, 0);
+
+    printf("=== GRANJA DE SIMULACIÓN ===\n");
+    printf("%zu controladores x %zu muestras, fuente %s, rangos de %zu instancias, hasta %u hilos (%ld CPUs)\n",
+           instances, steps, csv ? csv_path : "aleatoria con semilla", grain, max_threads, cpus);
+    printf("%7s %12s %12s %12s %10s %10s %10s\n", "hilos", "seg", "M pasos/s", "aceleración",
+           "eficiencia", "rangos", "robos");
+
+    double base = 0.0;
+    unsigned long ref_transitions = 0, ref_led_on = 0;
+    int rc = 0;
+    for (unsigned threads = 1;; threads *= 2) {
+        if (threads > max_threads) threads = max_threads;
+        farm_t farm = {create_farm(&arena, instances, csv, seed), steps};
+        if (!farm.inst) {
+            fprintf(stderr, "[FARM] Error: Sin memoria para %zu controladores\n", instances);
+            rc = 1;
+            break;
+        }
+
+        double t0 = rt_now_ns() / 1e9;
+        bool ok = ws_parallel_for(instances, grain, threads, farm_range, &farm, stats);
+        double dt = rt_now_ns() / 1e9 - t0;
+        if (!ok) fprintf(stderr, "[FARM] No se pudieron crear %u hilos; se siguió con menos\n", threads);
+
+        unsigned long transitions = 0, led_on = 0, ranges = 0, steals = 0;
+        for (size_t i = 0; i < instances; i++) {
+            transitions += farm.inst[i].transitions;
+            led_on += farm.inst[i].led_on;
+        }
+        for (unsigned w = 0; w < threads; w++) {
+            ranges += stats[w].ranges;
+            steals += stats[w].steals;
+        }
+
+        double rate = (double)instances * steps / dt;
+        if (threads == 1) {
+            base = rate;
+            ref_transitions = transitions;
+            ref_led_on = led_on;
+        }
+        printf("%7u %12.3f %12.1f %11.2fx %9.0f%% %10lu %10lu\n", threads, dt, rate / 1e6, rate / base,
+               100.0 * rate / base / threads, ranges, steals);
+        if (transitions != ref_transitions || led_on != ref_led_on) {
+            printf("[FARM] ADVERTENCIA: resultados distintos con %u hilos (%lu/%lu transiciones)\n",
+                   threads, transitions, ref_transitions);
+            rc = 1;
+        }
+        if (threads == max_threads) break;
+    }
+    printf("Transiciones totales: %lu, muestras con LED encendido: %lu\n", ref_transitions, ref_led_on);
+
+    arena_free(&arena);
+    free(stats);
+    if (csv) {
+        free(csv->t);
+        free(csv->v);
+    }
+    return rc;
+}
@@ -0,0 +1,192 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "../sensor/csv.h"
+#include "../sensor/sensor.h"
+#include "../sensor/shm_ring.h"
+#include "rt.h"
+
+/* Productor de prueba para las fuentes en vivo de ctl (--source): envía las
+ * filas de un CSV a una FIFO, un socket UNIX o un segmento de memoria
+ * compartida, en ráfagas y al ritmo pedido. Con iio:ruta escribe frames
+ * binarios como los del buffer de un dispositivo IIO (ver README). */
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [--rate N] [--burst K] fifo:ruta|unix:ruta|shm:/nombre|iio:ruta archivo.csv\n"
+            "  --rate N    Muestras por segundo (0 = lo más rápido posible, por defecto)\n"
+            "  --burst K   Muestras por envío (por defecto 1, máximo 4096)\n"
+            "  iio:ruta    Frames de 16 bytes por la FIFO ruta: valor x1000 en le:s32/32>>0\n"
+            "              (índice 0) y timestamp en ns en le:s64/64>>0 (índice 1)\n",
+            prog);
+}
+
+typedef enum { FEED_FIFO, FEED_UNIX, FEED_SHM, FEED_IIO } feed_kind_t;
+
+/* Frame del buffer IIO simulado */
+#define IIO_FRAME 16
+
+typedef struct {
+    feed_kind_t kind;
+    int fd;
+    struct sockaddr_un addr;
+    shm_ring_t *ring;
+} feed_t;
+
+static bool feed_open(feed_t *f, const char *spec) {
+    const char *arg = strchr(spec, ':');
+    if (!arg) return false;
+    arg++;
+    memset(f, 0, sizeof(*f));
+    f->fd = -1;
+
+    if (strncmp(spec, "fifo:", 5) == 0 || strncmp(spec, "iio:", 4) == 0) {
+        f->kind = spec[0] == 'f' ? FEED_FIFO : FEED_IIO;
+        f->fd = open(arg, O_WRONLY);                /* Bloquea hasta que ctl la abra */
+    } else if (strncmp(spec, "unix:", 5) == 0) {
+        f->kind = FEED_UNIX;
+        if (strlen(arg) >= sizeof(f->addr.sun_path)) return false;
+        f->addr.sun_family = AF_UNIX;
+        strcpy(f->addr.sun_path, arg);
+        f->fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    } else if (strncmp(spec, "shm:", 4) == 0) {
+        f->kind = FEED_SHM;
+        f->ring = shm_ring_attach(arg);
+        return f->ring != NULL;
+    }
+    return f->fd >= 0;
+}
+
+/* Little endian de `bytes` bytes, como los frames de IIO */
+static void put_le(unsigned char *p, uint64_t x, unsigned bytes) {
+    for (unsigned i = 0; i < bytes; i++, x >>= 8) p[i] = (unsigned char)x;
+}
+
+static bool write_all(int fd, const char *buf, size_t len) {
+    for (size_t off = 0; off < len;) {
+        ssize_t w = write(fd, buf + off, len - off);
+        if (w < 0) return false;
+        off += (size_t)w;
+    }
+    return true;
+}
+
+/* Envía n muestras; bloquea (reintentando) si el receptor está lleno */
+static bool feed_send(feed_t *f, const sensor_sample_t *s, size_t n) {
+    if (f->kind == FEED_FIFO || f->kind == FEED_IIO) {
+        static char text[4096 * 64];
+        char line[2 * 320 + 2];                     /* Dos "%.6f" en el peor caso (±DBL_MAX) */
+        size_t len = 0;
+        for (size_t i = 0; i < n; i++) {
+            size_t k = IIO_FRAME;
+            if (f->kind == FEED_IIO) {
+                double raw = s[i].value * 1000.0;
+                memset(line, 0, IIO_FRAME);
+                put_le((unsigned char *)line, (uint64_t)(int64_t)(raw < 0.0 ? raw - 0.5 : raw + 0.5), 4);
+                put_le((unsigned char *)line + 8, (uint64_t)(int64_t)(s[i].t * 1e9), 8);
+            } else {
+                int w = snprintf(line, sizeof(line), "%.6f,%.6f\n", s[i].t, s[i].value);
+                if (w < 0 || (size_t)w >= sizeof(line)) return false;
+                k = (size_t)w;
+            }
+            if (len + k > sizeof(text)) {           /* Lleno: se vacía antes de seguir */
+                if (!write_all(f->fd, text, len)) return false;
+                len = 0;
+            }
+            memcpy(text + len, line, k);
+            len += k;
+        }
+        return write_all(f->fd, text, len);
+    }
+    if (f->kind == FEED_UNIX) {
+        for (;;) {
+            if (sendto(f->fd, s, n * sizeof(*s), 0, (struct sockaddr *)&f->addr, sizeof(f->addr)) >= 0) {
+                return true;
+            }
+            if (errno != EAGAIN && errno != ENOBUFS) return false;
+            struct timespec pause = {0, 100000};
+            nanosleep(&pause, NULL);
+        }
+    }
+    while (n > 0) {
+        size_t pushed = shm_ring_push(f->ring, s, n);
+        s += pushed;
+        n -= pushed;
+        if (n > 0) {
+            struct timespec pause = {0, 100000};
+            nanosleep(&pause, NULL);
+        }
+    }
+    return true;
+}
+
+static void feed_close(feed_t *f) {
+    if (f->ring) shm_ring_detach(f->ring);
+    if (f->fd >= 0) close(f->fd);
+}
+
+int main(int argc, char *argv[]) {
+    const char *spec = NULL;
+    const char *path = NULL;
+    double rate = 0.0;
+    size_t burst = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            rate = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--burst") == 0 && i + 1 < argc) {
+            burst = (size_t)atol(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else if (!spec) {
+            spec = argv[i];
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!spec || !path || burst == 0 || burst > 4096 || rate < 0.0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    csv_reader_t r;
+    if (!csv_open(&r, path)) {
+        fprintf(stderr, "[FEED] Error: No se pudo abrir %s\n", path);
+        return 1;
+    }
+    feed_t f;
+    if (!feed_open(&f, spec)) {
+        fprintf(stderr, "[FEED] Error: No se pudo conectar a %s\n", spec);
+        csv_close(&r);
+        return 1;
+    }
+
+    static sensor_sample_t buf[4096];
+    unsigned long sent = 0;
+    uint64_t start = rt_now_ns();
+    bool ok = true;
+    for (;;) {
+        size_t n = 0;
+        while (n < burst && csv_next_row(&r, &buf[n].t, &buf[n].value)) n++;
+        if (n == 0) break;
+        if (rate > 0.0) rt_sleep_until_ns(start + (uint64_t)(sent / rate * 1e9));
+        if (!(ok = feed_send(&f, buf, n))) break;
+        sent += n;
+    }
+    double secs = (rt_now_ns() - start) / 1e9;
+    fprintf(stderr, "[FEED] %lu muestras enviadas en %.3f s%s\n", sent, secs, ok ? "" : " (receptor cerrado)");
+
+    feed_close(&f);
+    csv_close(&r);
+    return ok ? 0 : 1;
+}
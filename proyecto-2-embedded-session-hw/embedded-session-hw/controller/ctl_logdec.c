@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../common/event_log.h"
+
+/* Decodificador del log binario de eventos de ctl (--log archivo) */
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [--changes] log.bin\n"
+            "  --changes   Solo las muestras en que cambia algún actuador\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = NULL;
+    bool changes = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--changes") == 0) {
+            changes = true;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "[LOGDEC] Error: No se pudo abrir %s\n", path);
+        return 1;
+    }
+
+    event_log_header_t h;
+    if (fread(&h, sizeof(h), 1, f) != 1 || memcmp(h.magic, EVLOG_MAGIC, sizeof(h.magic)) != 0) {
+        fprintf(stderr, "[LOGDEC] Error: %s no es un log de eventos\n", path);
+        fclose(f);
+        return 1;
+    }
+    if (h.version != EVLOG_VERSION || h.record_size != sizeof(event_record_t) ||
+        h.nactuators > EVLOG_MAX_ACTUATORS) {
+        fprintf(stderr, "[LOGDEC] Error: versión %u / registro de %u bytes no soportados\n",
+                h.version, h.record_size);
+        fclose(f);
+        return 1;
+    }
+
+    event_record_t rec;
+    unsigned long samples = 0, dropped = 0, printed = 0;
+    uint16_t last = 0;
+    bool first = true;
+    while (fread(&rec, sizeof(rec), 1, f) == 1) {
+        if (rec.kind == EVENT_DROPPED) {
+            dropped += (unsigned long)rec.value;
+        } else {
+            samples++;
+            if (changes && !first && rec.states == last) continue;
+            first = false;
+            last = rec.states;
+        }
+        event_log_format(stdout, &h, &rec);
+        printed++;
+    }
+    fclose(f);
+
+    fprintf(stderr, "[LOGDEC] %lu muestras, %lu descartadas, %lu líneas\n", samples, dropped, printed);
+    return 0;
+}
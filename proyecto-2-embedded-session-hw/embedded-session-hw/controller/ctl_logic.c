@@ -0,0 +1,70 @@
+#include <string.h>
+#include "ctl_logic.h"
+
+void ctl_init(ctl_state_t *s, double threshold) {
+    s->threshold = threshold;
+    s->led_off_time = 0.0;
+    s->buzzer_off_time = 0.0;
+    s->led_on = false;
+    s->buzzer_on = false;
+}
+
+unsigned ctl_step(ctl_state_t *s, double t, double value) {
+    return ctl_step_above(s, t, value >= s->threshold);
+}
+
+unsigned ctl_step_above(ctl_state_t *s, double t, bool above) {
+    unsigned actions = 0;
+
+    if (above) {
+        /* Si supera el umbral, encender de inmediato y cancelar apagados */
+        actions |= CTL_LED_ACTIVATE | CTL_BUZZER_ACTIVATE;
+        s->led_on = true;
+        s->buzzer_on = true;
+        s->led_off_time = 0.0;
+        s->buzzer_off_time = 0.0;
+    } else {
+        /* Si no supera el umbral, programar apagados diferidos */
+        if (s->buzzer_off_time == 0.0) s->buzzer_off_time = t + CTL_BUZZER_DELAY;
+        if (s->led_off_time == 0.0) s->led_off_time = t + CTL_LED_DELAY;
+    }
+
+    /* Revisar si ya se cumplió el tiempo para apagar */
+    if (s->buzzer_off_time > 0.0 && t >= s->buzzer_off_time) {
+        actions |= CTL_BUZZER_DEACTIVATE;
+        s->buzzer_on = false;
+        s->buzzer_off_time = 0.0;
+    }
+
+    if (s->led_off_time > 0.0 && t >= s->led_off_time) {
+        actions |= CTL_LED_DEACTIVATE;
+        s->led_on = false;
+        s->led_off_time = 0.0;
+    }
+
+    return actions;
+}
+
+size_t ctl_run_channel(ctl_state_t *s, size_t channel, size_t row0, size_t n,
+                       const double *t, const uint8_t *above,
+                       ctl_transition_fn on_change, void *ctx) {
+    size_t transitions = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (above[i] && s->led_on && s->buzzer_on && s->led_off_time == 0.0 && s->buzzer_off_time == 0.0) {
+            /* Encendido y sobre el umbral: cada paso deja el estado igual,
+             * así que se salta hasta la próxima muestra bajo el umbral */
+            const uint8_t *below = memchr(above + i, 0, n - i);
+            if (!below) break;
+            i = (size_t)(below - above);
+        }
+        bool led = s->led_on, buzzer = s->buzzer_on;
+        ctl_step_above(s, t[row0 + i], above[i]);
+        unsigned changed = (led != s->led_on ? CTL_CHANGED_LED : 0u) |
+                           (buzzer != s->buzzer_on ? CTL_CHANGED_BUZZER : 0u);
+        if (changed) {
+            transitions += (changed & 1u) + (changed >> 1);
+            if (on_change) on_change(ctx, row0 + i, channel, changed, s);
+        }
+    }
+    return transitions;
+}
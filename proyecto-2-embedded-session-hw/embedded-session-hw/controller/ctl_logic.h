@@ -0,0 +1,59 @@
+#ifndef CTL_LOGIC_H
+#define CTL_LOGIC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Retardos de apagado del controlador de umbral (segundos) */
+#define CTL_BUZZER_DELAY 1.0
+#define CTL_LED_DELAY    5.0
+
+/* Estado del controlador: sin E/S ni reloj propio, el tiempo lo da quien llama */
+typedef struct {
+    double threshold;           /* Umbral de activación */
+    double led_off_time;        /* Apagado diferido del LED (0 = no programado) */
+    double buzzer_off_time;     /* Apagado diferido del buzzer (0 = no programado) */
+    bool led_on;                /* Estado resultante del LED */
+    bool buzzer_on;             /* Estado resultante del buzzer */
+} ctl_state_t;
+
+/* Acciones que el paso pide aplicar sobre los actuadores */
+enum {
+    CTL_LED_ACTIVATE      = 1 << 0,
+    CTL_BUZZER_ACTIVATE   = 1 << 1,
+    CTL_LED_DEACTIVATE    = 1 << 2,
+    CTL_BUZZER_DEACTIVATE = 1 << 3
+};
+
+/* Inicializa el estado con ambos actuadores apagados */
+extern void ctl_init(ctl_state_t *s, double threshold);
+
+/* Un paso del controlador para la muestra (t, value). Función pura sobre el
+ * estado: devuelve las acciones CTL_* en el mismo orden que el bucle
+ * original (activar, luego apagar buzzer, luego apagar LED). */
+extern unsigned ctl_step(ctl_state_t *s, double t, double value);
+
+/* Igual que ctl_step, pero con la comparación contra el umbral ya hecha
+ * (por ejemplo por frame_threshold sobre un bloque de muestras) */
+extern unsigned ctl_step_above(ctl_state_t *s, double t, bool above);
+
+/* Qué cambió en una transición */
+enum {
+    CTL_CHANGED_LED    = 1 << 0,
+    CTL_CHANGED_BUZZER = 1 << 1
+};
+
+/* Callback de transición: changed indica qué actuador del canal cambió y
+ * s tiene el estado ya actualizado */
+typedef void (*ctl_transition_fn)(void *ctx, size_t row, size_t channel,
+                                  unsigned changed, const ctl_state_t *s);
+
+/* Corre n pasos de un canal sobre la máscara above (fila row0 en adelante).
+ * Llama a on_change (si no es NULL) en cada transición y devuelve cuántas
+ * hubo, contando LED y buzzer por separado. */
+extern size_t ctl_run_channel(ctl_state_t *s, size_t channel, size_t row0, size_t n,
+                              const double *t, const uint8_t *above,
+                              ctl_transition_fn on_change, void *ctx);
+
+#endif /* CTL_LOGIC_H */
@@ -0,0 +1,58 @@
+#define _POSIX_C_SOURCE 200809L
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include "../common/state_bus.h"
+
+/* Suscriptor externo del bus de cambios de ctl (--bus /nombre): imprime los
+ * cambios desde otro proceso, esperando en el FIFO de aviso del bus */
+
+static volatile sig_atomic_t stop;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop = 1;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s /nombre\n"
+            "  /nombre     Segmento del bus de ctl (ctl64 --bus /nombre)\n",
+            prog);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 2 || argv[1][0] != '/') {
+        usage(argv[0]);
+        return 1;
+    }
+
+    bus_sub_t sub;
+    if (!state_bus_attach(&sub, argv[1])) {
+        fprintf(stderr, "[WATCH] Error: No se pudo conectar al bus %s\n", argv[1]);
+        return 1;
+    }
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    bus_event_t ev[64];
+    unsigned long events = 0;
+    while (!stop) {
+        size_t n = state_bus_read(&sub, ev, sizeof(ev) / sizeof(ev[0]));
+        for (size_t i = 0; i < n; i++) state_bus_print(stdout, sub.ring, &ev[i]);
+        events += n;
+        if (n == 0) {
+            if (state_bus_closed(&sub)) break;
+            fflush(stdout);
+            state_bus_wait(&sub, 200);
+        }
+    }
+    fflush(stdout);
+    fprintf(stderr, "[WATCH] %lu eventos, %lu perdidos%s\n", events, sub.lost,
+            state_bus_closed(&sub) ? " (ctl terminó)" : "");
+    state_bus_detach(&sub);
+    return 0;
+}
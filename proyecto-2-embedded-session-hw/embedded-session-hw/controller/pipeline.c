@@ -0,0 +1,160 @@
+#define _GNU_SOURCE
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include "pipeline.h"
+#include "rt.h"
+
+#define PIPE_BATCH 64
+
+/* Espera activa corta cediendo la CPU, y luego pausas de 20 µs */
+static void backoff(unsigned *spins) {
+    if (++*spins < 64) {
+        sched_yield();
+    } else {
+        struct timespec pause = {0, 20000};
+        nanosleep(&pause, NULL);
+    }
+}
+
+/* Encola según la política; devuelve false solo si se descartó un registro */
+static bool enqueue(pipeline_t *p, spsc_ring_t *r, const pipe_item_t *item) {
+    if (p->cfg.policy == PIPE_DROP_OLDEST) return !spsc_push_overwrite(r, item);
+    unsigned spins = 0;
+    while (!spsc_push(r, item)) backoff(&spins);
+    return true;
+}
+
+static bool dequeue(pipeline_t *p, spsc_ring_t *r, pipe_item_t *item) {
+    return p->cfg.policy == PIPE_DROP_OLDEST ? spsc_pop_shared(r, item) : spsc_pop(r, item);
+}
+
+static void *acquire_thread(void *arg) {
+    pipeline_t *p = arg;
+    pipe_stage_t *st = &p->stage[PIPE_ACQUIRE];
+    sensor_sample_t buf[PIPE_BATCH];
+    size_t n;
+
+    while ((n = p->cfg.acquire(p->cfg.ctx, buf, PIPE_BATCH)) > 0) {
+        uint64_t t_acq = rt_now_ns();
+        for (size_t i = 0; i < n; i++) {
+            pipe_item_t item = {buf[i].t, buf[i].value, t_acq, 0, 0};
+            if (!enqueue(p, &p->samples, &item)) {
+                atomic_fetch_add_explicit(&p->stage[PIPE_CONTROL].dropped, 1, memory_order_relaxed);
+            }
+            hist_record(&st->latency, rt_now_ns() - t_acq);
+        }
+        atomic_fetch_add_explicit(&st->items, n, memory_order_relaxed);
+    }
+    atomic_store_explicit(&p->acquire_done, true, memory_order_release);
+    return NULL;
+}
+
+static void *control_thread(void *arg) {
+    pipeline_t *p = arg;
+    pipe_stage_t *st = &p->stage[PIPE_CONTROL];
+    pipe_item_t item;
+    unsigned spins = 0;
+
+    for (;;) {
+        /* done se lee antes de intentar: si ya terminó y la cola está
+         * vacía, no queda nada en camino */
+        bool done = atomic_load_explicit(&p->acquire_done, memory_order_acquire);
+        if (!dequeue(p, &p->samples, &item)) {
+            if (done) break;
+            backoff(&spins);
+            continue;
+        }
+        spins = 0;
+        item.states = p->cfg.control(p->cfg.ctx, item.t, &item.value);
+        item.t_ctl = rt_now_ns();
+        hist_record(&st->latency, item.t_ctl - item.t_acq);
+        atomic_fetch_add_explicit(&st->items, 1, memory_order_relaxed);
+        if (!enqueue(p, &p->commands, &item)) {
+            atomic_fetch_add_explicit(&p->stage[PIPE_ACTUATE].dropped, 1, memory_order_relaxed);
+        }
+    }
+    atomic_store_explicit(&p->control_done, true, memory_order_release);
+    return NULL;
+}
+
+static void *actuate_thread(void *arg) {
+    pipeline_t *p = arg;
+    pipe_stage_t *st = &p->stage[PIPE_ACTUATE];
+    pipe_item_t item;
+    unsigned spins = 0;
+
+    for (;;) {
+        bool done = atomic_load_explicit(&p->control_done, memory_order_acquire);
+        if (!dequeue(p, &p->commands, &item)) {
+            if (done) break;
+            backoff(&spins);
+            continue;
+        }
+        spins = 0;
+        uint16_t changed = (uint16_t)(item.states ^ p->applied);
+        p->cfg.actuate(p->cfg.ctx, &item, changed);
+        p->applied = item.states;
+        uint64_t t_act = rt_now_ns();
+        hist_record(&st->latency, t_act - item.t_ctl);
+        hist_record(&p->end_to_end, t_act - item.t_acq);
+        atomic_fetch_add_explicit(&st->items, 1, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+bool pipeline_init(pipeline_t *p, const pipeline_config_t *cfg) {
+    memset(p, 0, sizeof(*p));
+    p->cfg = *cfg;
+    atomic_init(&p->acquire_done, false);
+    atomic_init(&p->control_done, false);
+    hist_init(&p->stage[PIPE_ACQUIRE].latency, "adquisicion");
+    hist_init(&p->stage[PIPE_CONTROL].latency, "control");
+    hist_init(&p->stage[PIPE_ACTUATE].latency, "actuacion");
+    hist_init(&p->end_to_end, "extremo-a-extremo");
+    for (int i = 0; i < PIPE_STAGES; i++) {
+        atomic_init(&p->stage[i].items, 0);
+        atomic_init(&p->stage[i].dropped, 0);
+    }
+    if (!spsc_init(&p->samples, sizeof(pipe_item_t), cfg->capacity)) return false;
+    if (!spsc_init(&p->commands, sizeof(pipe_item_t), cfg->capacity)) {
+        spsc_free(&p->samples);
+        return false;
+    }
+    return true;
+}
+
+bool pipeline_run(pipeline_t *p) {
+    /* Primero los consumidores: si falla un pthread_create, los que ya
+     * corren pueden terminar marcando el fin de su entrada */
+    void *(*const fns[PIPE_STAGES])(void *) = {actuate_thread, control_thread, acquire_thread};
+    pthread_t threads[PIPE_STAGES];
+    int started = 0;
+
+    while (started < PIPE_STAGES && pthread_create(&threads[started], NULL, fns[started], p) == 0) {
+        started++;
+    }
+    if (started < PIPE_STAGES) {
+        atomic_store(&p->acquire_done, true);
+        if (started < 2) atomic_store(&p->control_done, true);
+    }
+    for (int i = 0; i < started; i++) pthread_join(threads[i], NULL);
+    return started == PIPE_STAGES;
+}
+
+void pipeline_report(pipeline_t *p, FILE *out) {
+    static const char *const names[PIPE_STAGES] = {"adquisicion", "control", "actuacion"};
+    fprintf(out, "=== TUBERIA (%s) ===\n", p->cfg.policy == PIPE_BLOCK ? "bloquear" : "descartar el más viejo");
+    for (int i = 0; i < PIPE_STAGES; i++) {
+        fprintf(out, "%-12s %lu registros, %lu descartados en su cola de entrada\n", names[i],
+                atomic_load_explicit(&p->stage[i].items, memory_order_relaxed),
+                atomic_load_explicit(&p->stage[i].dropped, memory_order_relaxed));
+    }
+    for (int i = 0; i < PIPE_STAGES; i++) hist_print(&p->stage[i].latency, out, 1000.0, "us");
+    hist_print(&p->end_to_end, out, 1000.0, "us");
+}
+
+void pipeline_free(pipeline_t *p) {
+    spsc_free(&p->samples);
+    spsc_free(&p->commands);
+}
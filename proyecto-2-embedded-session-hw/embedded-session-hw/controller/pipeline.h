@@ -0,0 +1,83 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "../common/hist.h"
+#include "../common/spsc_ring.h"
+#include "../sensor/sensor.h"
+
+/* Tubería de tres hilos: adquisición -> control -> actuación, unidos por
+ * colas SPSC acotadas. Un actuador lento ya no frena el muestreo: según la
+ * política, el productor espera (PIPE_BLOCK) o se descarta el registro más
+ * viejo de la cola (PIPE_DROP_OLDEST). Cada registro lleva el estado deseado
+ * completo de los actuadores, así que descartar uno solo saltea estados
+ * intermedios: el último siempre se aplica. Solo en ctl64 (-DCTL_PIPELINE). */
+
+typedef enum {
+    PIPE_BLOCK,                 /* Contrapresión: el productor espera lugar */
+    PIPE_DROP_OLDEST            /* Se descarta el registro más viejo */
+} pipe_policy_t;
+
+/* Muestra en tránsito */
+typedef struct {
+    double t;                   /* Reloj del controlador */
+    double value;
+    uint64_t t_acq;             /* ns: la muestra salió del sensor */
+    uint64_t t_ctl;             /* ns: el control terminó de procesarla */
+    uint16_t states;            /* Estado deseado de los actuadores (bit i = actuador i) */
+} pipe_item_t;
+
+/* Etapas: acquire entrega un lote con t ya en el reloj del controlador
+ * (espera lo que haga falta; 0 = fin de los datos), control devuelve el
+ * estado deseado (y puede reemplazar el valor, por ejemplo por el filtrado)
+ * y actuate aplica los bits de changed. Cada una corre en su
+ * propio hilo y solo ella toca su parte de ctx. */
+typedef struct {
+    size_t (*acquire)(void *ctx, sensor_sample_t *buf, size_t n);
+    uint16_t (*control)(void *ctx, double t, double *value);
+    void (*actuate)(void *ctx, const pipe_item_t *item, uint16_t changed);
+    void *ctx;
+    pipe_policy_t policy;
+    size_t capacity;            /* Registros por cola */
+} pipeline_config_t;
+
+enum { PIPE_ACQUIRE, PIPE_CONTROL, PIPE_ACTUATE, PIPE_STAGES };
+
+/* Contadores de una etapa; latency es lo que tarda cada registro en
+ * atravesarla, incluida la espera en su cola de entrada */
+typedef struct {
+    _Atomic unsigned long items;
+    _Atomic unsigned long dropped;      /* Registros descartados al encolar */
+    hist_t latency;
+} pipe_stage_t;
+
+typedef struct {
+    pipeline_config_t cfg;
+    spsc_ring_t samples;        /* Adquisición -> control */
+    spsc_ring_t commands;       /* Control -> actuación */
+    atomic_bool acquire_done;
+    atomic_bool control_done;
+    uint16_t applied;           /* Estado aplicado (hilo de actuación) */
+    pipe_stage_t stage[PIPE_STAGES];
+    hist_t end_to_end;          /* Del sensor al actuador */
+} pipeline_t;
+
+/* Reserva las colas; false si falta memoria */
+extern bool pipeline_init(pipeline_t *p, const pipeline_config_t *cfg);
+
+/* Lanza los tres hilos y espera a que terminen: acquire devuelve 0 y las
+ * colas se vacían. false si no se pudieron crear los hilos. */
+extern bool pipeline_run(pipeline_t *p);
+
+/* Contadores e histogramas por etapa (los valores son aproximados si se
+ * llama mientras la tubería trabaja) */
+extern void pipeline_report(pipeline_t *p, FILE *out);
+
+extern void pipeline_free(pipeline_t *p);
+
+#endif /* PIPELINE_H */
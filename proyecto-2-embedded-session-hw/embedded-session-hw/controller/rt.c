@@ -0,0 +1,64 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/mman.h>
+#include "rt.h"
+
+/* Toca el stack que usará el bucle para que ya esté residente */
+static void prefault_stack(void) {
+    volatile unsigned char stack[64 * 1024];
+    for (size_t i = 0; i < sizeof(stack); i += 4096) stack[i] = 0;
+}
+
+bool rt_setup(const rt_config_t *cfg) {
+    bool ok = true;
+
+    if (cfg->lock_memory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            fprintf(stderr, "[RT] Aviso: mlockall falló: %s\n", strerror(errno));
+            ok = false;
+        } else {
+            prefault_stack();
+        }
+    }
+
+    if (cfg->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cfg->cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            fprintf(stderr, "[RT] Aviso: no se pudo fijar a la CPU %d: %s\n", cfg->cpu, strerror(errno));
+            ok = false;
+        }
+    }
+
+    if (cfg->priority > 0) {
+        struct sched_param sp;
+        memset(&sp, 0, sizeof(sp));
+        sp.sched_priority = cfg->priority;
+        if (sched_setscheduler(0, SCHED_FIFO, &sp) != 0) {
+            fprintf(stderr, "[RT] Aviso: SCHED_FIFO %d falló: %s\n", cfg->priority, strerror(errno));
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+uint64_t rt_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void rt_sleep_until_ns(uint64_t deadline_ns) {
+    struct timespec ts;
+    ts.tv_sec = (time_t)(deadline_ns / 1000000000ull);
+    ts.tv_nsec = (long)(deadline_ns % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+        /* Una señal (por ejemplo SIGUSR1) no debe adelantar el ciclo */
+    }
+}
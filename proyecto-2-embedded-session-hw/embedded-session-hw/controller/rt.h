@@ -0,0 +1,26 @@
+#ifndef RT_H
+#define RT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Configuración del modo de tiempo real */
+typedef struct {
+    uint64_t period_ns;     /* Período del bucle */
+    int priority;           /* Prioridad SCHED_FIFO (0 = no cambiar la política) */
+    int cpu;                /* CPU a la que fijar el proceso (-1 = sin fijar) */
+    bool lock_memory;       /* mlockall para evitar fallos de página */
+} rt_config_t;
+
+/* Aplica prioridad, afinidad y bloqueo de memoria. Lo que falle (por
+ * ejemplo por falta de permisos) se avisa y se sigue sin eso; retorna
+ * false si algo no se pudo aplicar. */
+extern bool rt_setup(const rt_config_t *cfg);
+
+/* Reloj monotónico en nanosegundos */
+extern uint64_t rt_now_ns(void);
+
+/* Duerme hasta el instante absoluto deadline_ns (CLOCK_MONOTONIC) */
+extern void rt_sleep_until_ns(uint64_t deadline_ns);
+
+#endif /* RT_H */
@@ -0,0 +1,438 @@
+#define _POSIX_C_SOURCE 200809L
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rules.h"
+
+#define MAX_TOKENS 256          /* Palabras por línea; más es un error de sintaxis */
+
+/* Regla antes de compilar a arreglos */
+typedef struct {
+    uint32_t fidx;
+    double sign, on, off;
+    uint32_t rise, nrise, fall, nfall;
+} rule_src_t;
+
+typedef struct {
+    rules_t *r;
+    rule_src_t *src;
+    size_t nsrc, capsrc;
+    size_t capactions, capfeatures, capactuators;
+    char *err;
+    size_t errlen;
+    int line;
+} parser_t;
+
+static bool fail(parser_t *p, const char *fmt, ...) {
+    va_list ap;
+    int n = snprintf(p->err, p->errlen, "línea %d: ", p->line);
+    va_start(ap, fmt);
+    if (n >= 0 && (size_t)n < p->errlen) vsnprintf(p->err + n, p->errlen - (size_t)n, fmt, ap);
+    va_end(ap);
+    return false;
+}
+
+/* Crece un arreglo al doble cuando se llena */
+static bool reserve(void **ptr, size_t *cap, size_t need, size_t elem) {
+    if (need <= *cap) return true;
+    size_t cap2 = *cap ? *cap * 2 : 16;
+    while (cap2 < need) cap2 *= 2;
+    void *bigger = realloc(*ptr, cap2 * elem);
+    if (!bigger) return false;
+    *ptr = bigger;
+    *cap = cap2;
+    return true;
+}
+
+static bool parse_number(const char *tok, double *out) {
+    char *end;
+    *out = strtod(tok, &end);
+    return end != tok && *end == '\0';
+}
+
+static int find_actuator(const rules_t *r, const char *name) {
+    for (size_t i = 0; i < r->nactuators; i++) {
+        if (strcmp(r->names[i], name) == 0) return (int)i;
+    }
+    return -1;
+}
+
+static bool parse_actuator(parser_t *p, char **tok, int ntok) {
+    rules_t *r = p->r;
+    Actuator a;
+
+    if (ntok != 3) return fail(p, "se esperaba: actuator <nombre> led|buzzer|none");
+    if (strlen(tok[1]) >= RULES_NAME_MAX) return fail(p, "nombre de actuador demasiado largo");
+    if (find_actuator(r, tok[1]) >= 0) return fail(p, "actuador '%s' repetido", tok[1]);
+
+    if (strcmp(tok[2], "led") == 0) a = create_led_actuator(&r->arena);
+    else if (strcmp(tok[2], "buzzer") == 0) a = create_buzzer_actuator(&r->arena);
+    else if (strcmp(tok[2], "none") == 0) a = create_none_actuator(&r->arena);
+    else return fail(p, "tipo de actuador desconocido '%s'", tok[2]);
+
+    size_t cap = p->capactuators;
+    if (!reserve((void **)&r->actuators, &cap, r->nactuators + 1, sizeof(Actuator)) ||
+        !reserve((void **)&r->names, &p->capactuators, r->nactuators + 1, RULES_NAME_MAX)) {
+        return fail(p, "sin memoria");
+    }
+    strcpy(r->names[r->nactuators], tok[1]);
+    r->actuators[r->nactuators++] = a;
+    return true;
+}
+
+/* Característica (tipo, canal, ventana), reutilizada si ya existe */
+static bool feature_index(parser_t *p, const char *spec, uint32_t channel, uint32_t *idx) {
+    rules_t *r = p->r;
+    feature_kind_t kind;
+    uint32_t window = 0;
+
+    if (strcmp(spec, "raw") == 0) {
+        kind = FEATURE_RAW;
+    } else if (strcmp(spec, "rate") == 0) {
+        kind = FEATURE_RATE;
+    } else if (strncmp(spec, "avg", 3) == 0) {
+        char *end;
+        long n = strtol(spec + 3, &end, 10);
+        if (end == spec + 3 || *end || n < 1 || n > 1000000) {
+            return fail(p, "ventana inválida en '%s' (avg<N>, N entre 1 y 1000000)", spec);
+        }
+        kind = FEATURE_AVG;
+        window = (uint32_t)n;
+    } else {
+        return fail(p, "característica desconocida '%s' (raw, rate o avg<N>)", spec);
+    }
+
+    for (size_t i = 0; i < r->nfeatures; i++) {
+        const rule_feature_t *f = &r->features[i];
+        if (f->kind == kind && f->channel == channel && f->window == window) {
+            *idx = (uint32_t)i;
+            return true;
+        }
+    }
+    if (!reserve((void **)&r->features, &p->capfeatures, r->nfeatures + 1, sizeof(rule_feature_t))) {
+        return fail(p, "sin memoria");
+    }
+    rule_feature_t *f = &r->features[r->nfeatures];
+    memset(f, 0, sizeof(*f));
+    f->kind = kind;
+    f->channel = channel;
+    f->window = window;
+    if (kind == FEATURE_AVG && !(f->ring = calloc(window, sizeof(double)))) return fail(p, "sin memoria");
+    *idx = (uint32_t)r->nfeatures++;
+    return true;
+}
+
+/* Acciones tok[from..to): <actuador>=on|off[@segundos] */
+static bool parse_actions(parser_t *p, char **tok, int from, int to, uint32_t *first, uint32_t *count) {
+    rules_t *r = p->r;
+
+    *first = (uint32_t)r->nactions;
+    *count = 0;
+    for (int i = from; i < to; i++) {
+        char *eq = strchr(tok[i], '=');
+        if (!eq) return fail(p, "acción inválida '%s' (actuador=on|off[@seg])", tok[i]);
+        *eq = '\0';
+        char *at = strchr(eq + 1, '@');
+        double delay = 0.0;
+        if (at) {
+            *at = '\0';
+            if (!parse_number(at + 1, &delay) || delay < 0.0) return fail(p, "retardo inválido '%s'", at + 1);
+        }
+        int act = find_actuator(r, tok[i]);
+        if (act < 0) return fail(p, "actuador '%s' no declarado", tok[i]);
+        bool on;
+        if (strcmp(eq + 1, "on") == 0) on = true;
+        else if (strcmp(eq + 1, "off") == 0) on = false;
+        else return fail(p, "estado inválido '%s' (on u off)", eq + 1);
+
+        if (!reserve((void **)&r->actions, &p->capactions, r->nactions + 1, sizeof(rule_action_t))) {
+            return fail(p, "sin memoria");
+        }
+        rule_action_t *a = &r->actions[r->nactions++];
+        a->actuator = (uint32_t)act;
+        a->on = on;
+        a->delay = (uint64_t)(delay / RULES_TICK + 0.5);
+        (*count)++;
+    }
+    return true;
+}
+
+static bool parse_rule(parser_t *p, char **tok, int ntok) {
+    rule_src_t rs;
+    int colon1 = -1, colon2 = -1;
+    double on, off;
+    char *end;
+
+    for (int i = 0; i < ntok; i++) {
+        if (strcmp(tok[i], ":") != 0) continue;
+        if (colon1 < 0) colon1 = i;
+        else if (colon2 < 0) colon2 = i;
+        else return fail(p, "demasiados ':'");
+    }
+    if (colon2 < 0) colon2 = ntok;
+    if (colon1 != 5 && colon1 != 6) {
+        return fail(p, "se esperaba: rule <canal> <caract> >=|<= <on> [<off>] : <acciones> : <acciones>");
+    }
+
+    long channel = strtol(tok[1], &end, 10);
+    if (end == tok[1] || *end || channel < 0 || channel > 65535) return fail(p, "canal inválido '%s'", tok[1]);
+    if (!feature_index(p, tok[2], (uint32_t)channel, &rs.fidx)) return false;
+
+    if (strcmp(tok[3], ">=") == 0) rs.sign = 1.0;
+    else if (strcmp(tok[3], "<=") == 0) rs.sign = -1.0;
+    else return fail(p, "operador inválido '%s' (>= o <=)", tok[3]);
+
+    if (!parse_number(tok[4], &on)) return fail(p, "umbral inválido '%s'", tok[4]);
+    off = on;
+    if (colon1 == 6 && !parse_number(tok[5], &off)) return fail(p, "umbral de histéresis inválido '%s'", tok[5]);
+    /* Con <= se compara -v contra -on: la banda debe quedar del lado que retiene */
+    if (rs.sign * off > rs.sign * on) return fail(p, "la histéresis debe quedar por %s del umbral",
+                                                  rs.sign > 0 ? "debajo" : "encima");
+    rs.on = rs.sign * on;
+    rs.off = rs.sign * off;
+
+    if (!parse_actions(p, tok, colon1 + 1, colon2, &rs.rise, &rs.nrise)) return false;
+    if (!parse_actions(p, tok, colon2 + 1 < ntok ? colon2 + 1 : ntok, ntok, &rs.fall, &rs.nfall)) return false;
+
+    if (!reserve((void **)&p->src, &p->capsrc, p->nsrc + 1, sizeof(rule_src_t))) return fail(p, "sin memoria");
+    p->src[p->nsrc++] = rs;
+    if ((size_t)channel + 1 > p->r->channels) p->r->channels = (size_t)channel + 1;
+    return true;
+}
+
+/* Pasa las reglas a arreglos planos */
+static bool compile(parser_t *p) {
+    rules_t *r = p->r;
+    size_t n = p->nsrc;
+
+    r->nrules = n;
+    r->fidx = malloc((n + 1) * sizeof(uint32_t));
+    r->sign = malloc((n + 1) * sizeof(double));
+    r->on = malloc((n + 1) * sizeof(double));
+    r->off = malloc((n + 1) * sizeof(double));
+    r->state = calloc(n + 1, 1);
+    r->rise = malloc((n + 1) * sizeof(uint32_t));
+    r->nrise = malloc((n + 1) * sizeof(uint32_t));
+    r->fall = malloc((n + 1) * sizeof(uint32_t));
+    r->nfall = malloc((n + 1) * sizeof(uint32_t));
+    r->edges = malloc((n + 1) * sizeof(uint32_t));
+    r->feat = calloc(r->nfeatures + 1, sizeof(double));
+    r->pending = calloc(r->nactuators + 1, sizeof(ActuatorAction));
+    if (!r->fidx || !r->sign || !r->on || !r->off || !r->state || !r->rise || !r->nrise ||
+        !r->fall || !r->nfall || !r->edges || !r->feat || !r->pending) {
+        return fail(p, "sin memoria");
+    }
+    for (size_t i = 0; i < n; i++) {
+        r->fidx[i] = p->src[i].fidx;
+        r->sign[i] = p->src[i].sign;
+        r->on[i] = p->src[i].on;
+        r->off[i] = p->src[i].off;
+        r->rise[i] = p->src[i].rise;
+        r->nrise[i] = p->src[i].nrise;
+        r->fall[i] = p->src[i].fall;
+        r->nfall[i] = p->src[i].nfall;
+    }
+    return true;
+}
+
+bool rules_parse(rules_t *r, const char *text, char *err, size_t errlen) {
+    parser_t p;
+    char *copy = strdup(text);
+    char *tok[MAX_TOKENS];
+    bool ok = true;
+
+    memset(r, 0, sizeof(*r));
+    memset(&p, 0, sizeof(p));
+    arena_init(&r->arena, 0);
+    p.r = r;
+    p.err = err;
+    p.errlen = errlen;
+    if (!copy) return fail(&p, "sin memoria");
+
+    for (char *line = copy, *next; ok && line; line = next) {
+        next = strchr(line, '\n');
+        if (next) *next++ = '\0';
+        p.line++;
+
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        int ntok = 0;
+        for (char *s = line; *s;) {
+            while (isspace((unsigned char)*s)) s++;
+            if (!*s) break;
+            if (ntok == MAX_TOKENS) {
+                ok = fail(&p, "más de %d palabras", MAX_TOKENS);
+                break;
+            }
+            tok[ntok++] = s;
+            while (*s && !isspace((unsigned char)*s)) s++;
+            if (*s) *s++ = '\0';
+        }
+        if (!ok || ntok == 0) continue;
+
+        if (strcmp(tok[0], "actuator") == 0) ok = parse_actuator(&p, tok, ntok);
+        else if (strcmp(tok[0], "rule") == 0) ok = parse_rule(&p, tok, ntok);
+        else ok = fail(&p, "se esperaba 'actuator' o 'rule', no '%s'", tok[0]);
+    }
+    if (ok && p.nsrc == 0) {
+        snprintf(err, errlen, "no hay reglas");
+        ok = false;
+    }
+    if (ok) ok = compile(&p);
+
+    free(copy);
+    free(p.src);
+    if (!ok) rules_free(r);
+    return ok;
+}
+
+char *rules_read_file(const char *path, char *err, size_t errlen) {
+    FILE *f = fopen(path, "r");
+    char *text = NULL;
+    size_t len = 0, cap = 0;
+    char buf[4096];
+    size_t n;
+
+    if (!f) {
+        snprintf(err, errlen, "no se pudo abrir %s", path);
+        return NULL;
+    }
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        if (!reserve((void **)&text, &cap, len + n + 1, 1)) {
+            fclose(f);
+            free(text);
+            snprintf(err, errlen, "sin memoria");
+            return NULL;
+        }
+        memcpy(text + len, buf, n);
+        len += n;
+    }
+    fclose(f);
+    if (!text) {
+        snprintf(err, errlen, "%s está vacío", path);
+        return NULL;
+    }
+    text[len] = '\0';
+    return text;
+}
+
+bool rules_load(rules_t *r, const char *path, char *err, size_t errlen) {
+    memset(r, 0, sizeof(*r));
+    char *text = rules_read_file(path, err, errlen);
+    if (!text) return false;
+
+    bool ok = rules_parse(r, text, err, errlen);
+    free(text);
+    return ok;
+}
+
+/* Características del tick; el costo depende de los canales, no de las reglas */
+static void update_features(rules_t *r, double t, const double *values) {
+    for (size_t i = 0; i < r->nfeatures; i++) {
+        rule_feature_t *f = &r->features[i];
+        double v = values[f->channel];
+
+        switch (f->kind) {
+        case FEATURE_RAW:
+            r->feat[i] = v;
+            break;
+        case FEATURE_RATE: {
+            double dt = t - f->prev_t;
+            r->feat[i] = (f->fill && dt > 0.0) ? (v - f->prev) / dt : 0.0;
+            f->prev = v;
+            f->prev_t = t;
+            f->fill = 1;
+            break;
+        }
+        case FEATURE_AVG:
+            if (f->fill == f->window) f->sum -= f->ring[f->head];
+            else f->fill++;
+            f->ring[f->head] = v;
+            f->sum += v;
+            if (++f->head == f->window) f->head = 0;
+            r->feat[i] = f->sum / f->fill;
+            break;
+        }
+    }
+}
+
+static void apply(rules_t *r, uint32_t first, uint32_t count, uint64_t tick) {
+    for (uint32_t k = first; k < first + count; k++) {
+        const rule_action_t *a = &r->actions[k];
+        Actuator *act = &r->actuators[a->actuator];
+        ActuatorAction *pend = &r->pending[a->actuator];
+
+        actuator_action_cancel(pend);
+        if (a->delay == 0) {
+            if (a->on) act->activate(act->params);
+            else act->deactivate(act->params);
+        } else {
+            /* La rueda quedó en tick - 1: el retardo se cuenta desde tick */
+            uint64_t delay = a->delay + (tick - r->wheel.now);
+            if (a->on) actuator_on_after(&r->wheel, pend, act, delay);
+            else actuator_off_after(&r->wheel, pend, act, delay);
+        }
+    }
+}
+
+size_t rules_eval(rules_t *r, double t, const double *values) {
+    if (!r->started) {
+        r->started = true;
+        r->t0 = t;
+        tw_init(&r->wheel, 0);
+    }
+    double rel = t - r->t0;
+    uint64_t tick = rel > 0.0 ? (uint64_t)(rel / RULES_TICK + 0.5) : 0;
+    if (tick < r->wheel.now) tick = r->wheel.now;      /* El reloj nunca retrocede */
+
+    /* Primero vencen los timers anteriores a este tick; los de este tick
+     * corren después de las reglas, igual que en ctl_step (una regla que
+     * se activa justo al vencer un apagado lo cancela) */
+    if (tick > 0) tw_advance(&r->wheel, tick - 1);
+
+    update_features(r, t, values);
+
+    /* Camino caliente: sin saltos, una pasada por arreglos planos */
+    size_t nedges = 0;
+    const double *feat = r->feat;
+    for (size_t i = 0; i < r->nrules; i++) {
+        double v = r->sign[i] * feat[r->fidx[i]];
+        uint8_t s = (uint8_t)((v >= r->on[i]) | (r->state[i] & (v >= r->off[i])));
+        r->edges[nedges] = (uint32_t)i;
+        nedges += s ^ r->state[i];
+        r->state[i] = s;
+    }
+
+    for (size_t k = 0; k < nedges; k++) {
+        uint32_t i = r->edges[k];
+        if (r->state[i]) apply(r, r->rise[i], r->nrise[i], tick);
+        else apply(r, r->fall[i], r->nfall[i], tick);
+    }
+
+    tw_advance(&r->wheel, tick);
+    return nedges;
+}
+
+void rules_free(rules_t *r) {
+    for (size_t i = 0; i < r->nfeatures; i++) free(r->features[i].ring);
+    arena_free(&r->arena);
+    free(r->names);
+    free(r->actuators);
+    free(r->pending);
+    free(r->features);
+    free(r->feat);
+    free(r->fidx);
+    free(r->sign);
+    free(r->on);
+    free(r->off);
+    free(r->state);
+    free(r->rise);
+    free(r->nrise);
+    free(r->fall);
+    free(r->nfall);
+    free(r->edges);
+    free(r->actions);
+    memset(r, 0, sizeof(*r));
+}
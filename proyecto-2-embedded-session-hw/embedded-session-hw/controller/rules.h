@@ -0,0 +1,108 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../actuators/actuator.h"
+#include "../actuators/actuator_sched.h"
+#include "../common/timer_wheel.h"
+
+/* Motor de reglas: las reglas del archivo de configuración se compilan a
+ * arreglos planos (SoA) y cada tick se evalúan sin saltos:
+ *
+ *     v = signo * caracteristica[idx]
+ *     s = (v >= on) | (s & (v >= off))
+ *
+ * Con off == on es un umbral simple; con off < on, una banda de histéresis.
+ * Solo las reglas que cambian de estado (flancos) ejecutan acciones. */
+
+#define RULES_NAME_MAX  16
+#define RULES_TICK      0.001   /* Segundos por tick de la rueda de timers */
+
+/* Características calculadas por canal */
+typedef enum {
+    FEATURE_RAW,                /* Valor tal cual */
+    FEATURE_RATE,               /* Variación por segundo respecto a la muestra anterior */
+    FEATURE_AVG                 /* Promedio de las últimas N muestras */
+} feature_kind_t;
+
+typedef struct {
+    feature_kind_t kind;
+    uint32_t channel;
+    uint32_t window;            /* N de FEATURE_AVG */
+    uint32_t fill;              /* Muestras acumuladas (hasta window) */
+    uint32_t head;              /* Próxima posición del buffer circular */
+    double sum;
+    double *ring;               /* Últimas window muestras */
+    double prev;                /* Muestra anterior (FEATURE_RATE) */
+    double prev_t;
+} rule_feature_t;
+
+/* Acción de un flanco: encender o apagar un actuador, con retardo opcional */
+typedef struct {
+    uint32_t actuator;
+    bool on;
+    uint64_t delay;             /* Ticks; 0 = inmediato */
+} rule_action_t;
+
+typedef struct {
+    /* Actuadores declarados en la configuración */
+    size_t nactuators;
+    char (*names)[RULES_NAME_MAX];
+    Actuator *actuators;
+    arena_t arena;              /* params de los actuadores */
+    ActuatorAction *pending;    /* Una acción diferida por actuador: la última gana */
+
+    /* Características y sus valores del tick actual */
+    size_t nfeatures;
+    rule_feature_t *features;
+    double *feat;
+
+    /* Reglas compiladas (una entrada por regla en cada arreglo) */
+    size_t nrules;
+    uint32_t *fidx;             /* Característica que usa */
+    double *sign;               /* +1 para >=, -1 para <= */
+    double *on;
+    double *off;
+    uint8_t *state;
+    uint32_t *rise;             /* Primera acción del flanco de subida */
+    uint32_t *nrise;
+    uint32_t *fall;             /* Primera acción del flanco de bajada */
+    uint32_t *nfall;
+    uint32_t *edges;            /* Reglas con flanco en el tick actual */
+
+    size_t nactions;
+    rule_action_t *actions;
+
+    size_t channels;            /* Canales que esperan las reglas */
+    timer_wheel_t wheel;
+    bool started;
+    double t0;                  /* Tiempo de la primera evaluación */
+} rules_t;
+
+/* Compila reglas desde texto; en error deja un mensaje en err y retorna false.
+ *
+ *   actuator <nombre> led|buzzer|none
+ *   rule <canal> raw|rate|avg<N> >=|<= <on> [<off>] : <acciones> : <acciones>
+ *
+ * Las acciones (separadas por espacios) son <actuador>=on|off[@segundos]; las
+ * primeras se ejecutan al activarse la regla y las segundas al desactivarse.
+ * Cualquier acción sobre un actuador cancela su acción diferida pendiente. */
+extern bool rules_parse(rules_t *r, const char *text, char *err, size_t errlen);
+
+/* Igual que rules_parse, leyendo el archivo path */
+extern bool rules_load(rules_t *r, const char *path, char *err, size_t errlen);
+
+/* Texto completo del archivo path (se libera con free); NULL y mensaje en
+ * err si no se pudo leer o está vacío */
+extern char *rules_read_file(const char *path, char *err, size_t errlen);
+
+/* Evalúa todas las reglas en el tiempo t (segundos) con un valor por canal.
+ * Devuelve cuántas reglas cambiaron de estado. */
+extern size_t rules_eval(rules_t *r, double t, const double *values);
+
+/* Libera todo, actuadores incluidos */
+extern void rules_free(rules_t *r);
+
+#endif /* RULES_H */
@@ -0,0 +1,163 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rt.h"
+#include "trace.h"
+
+/* Buffer de escritura: una llamada al sistema cada 32768 registros */
+#define TRACE_BUFFER ((size_t)1 << 20)
+
+/* Hilo de fondo: vacía la cola en el archivo; si no hay nada espera 1 ms */
+static void *writer(void *arg) {
+    trace_writer_t *w = arg;
+    trace_record_t rec;
+
+    for (;;) {
+        bool stopping = atomic_load_explicit(&w->stop, memory_order_acquire);
+        size_t n = 0;
+        while (spsc_pop(&w->ring, &rec)) {
+            fwrite(&rec, sizeof(rec), 1, w->f);
+            n++;
+        }
+        if (stopping && n == 0) break;
+        if (n == 0) {
+            struct timespec pause = {0, 1000000};
+            fflush(w->f);
+            nanosleep(&pause, NULL);
+        }
+    }
+    return NULL;
+}
+
+/* Hilo de control: la traza no descarta, así que con la cola llena espera
+ * (100 µs por vuelta) a que el hilo de fondo haga lugar */
+static void push(trace_writer_t *w, const trace_record_t *rec) {
+    if (spsc_push(&w->ring, rec)) return;
+    w->stalls++;
+    struct timespec pause = {0, 100000};
+    while (!spsc_push(&w->ring, rec)) nanosleep(&pause, NULL);
+}
+
+bool trace_open(trace_writer_t *w, const char *path, double threshold,
+                const char *filter, bool fixed, const char *rules_text,
+                const char *const *names, size_t nactuators) {
+    memset(w, 0, sizeof(*w));
+    atomic_init(&w->stop, false);
+    if (filter && strlen(filter) >= TRACE_SPEC_MAX) return false;    /* No entra en el header */
+    if (nactuators > EVLOG_MAX_ACTUATORS) nactuators = EVLOG_MAX_ACTUATORS;
+
+    trace_header_t *h = &w->header;
+    memcpy(h->magic, TRACE_MAGIC, sizeof(h->magic));
+    h->version = TRACE_VERSION;
+    h->record_size = sizeof(trace_record_t);
+    h->nactuators = (uint32_t)nactuators;
+    h->rules_len = rules_text ? (uint32_t)strlen(rules_text) : 0;
+    h->threshold = threshold;
+    h->fixed = fixed;
+    if (filter) memcpy(h->filter, filter, strlen(filter) + 1);
+    for (size_t i = 0; i < nactuators; i++) {
+        strncpy(h->names[i], names[i], EVLOG_NAME_MAX - 1);
+    }
+
+    w->f = fopen(path, "wb");
+    if (!w->f) return false;
+    w->buf = malloc(TRACE_BUFFER);
+    if (w->buf) setvbuf(w->f, w->buf, _IOFBF, TRACE_BUFFER);
+    fwrite(h, sizeof(*h), 1, w->f);
+    if (h->rules_len) fwrite(rules_text, 1, h->rules_len, w->f);
+
+    if (!spsc_init(&w->ring, sizeof(trace_record_t), TRACE_QUEUE)) {
+        fclose(w->f);
+        free(w->buf);
+        return false;
+    }
+    if (pthread_create(&w->thread, NULL, writer, w) != 0) {
+        spsc_free(&w->ring);
+        fclose(w->f);
+        free(w->buf);
+        return false;
+    }
+    w->start_ns = rt_now_ns();
+    return true;
+}
+
+void trace_sample(trace_writer_t *w, double t, double value, uint16_t states) {
+    trace_record_t rec;
+    rec.mono_ns = rt_now_ns() - w->start_ns;
+    rec.t = t;
+    rec.value = value;
+    rec.seq = w->seq++;
+    rec.kind = TRACE_INPUT;
+    rec.states = 0;
+    push(w, &rec);
+    w->inputs++;
+
+    if (states != w->states) {
+        rec.value = 0.0;
+        rec.kind = TRACE_OUTPUT;
+        rec.states = states;
+        push(w, &rec);
+        w->states = states;
+        w->outputs++;
+    }
+}
+
+void trace_close(trace_writer_t *w) {
+    atomic_store_explicit(&w->stop, true, memory_order_release);
+    pthread_join(w->thread, NULL);
+    spsc_free(&w->ring);
+    bool ok = fclose(w->f) == 0;
+    free(w->buf);
+    fprintf(stderr, "[TRACE] %lu entradas y %lu transiciones grabadas%s\n",
+            w->inputs, w->outputs, ok ? "" : " (error al escribir)");
+    if (w->stalls) {
+        fprintf(stderr, "[TRACE] %lu esperas por cola llena\n", w->stalls);
+    }
+}
+
+bool trace_reader_open(trace_reader_t *r, const char *path, char *err, size_t errlen) {
+    memset(r, 0, sizeof(*r));
+    r->f = fopen(path, "rb");
+    if (!r->f) {
+        snprintf(err, errlen, "no se pudo abrir %s", path);
+        return false;
+    }
+
+    trace_header_t *h = &r->header;
+    if (fread(h, sizeof(*h), 1, r->f) != 1 || memcmp(h->magic, TRACE_MAGIC, sizeof(h->magic)) != 0) {
+        snprintf(err, errlen, "%s no es una traza", path);
+        trace_reader_close(r);
+        return false;
+    }
+    if (h->version != TRACE_VERSION || h->record_size != sizeof(trace_record_t) ||
+        h->nactuators > EVLOG_MAX_ACTUATORS) {
+        snprintf(err, errlen, "versión %u / registro de %u bytes no soportados", h->version, h->record_size);
+        trace_reader_close(r);
+        return false;
+    }
+    h->filter[TRACE_SPEC_MAX - 1] = '\0';
+
+    if (h->rules_len) {
+        r->rules_text = malloc((size_t)h->rules_len + 1);
+        if (!r->rules_text || fread(r->rules_text, 1, h->rules_len, r->f) != h->rules_len) {
+            snprintf(err, errlen, "%s está truncada", path);
+            trace_reader_close(r);
+            return false;
+        }
+        r->rules_text[h->rules_len] = '\0';
+    }
+    setvbuf(r->f, NULL, _IOFBF, TRACE_BUFFER);
+    return true;
+}
+
+size_t trace_read(trace_reader_t *r, trace_record_t *buf, size_t n) {
+    return fread(buf, sizeof(*buf), n, r->f);
+}
+
+void trace_reader_close(trace_reader_t *r) {
+    if (r->f) fclose(r->f);
+    free(r->rules_text);
+    r->f = NULL;
+    r->rules_text = NULL;
+}
@@ -0,0 +1,103 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "../common/event_log.h"
+#include "../common/spsc_ring.h"
+
+/* Traza binaria de una corrida completa: cada entrada del sensor (valor
+ * crudo, antes de los filtros) con su instante monotónico y el reloj que vio
+ * la lógica, y cada transición de los actuadores. Como en el log de eventos,
+ * el hilo de control solo encola registros en una cola SPSC y un hilo de
+ * fondo los escribe, así que no hay llamadas al sistema en el bucle (ni en
+ * --rt). A diferencia del log no se descarta nada, para poder reproducir la
+ * corrida exactamente: si la cola se llena, el hilo de control espera a que
+ * el de fondo la vacíe y la espera se cuenta.
+ *
+ * El header guarda la configuración de la lógica (umbral, filtros y el texto
+ * de las reglas), así que la traza alcanza sola para repetir la corrida. */
+
+#define TRACE_MAGIC   "CTLTRC1\n"
+#define TRACE_VERSION 1
+#define TRACE_SPEC_MAX 128
+#define TRACE_QUEUE    65536    /* Registros en la cola (2 MB) */
+
+typedef enum {
+    TRACE_INPUT  = 1,           /* Muestra del sensor */
+    TRACE_OUTPUT = 2            /* Nuevo estado de los actuadores tras la muestra seq */
+} trace_kind_t;
+
+/* Registro de 32 bytes; en TRACE_OUTPUT, value no se usa */
+typedef struct {
+    uint64_t mono_ns;           /* Reloj monotónico desde el inicio de la grabación */
+    double t;                   /* Reloj del controlador (segundos) */
+    double value;               /* Valor crudo del sensor */
+    uint32_t seq;               /* Número de muestra */
+    uint16_t kind;
+    uint16_t states;            /* Bit i = actuador i del header */
+} trace_record_t;
+
+/* Header del archivo; le siguen rules_len bytes con el texto de las reglas */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t nactuators;
+    uint32_t rules_len;         /* 0 = umbral fijo */
+    double threshold;
+    uint8_t fixed;              /* Filtros en punto fijo Q15 */
+    uint8_t reserved[7];
+    char filter[TRACE_SPEC_MAX];    /* Cadena de --filter, vacía si no hay */
+    char names[EVLOG_MAX_ACTUATORS][EVLOG_NAME_MAX];
+} trace_header_t;
+
+typedef struct {
+    FILE *f;
+    char *buf;                  /* Buffer de escritura (solo el hilo de fondo) */
+    spsc_ring_t ring;
+    pthread_t thread;
+    atomic_bool stop;
+    unsigned long stalls;       /* Veces que el hilo de control esperó cola llena */
+    uint64_t start_ns;
+    uint32_t seq;
+    uint16_t states;            /* Último estado grabado */
+    unsigned long inputs;
+    unsigned long outputs;
+    trace_header_t header;
+} trace_writer_t;
+
+/* Crea la traza en path con la configuración de la lógica y arranca el hilo
+ * de fondo; rules_text NULL con el umbral fijo y filter NULL sin filtros.
+ * false si no se pudo o si filter no entra en el header (TRACE_SPEC_MAX). */
+extern bool trace_open(trace_writer_t *w, const char *path, double threshold,
+                       const char *filter, bool fixed, const char *rules_text,
+                       const char *const *names, size_t nactuators);
+
+/* Una muestra procesada: valor crudo, reloj de la lógica y estado de los
+ * actuadores después del paso (se graba una transición si cambió) */
+extern void trace_sample(trace_writer_t *w, double t, double value, uint16_t states);
+
+/* Vacía la cola, detiene el hilo, cierra el archivo e informa en stderr */
+extern void trace_close(trace_writer_t *w);
+
+/* Lectura secuencial de una traza */
+typedef struct {
+    FILE *f;
+    trace_header_t header;
+    char *rules_text;           /* NULL con el umbral fijo */
+} trace_reader_t;
+
+/* Abre y valida la traza; en error deja un mensaje en err */
+extern bool trace_reader_open(trace_reader_t *r, const char *path, char *err, size_t errlen);
+
+/* Lee hasta n registros; 0 al final */
+extern size_t trace_read(trace_reader_t *r, trace_record_t *buf, size_t n);
+
+extern void trace_reader_close(trace_reader_t *r);
+
+#endif /* TRACE_H */
@@ -0,0 +1,275 @@
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "csv.h"
+
+/* Ventana de mapeo: en 64 bits se mapea todo el archivo de una vez;
+ * en 32 bits se avanza en ventanas para no agotar el espacio de direcciones */
+#define CSV_WINDOW_32 ((size_t)64 << 20)
+
+/* Potencias de 10 exactas en double (camino rápido de Clinger) */
+static const double pow10_exact[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Caso raro (más de 19 dígitos, exponentes grandes, nan/inf): se delega en strtod */
+static double parse_slow(const char *start, const char *end, const char **next) {
+    char buf[128];
+    size_t len = (size_t)(end - start);
+    if (len >= sizeof(buf)) len = sizeof(buf) - 1;
+    memcpy(buf, start, len);
+    buf[len] = '\0';
+
+    char *stop;
+    double v = strtod(buf, &stop);
+    *next = start + (stop - buf);
+    return v;
+}
+
+double csv_parse_double(const char **pp, const char *end) {
+    const char *p = *pp;
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    const char *start = p;
+
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        neg = (*p == '-');
+        p++;
+    }
+
+    uint64_t mant = 0;      /* Hasta 19 dígitos significativos */
+    int digits = 0;
+    int exp10 = 0;
+    bool any = false;       /* Se leyó al menos un dígito */
+
+    while (p < end && (unsigned)(*p - '0') < 10) {
+        any = true;
+        if (digits < 19) {
+            mant = mant * 10 + (uint64_t)(*p - '0');
+            if (mant) digits++;                 /* Los ceros a la izquierda no cuentan */
+        } else {
+            exp10++;
+        }
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && (unsigned)(*p - '0') < 10) {
+            any = true;
+            if (digits < 19) {
+                mant = mant * 10 + (uint64_t)(*p - '0');
+                if (mant) digits++;
+                exp10--;
+            }
+            p++;
+        }
+    }
+    if (!any) {
+        /* Sin dígitos: nan/inf o basura (atof devolvía 0.0) */
+        return parse_slow(start, end, pp);
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool eneg = false;
+        int e = 0;
+        if (q < end && (*q == '-' || *q == '+')) {
+            eneg = (*q == '-');
+            q++;
+        }
+        if (q < end && (unsigned)(*q - '0') < 10) {
+            while (q < end && (unsigned)(*q - '0') < 10) {
+                if (e < 10000) e = e * 10 + (*q - '0');
+                q++;
+            }
+            exp10 += eneg ? -e : e;
+            p = q;
+        }
+    }
+
+    double v;
+    if (mant < ((uint64_t)1 << 53) && exp10 >= -22 && exp10 <= 22) {
+        /* Mantisa y potencia exactas: una sola operación, resultado bien redondeado */
+        v = exp10 < 0 ? (double)mant / pow10_exact[-exp10] : (double)mant * pow10_exact[exp10];
+        *pp = p;
+        return neg ? -v : v;
+    }
+    return parse_slow(start, p, pp);
+}
+
+/* Mapea la ventana que contiene el offset absoluto off y deja el cursor ahí */
+static bool map_at(csv_reader_t *r, off_t off) {
+    long page = sysconf(_SC_PAGESIZE);
+    off_t aligned = off - off % page;
+    size_t len = r->window;
+
+    if (r->map) munmap((void *)r->map, r->map_len);
+    r->map = NULL;
+    r->map_len = 0;
+    r->map_off = aligned;
+    r->pos = (size_t)(off - aligned);
+
+    if ((off_t)len > r->file_size - aligned) len = (size_t)(r->file_size - aligned);
+    if (len == 0) return true;                      /* Fin del archivo */
+
+    void *m = mmap(NULL, len, PROT_READ, MAP_PRIVATE, r->fd, aligned);
+    if (m == MAP_FAILED) return false;
+    posix_madvise(m, len, POSIX_MADV_SEQUENTIAL);    /* Lectura anticipada agresiva */
+    r->map = m;
+    r->map_len = len;
+    return true;
+}
+
+/* Siguiente línea [*start, *end) sin el '\n'; false al llegar al final */
+static bool next_line(csv_reader_t *r, const char **start, const char **end) {
+    for (;;) {
+        if (r->map_off + (off_t)r->pos >= r->file_size) return false;
+
+        const char *s = r->map + r->pos;
+        size_t avail = r->map_len - r->pos;
+        const char *nl = memchr(s, '\n', avail);
+        if (nl) {
+            *start = s;
+            *end = nl;
+            r->pos += (size_t)(nl - s) + 1;
+            return true;
+        }
+        if (r->map_off + (off_t)r->map_len >= r->file_size) {
+            /* Última línea sin '\n' */
+            *start = s;
+            *end = s + avail;
+            r->pos = r->map_len;
+            return true;
+        }
+        /* La línea cruza el final de la ventana: se remapea desde su inicio.
+         * Si ni siquiera cabe en una ventana entera, la ventana se duplica. */
+        if (r->pos < (size_t)sysconf(_SC_PAGESIZE)) r->window *= 2;
+        if (!map_at(r, r->map_off + (off_t)r->pos)) return false;
+    }
+}
+
+bool csv_open(csv_reader_t *r, const char *path) {
+    struct stat st;
+
+    memset(r, 0, sizeof(*r));
+    r->fd = open(path, O_RDONLY);
+    if (r->fd < 0) return false;
+    if (fstat(r->fd, &st) != 0) {
+        close(r->fd);
+        return false;
+    }
+    r->file_size = st.st_size;
+    r->window = sizeof(void *) >= 8 ? (size_t)st.st_size : CSV_WINDOW_32;
+    if (r->window < 4096) r->window = 4096;
+
+    return csv_rewind(r);
+}
+
+bool csv_rewind(csv_reader_t *r) {
+    const char *s, *e;
+    if (!map_at(r, 0)) {
+        csv_close(r);
+        return false;
+    }
+    r->columns = 0;
+    if (next_line(r, &s, &e)) {                     /* Saltar header, contando columnas */
+        r->columns = 1;
+        for (const char *c = s; (c = memchr(c, ',', (size_t)(e - c))) != NULL; c++) r->columns++;
+    }
+    return true;
+}
+
+bool csv_next_row(csv_reader_t *r, double *ts, double *value) {
+    const char *s, *e;
+    while (next_line(r, &s, &e)) {
+        const char *comma = memchr(s, ',', (size_t)(e - s));
+        if (!comma) continue;                       /* Igual que antes: filas sin coma se ignoran */
+        const char *p = s;
+        *ts = csv_parse_double(&p, comma);
+        p = comma + 1;
+        *value = csv_parse_double(&p, e);
+        return true;
+    }
+    return false;
+}
+
+size_t csv_next_fields(csv_reader_t *r, double *fields, size_t max) {
+    const char *s, *e;
+    while (next_line(r, &s, &e)) {
+        if (!memchr(s, ',', (size_t)(e - s))) continue;
+        size_t n = 0;
+        const char *p = s;
+        for (;;) {
+            const char *comma = memchr(p, ',', (size_t)(e - p));
+            const char *stop = comma ? comma : e;
+            if (n < max) fields[n] = csv_parse_double(&p, stop);
+            n++;
+            if (!comma) break;
+            p = comma + 1;
+        }
+        for (size_t i = n; i < max; i++) fields[i] = 0.0;
+        return n;
+    }
+    return 0;
+}
+
+void csv_close(csv_reader_t *r) {
+    if (r->map) munmap((void *)r->map, r->map_len);
+    if (r->fd >= 0) close(r->fd);
+    r->map = NULL;
+    r->map_len = 0;
+    r->fd = -1;
+}
+
+bool csv_load_values(const char *path, double **values, double **timestamps, size_t *count) {
+    csv_reader_t r;
+    double ts, v;
+    size_t cap, n = 0;
+    double *buf, *tbuf = NULL;
+    bool ok = true;
+
+    *values = NULL;
+    if (timestamps) *timestamps = NULL;
+    *count = 0;
+    if (!csv_open(&r, path)) return false;
+
+    /* Estimación inicial por tamaño; los arreglos crecen si hace falta */
+    cap = (size_t)(r.file_size / 16) + 16;
+    buf = malloc(cap * sizeof(double));
+    if (timestamps) tbuf = malloc(cap * sizeof(double));
+    ok = buf && (!timestamps || tbuf);
+    while (ok && csv_next_row(&r, &ts, &v)) {
+        if (n == cap) {
+            double *bigger = realloc(buf, cap * 2 * sizeof(double));
+            if (bigger) buf = bigger;
+            if (bigger && timestamps) {
+                bigger = realloc(tbuf, cap * 2 * sizeof(double));
+                if (bigger) tbuf = bigger;
+            }
+            if (!bigger) {
+                ok = false;
+                break;
+            }
+            cap *= 2;
+        }
+        buf[n] = v;
+        if (tbuf) tbuf[n] = ts;
+        n++;
+    }
+    csv_close(&r);
+
+    if (!ok) {
+        free(buf);
+        free(tbuf);
+        return false;
+    }
+    *values = buf;
+    if (timestamps) *timestamps = tbuf;
+    *count = n;
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef CSV_H
+#define CSV_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+/* Lector de CSV sobre mmap: recorre el archivo una sola vez, sin límite de
+ * largo de línea. El archivo se mapea por ventanas, así que también funciona
+ * con archivos de varios GB en ctl32. */
+typedef struct {
+    int fd;                 /* Descriptor del archivo */
+    off_t file_size;        /* Tamaño total del archivo */
+    off_t map_off;          /* Offset del mapeo actual (alineado a página) */
+    size_t map_len;         /* Bytes mapeados */
+    const char *map;        /* Ventana mapeada */
+    size_t pos;             /* Posición del cursor dentro de la ventana */
+    size_t window;          /* Tamaño de ventana deseado */
+    size_t columns;         /* Columnas del header (incluye el timestamp) */
+} csv_reader_t;
+
+/* Abre el archivo y salta el header; false si no se pudo abrir */
+extern bool csv_open(csv_reader_t *r, const char *path);
+
+/* Lee la siguiente fila: primera columna en *ts y segunda en *value.
+ * Las filas sin coma se saltan (igual que el cargador original). */
+extern bool csv_next_row(csv_reader_t *r, double *ts, double *value);
+
+/* Lee la siguiente fila completa: hasta max columnas en fields (la primera
+ * es el timestamp). Devuelve cuántas columnas tenía la fila (0 al final);
+ * las que falten hasta max quedan en 0.0. Las filas sin coma se saltan. */
+extern size_t csv_next_fields(csv_reader_t *r, double *fields, size_t max);
+
+/* Vuelve al inicio de los datos (después del header) */
+extern bool csv_rewind(csv_reader_t *r);
+
+/* Cierra el archivo y libera el mapeo */
+extern void csv_close(csv_reader_t *r);
+
+/* Carga todos los valores (y opcionalmente los timestamps, si timestamps no
+ * es NULL) en arreglos que crecen según hace falta. Retorna false si no se
+ * pudo abrir; los arreglos se liberan con free(). */
+extern bool csv_load_values(const char *path, double **values, double **timestamps, size_t *count);
+
+/* Parser de double rápido sobre [p, end): avanza *p hasta el fin del número */
+extern double csv_parse_double(const char **p, const char *end);
+
+#endif /* CSV_H */
@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "sensor.h"
+#include "csv.h"
+
+/* Estructura interna de la fuente CSV: cargada en memoria o en streaming */
+typedef struct {
+    bool stream;
+    csv_reader_t reader;        /* Streaming */
+    double *values;             /* Cargado */
+    double *timestamps;
+    size_t count;
+    size_t next;
+} CsvParams;
+
+static size_t csv_read_batch(void *params, sensor_sample_t *buf, size_t n) {
+    CsvParams *cp = (CsvParams *) params;
+    size_t got = 0;
+
+    if (cp->stream) {
+        while (got < n && csv_next_row(&cp->reader, &buf[got].t, &buf[got].value)) got++;
+        return got;
+    }
+    while (got < n && cp->next < cp->count) {
+        buf[got].t = cp->timestamps[cp->next];
+        buf[got].value = cp->values[cp->next];
+        cp->next++;
+        got++;
+    }
+    return got;
+}
+
+static bool csv_eof(void *params) {
+    CsvParams *cp = (CsvParams *) params;
+    if (cp->stream) return cp->reader.map_off + (off_t)cp->reader.pos >= cp->reader.file_size;
+    return cp->next >= cp->count;
+}
+
+static void csv_reset(void *params) {
+    CsvParams *cp = (CsvParams *) params;
+    if (cp->stream) csv_rewind(&cp->reader);
+    else cp->next = 0;
+}
+
+static int csv_fd(void *params) {
+    (void)params;
+    return -1;
+}
+
+static void csv_close_sensor(void *params) {
+    CsvParams *cp = (CsvParams *) params;
+    if (cp->stream) csv_close(&cp->reader);
+    free(cp->values);
+    free(cp->timestamps);
+}
+
+/* Función de fábrica: CSV cargado completo (una pasada sobre el archivo
+ * mapeado) o leído fila por fila en streaming */
+Sensor create_csv_sensor(arena_t *arena, const char *path, bool stream) {
+    Sensor sensor = {
+        .params = NULL,
+        .name = stream ? "CSV (streaming)" : "CSV",
+        .live = false,
+        .read_batch = csv_read_batch,
+        .eof = csv_eof,
+        .reset = csv_reset,
+        .fd = csv_fd,
+        .close = csv_close_sensor
+    };
+    CsvParams *cp = (CsvParams *) arena_alloc(arena, sizeof(CsvParams));
+    if (!cp) return sensor;
+    cp->stream = stream;
+
+    if (stream) {
+        if (!csv_open(&cp->reader, path)) {
+            printf("[SENSOR] Error: No se pudo abrir el archivo %s\n", path);
+            return sensor;
+        }
+    } else {
+        if (!csv_load_values(path, &cp->values, &cp->timestamps, &cp->count)) {
+            printf("[SENSOR] Error: No se pudo abrir el archivo %s\n", path);
+            return sensor;
+        }
+        if (cp->count == 0) {
+            printf("[SENSOR] Error: El archivo CSV no contiene datos válidos\n");
+            csv_close_sensor(cp);
+            return sensor;
+        }
+        printf("[SENSOR] Cargados %zu valores desde %s\n", cp->count, path);
+    }
+    sensor.params = cp;
+    return sensor;
+}
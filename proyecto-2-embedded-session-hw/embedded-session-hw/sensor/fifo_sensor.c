@@ -0,0 +1,118 @@
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "sensor.h"
+#include "csv.h"
+#include "../controller/rt.h"
+
+#define FIFO_BUF 65536
+
+/* Estructura interna de la fuente FIFO: líneas de texto "timestamp,valor"
+ * o solo "valor" (se estampa con la hora de llegada) */
+typedef struct {
+    int fd;
+    int keep;                   /* Extremo de escritura propio: sin él, el
+                                   último productor al cerrar dejaría la FIFO
+                                   en EOF permanente */
+    size_t len;                 /* Bytes pendientes en buf (línea incompleta) */
+    char buf[FIFO_BUF];
+} FifoParams;
+
+/* Parsea las líneas completas de buf; deja la parte incompleta al inicio */
+static size_t parse_lines(FifoParams *fp, sensor_sample_t *buf, size_t n) {
+    const char *p = fp->buf;
+    const char *end = fp->buf + fp->len;
+    size_t got = 0;
+
+    while (got < n) {
+        const char *nl = memchr(p, '\n', (size_t)(end - p));
+        if (!nl) break;
+        const char *comma = memchr(p, ',', (size_t)(nl - p));
+        const char *q = p;
+        double first = csv_parse_double(&q, comma ? comma : nl);
+        if (q != p) {                               /* Las líneas sin número (header) se saltan */
+            if (comma) {
+                q = comma + 1;
+                buf[got].t = first;
+                buf[got].value = csv_parse_double(&q, nl);
+            } else {
+                buf[got].t = rt_now_ns() / 1e9;
+                buf[got].value = first;
+            }
+            got++;
+        }
+        p = nl + 1;
+    }
+    fp->len = (size_t)(end - p);
+    memmove(fp->buf, p, fp->len);
+    return got;
+}
+
+static size_t fifo_read_batch(void *params, sensor_sample_t *buf, size_t n) {
+    FifoParams *fp = (FifoParams *) params;
+    size_t got = parse_lines(fp, buf, n);
+
+    while (got < n) {
+        if (fp->len == sizeof(fp->buf)) fp->len = 0;    /* Línea absurda: se descarta */
+        ssize_t r = read(fp->fd, fp->buf + fp->len, sizeof(fp->buf) - fp->len);
+        if (r <= 0) break;                              /* EAGAIN: no hay más por ahora */
+        fp->len += (size_t)r;
+        got += parse_lines(fp, buf + got, n - got);
+    }
+    return got;
+}
+
+static bool fifo_eof(void *params) {
+    (void)params;
+    return false;
+}
+
+static void fifo_reset(void *params) {
+    (void)params;
+}
+
+static int fifo_fd(void *params) {
+    return ((FifoParams *) params)->fd;
+}
+
+static void fifo_close(void *params) {
+    FifoParams *fp = (FifoParams *) params;
+    close(fp->fd);
+    close(fp->keep);
+}
+
+/* Función de fábrica: crea la FIFO si no existe y la abre sin bloqueo */
+Sensor create_fifo_sensor(arena_t *arena, const char *path) {
+    Sensor sensor = {
+        .params = NULL,
+        .name = "FIFO",
+        .live = true,
+        .read_batch = fifo_read_batch,
+        .eof = fifo_eof,
+        .reset = fifo_reset,
+        .fd = fifo_fd,
+        .close = fifo_close
+    };
+
+    if (mkfifo(path, 0666) != 0 && errno != EEXIST) {
+        printf("[SENSOR] Error: No se pudo crear la FIFO %s: %s\n", path, strerror(errno));
+        return sensor;
+    }
+    FifoParams *fp = (FifoParams *) arena_alloc(arena, sizeof(FifoParams));
+    if (!fp) return sensor;
+    fp->fd = open(path, O_RDONLY | O_NONBLOCK);
+    fp->keep = fp->fd >= 0 ? open(path, O_WRONLY | O_NONBLOCK) : -1;
+    if (fp->keep < 0) {
+        printf("[SENSOR] Error: No se pudo abrir la FIFO %s: %s\n", path, strerror(errno));
+        if (fp->fd >= 0) close(fp->fd);
+        return sensor;
+    }
+    printf("[SENSOR] Escuchando FIFO %s\n", path);
+    sensor.params = fp;
+    return sensor;
+}
@@ -0,0 +1,314 @@
+#include <string.h>
+#include "filter.h"
+#include "../common/spec.h"
+
+#define RECIP_BITS 24
+
+int32_t filter_to_q(double x) {
+    double q = x * FILTER_ONE;
+    if (q >= (double)INT32_MAX) return INT32_MAX;
+    if (q <= (double)INT32_MIN) return INT32_MIN;
+    return (int32_t)(q < 0.0 ? q - 0.5 : q + 0.5);
+}
+
+/* Promedio móvil */
+
+void filter_avg_init(filter_avg_t *f, uint32_t n) {
+    f->n = n;
+    f->fill = 0;
+    f->head = 0;
+    f->sum = 0.0;
+}
+
+double filter_avg_step(filter_avg_t *f, double x) {
+    if (f->fill == f->n) f->sum -= f->ring[f->head];
+    else f->fill++;
+    f->sum += x;
+    f->ring[f->head] = x;
+    if (++f->head == f->n) {
+        /* Una vez por vuelta se recalcula la suma: O(1) amortizado y el
+         * error de redondeo no se acumula */
+        f->head = 0;
+        double sum = 0.0;
+        for (uint32_t i = 0; i < f->fill; i++) sum += f->ring[i];
+        f->sum = sum;
+    }
+    return f->sum / f->fill;
+}
+
+void filter_avg_q_init(filter_avg_q_t *f, uint32_t n) {
+    f->n = n;
+    f->fill = 0;
+    f->head = 0;
+    f->sum = 0;
+    f->recip = 0;
+}
+
+int32_t filter_avg_q_step(filter_avg_q_t *f, int32_t x) {
+    if (f->fill == f->n) {
+        f->sum -= f->ring[f->head];
+    } else {
+        f->fill++;
+        f->recip = (((int64_t)1 << RECIP_BITS) + f->fill / 2) / f->fill;  /* Solo al llenarse */
+    }
+    f->sum += x;                /* Exacta en enteros: no hace falta recalcularla */
+    f->ring[f->head] = x;
+    if (++f->head == f->n) f->head = 0;
+    return (int32_t)((f->sum * f->recip + ((int64_t)1 << (RECIP_BITS - 1))) >> RECIP_BITS);
+}
+
+/* Mediana móvil. Índices relativos a la mediana: i < 0 montículo de
+ * máximos, i > 0 de mínimos; los hijos de i son 2i y 2i ± 1. */
+
+#define HEAP(m, i) ((m)->heap[(m)->n / 2 + (i)])
+
+static inline bool heap_less(const filter_median_t *m, int i, int j) {
+    return m->key[HEAP(m, i)] < m->key[HEAP(m, j)];
+}
+
+/* Intercambia i y j si heap[i] < heap[j]; true si los intercambió */
+static bool heap_cmp_exchange(filter_median_t *m, int i, int j) {
+    if (!heap_less(m, i, j)) return false;
+    int16_t t = HEAP(m, i);
+    HEAP(m, i) = HEAP(m, j);
+    HEAP(m, j) = t;
+    m->pos[HEAP(m, i)] = (int16_t)i;
+    m->pos[HEAP(m, j)] = (int16_t)j;
+    return true;
+}
+
+static void min_sort_down(filter_median_t *m, int i) {
+    int count = (m->ct - 1) / 2;
+    for (; i <= count; i *= 2) {
+        if (i > 1 && i < count && heap_less(m, i + 1, i)) i++;
+        if (!heap_cmp_exchange(m, i, i / 2)) break;
+    }
+}
+
+static void max_sort_down(filter_median_t *m, int i) {
+    int count = m->ct / 2;
+    for (; i >= -count; i *= 2) {
+        if (i < -1 && i > -count && heap_less(m, i, i - 1)) i--;
+        if (!heap_cmp_exchange(m, i / 2, i)) break;
+    }
+}
+
+/* Suben hacia la mediana; true si llegaron a ella */
+static bool min_sort_up(filter_median_t *m, int i) {
+    while (i > 0 && heap_cmp_exchange(m, i, i / 2)) i /= 2;
+    return i == 0;
+}
+
+static bool max_sort_up(filter_median_t *m, int i) {
+    while (i < 0 && heap_cmp_exchange(m, i / 2, i)) i /= 2;
+    return i == 0;
+}
+
+static int64_t median_push(filter_median_t *m, int64_t v) {
+    bool is_new = m->ct < m->n;
+    int p = m->pos[m->idx];
+    int64_t old = m->key[m->idx];
+
+    m->key[m->idx] = v;
+    if (++m->idx == m->n) m->idx = 0;
+    m->ct += is_new;
+
+    if (p > 0) {
+        if (!is_new && old < v) min_sort_down(m, p * 2);
+        else if (min_sort_up(m, p)) max_sort_down(m, -1);
+    } else if (p < 0) {
+        if (!is_new && v < old) max_sort_down(m, p * 2);
+        else if (max_sort_up(m, p)) min_sort_down(m, 1);
+    } else {
+        if (m->ct / 2) max_sort_down(m, -1);
+        if ((m->ct - 1) / 2) min_sort_down(m, 1);
+    }
+    return m->key[HEAP(m, 0)];
+}
+
+void filter_median_init(filter_median_t *f, uint32_t n) {
+    f->n = (uint16_t)n;
+    f->ct = 0;
+    f->idx = 0;
+    /* Orden de llenado: mediana, máximos, mínimos, máximos, ... */
+    for (int k = (int)n - 1; k >= 0; k--) {
+        f->pos[k] = (int16_t)(((k + 1) / 2) * ((k & 1) ? -1 : 1));
+        HEAP(f, f->pos[k]) = (int16_t)k;
+        f->key[k] = 0;
+    }
+}
+
+/* Clave entera con el mismo orden que los double (sin NaN): los negativos
+ * invierten sus 63 bits bajos */
+static inline int64_t double_key(double x) {
+    int64_t b;
+    memcpy(&b, &x, sizeof(b));
+    return b ^ ((b >> 63) & INT64_MAX);
+}
+
+static inline double key_double(int64_t k) {
+    int64_t b = k ^ ((k >> 63) & INT64_MAX);
+    double x;
+    memcpy(&x, &b, sizeof(x));
+    return x;
+}
+
+double filter_median_step(filter_median_t *f, double x) {
+    return key_double(median_push(f, double_key(x)));
+}
+
+int32_t filter_median_q_step(filter_median_t *f, int32_t x) {
+    return (int32_t)median_push(f, x);
+}
+
+/* EWMA */
+
+void filter_ewma_init(filter_ewma_t *f, double alpha) {
+    f->alpha = alpha;
+    f->y = 0.0;
+    f->init = false;
+}
+
+double filter_ewma_step(filter_ewma_t *f, double x) {
+    if (!f->init) {
+        f->y = x;               /* Arranca en la primera muestra, sin rampa desde 0 */
+        f->init = true;
+    }
+    f->y += f->alpha * (x - f->y);
+    return f->y;
+}
+
+void filter_ewma_q_init(filter_ewma_q_t *f, double alpha) {
+    f->alpha = filter_to_q(alpha);
+    f->y = 0;
+    f->init = false;
+}
+
+int32_t filter_ewma_q_step(filter_ewma_q_t *f, int32_t x) {
+    if (!f->init) {
+        f->y = x;
+        f->init = true;
+    }
+    f->y += (int32_t)(((int64_t)f->alpha * ((int64_t)x - f->y) + (FILTER_ONE / 2)) >> FILTER_Q);
+    return f->y;
+}
+
+/* Kalman 1-D */
+
+void filter_kalman_init(filter_kalman_t *f, double q, double r) {
+    f->q = q;
+    f->r = r;
+    f->x = 0.0;
+    f->p = r;
+    f->init = false;
+}
+
+double filter_kalman_step(filter_kalman_t *f, double z) {
+    if (!f->init) {
+        f->x = z;
+        f->init = true;
+        return z;
+    }
+    f->p += f->q;                           /* Predicción */
+    double k = f->p / (f->p + f->r);        /* Ganancia */
+    f->x += k * (z - f->x);                 /* Corrección */
+    f->p *= 1.0 - k;
+    return f->x;
+}
+
+void filter_kalman_q_init(filter_kalman_q_t *f, double q, double r) {
+    f->q = (int64_t)(q * FILTER_ONE + 0.5);
+    f->r = (int64_t)(r * FILTER_ONE + 0.5);
+    if (f->q < 1) f->q = 1;                 /* Con q = 0 la ganancia se apagaría */
+    f->p = f->r;
+    f->x = 0;
+    f->init = false;
+}
+
+int32_t filter_kalman_q_step(filter_kalman_q_t *f, int32_t z) {
+    if (!f->init) {
+        f->x = z;
+        f->init = true;
+        return z;
+    }
+    f->p += f->q;
+    int64_t k = (f->p << FILTER_Q) / (f->p + f->r);       /* Q15 en [0, 1) */
+    f->x += (int32_t)((k * ((int64_t)z - f->x) + (FILTER_ONE / 2)) >> FILTER_Q);
+    f->p = (f->p * (FILTER_ONE - k)) >> FILTER_Q;
+    if (f->p < 1) f->p = 1;
+    return f->x;
+}
+
+/* Cadena */
+
+bool filter_chain_parse(filter_chain_t *c, const char *spec, bool fixed, char *err, size_t errlen) {
+    spec_t sp;
+    if (!spec_open(&sp, spec, err, errlen)) return false;
+    c->n = 0;
+    c->fixed = fixed;
+
+    char *tok, *arg;
+    while ((tok = spec_next(&sp, ':', &arg))) {
+        const char *item = sp.item;
+        if (c->n == FILTER_MAX_STAGES) return spec_fail(err, errlen, item, "demasiadas etapas");
+        filter_t *f = &c->stage[c->n];
+        if (!arg) return spec_fail(err, errlen, item, "se esperaba nombre:parámetro");
+        double a, b;
+        if (!spec_values(&sp, arg, &a, &b, err, errlen)) return false;
+
+        if (strcmp(tok, "avg") == 0 || strcmp(tok, "median") == 0) {
+            bool median = tok[0] == 'm';
+            if (a < 1 || a > FILTER_MAX_WINDOW || a != (double)(uint32_t)a) {
+                return spec_fail(err, errlen, item, "ventana fuera de rango (1-256)");
+            }
+            if (median && (uint32_t)a % 2 == 0) {
+                return spec_fail(err, errlen, item, "la ventana de la mediana debe ser impar");
+            }
+            f->kind = median ? FILTER_MEDIAN : FILTER_AVG;
+            if (median) filter_median_init(&f->u.median, (uint32_t)a);
+            else if (fixed) filter_avg_q_init(&f->u.avg_q, (uint32_t)a);
+            else filter_avg_init(&f->u.avg, (uint32_t)a);
+        } else if (strcmp(tok, "ewma") == 0) {
+            if (!(a > 0.0 && a <= 1.0)) return spec_fail(err, errlen, item, "alfa debe estar en (0, 1]");
+            f->kind = FILTER_EWMA;
+            if (fixed) filter_ewma_q_init(&f->u.ewma_q, a);
+            else filter_ewma_init(&f->u.ewma, a);
+        } else if (strcmp(tok, "kalman") == 0) {
+            if (!(a >= 0.0 && b > 0.0)) return spec_fail(err, errlen, item, "se esperaba kalman:Q:R con Q >= 0 y R > 0");
+            f->kind = FILTER_KALMAN;
+            if (fixed) filter_kalman_q_init(&f->u.kalman_q, a, b);
+            else filter_kalman_init(&f->u.kalman, a, b);
+        } else {
+            return spec_fail(err, errlen, item, "filtro desconocido (avg, median, ewma, kalman)");
+        }
+        c->n++;
+    }
+    if (c->n == 0) return spec_fail(err, errlen, spec, "cadena vacía");
+    return true;
+}
+
+double filter_chain_apply(filter_chain_t *c, double x) {
+    if (c->fixed) {
+        int32_t q = filter_to_q(x);
+        for (size_t i = 0; i < c->n; i++) {
+            filter_t *f = &c->stage[i];
+            switch (f->kind) {
+            case FILTER_AVG: q = filter_avg_q_step(&f->u.avg_q, q); break;
+            case FILTER_MEDIAN: q = filter_median_q_step(&f->u.median, q); break;
+            case FILTER_EWMA: q = filter_ewma_q_step(&f->u.ewma_q, q); break;
+            case FILTER_KALMAN: q = filter_kalman_q_step(&f->u.kalman_q, q); break;
+            }
+        }
+        return filter_from_q(q);
+    }
+    for (size_t i = 0; i < c->n; i++) {
+        filter_t *f = &c->stage[i];
+        switch (f->kind) {
+        case FILTER_AVG: x = filter_avg_step(&f->u.avg, x); break;
+        case FILTER_MEDIAN: x = filter_median_step(&f->u.median, x); break;
+        case FILTER_EWMA: x = filter_ewma_step(&f->u.ewma, x); break;
+        case FILTER_KALMAN: x = filter_kalman_step(&f->u.kalman, x); break;
+        }
+    }
+    return x;
+}
@@ -0,0 +1,137 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Cadena de filtros entre el sensor y el controlador. Cada filtro cuesta
+ * O(1) por muestra (la mediana, O(log N)) y guarda su estado en un struct
+ * de tamaño fijo, sin memoria dinámica.
+ *
+ * Cada filtro tiene dos versiones: double y punto fijo. En punto fijo los
+ * valores son int32 con FILTER_Q bits fraccionarios (rango ±65536) y los
+ * coeficientes son Q15; los productos se acumulan en int64. ctl32 usa punto
+ * fijo (-DFILTER_FIXED) y ctl64, double. */
+
+#define FILTER_Q            15
+#define FILTER_ONE          (1 << FILTER_Q)
+#define FILTER_MAX_WINDOW   256     /* Ventana máxima de avg y median */
+#define FILTER_MAX_STAGES   8
+
+#ifdef FILTER_FIXED
+#define FILTER_DEFAULT_FIXED true
+#else
+#define FILTER_DEFAULT_FIXED false
+#endif
+
+typedef enum {
+    FILTER_AVG,                 /* Promedio móvil de N muestras */
+    FILTER_MEDIAN,              /* Mediana de las últimas N (N impar) */
+    FILTER_EWMA,                /* Pasa bajos de un polo: y += alfa (x - y) */
+    FILTER_KALMAN               /* Kalman 1-D de valor constante con ruido */
+} filter_kind_t;
+
+/* Promedio móvil: suma corrida sobre un buffer circular */
+typedef struct {
+    uint32_t n, fill, head;
+    double sum;
+    double ring[FILTER_MAX_WINDOW];
+} filter_avg_t;
+
+typedef struct {
+    uint32_t n, fill, head;
+    int64_t sum;
+    int64_t recip;              /* 2^24 / fill: dividir es multiplicar */
+    int32_t ring[FILTER_MAX_WINDOW];
+} filter_avg_q_t;
+
+/* Mediana móvil con dos montículos en un solo arreglo (máximos a la
+ * izquierda de la mediana, mínimos a la derecha): reemplazar la muestra más
+ * vieja y reordenar cuesta O(log N). Trabaja sobre claves int64, así que la
+ * misma implementación sirve para double (con una clave que preserva el
+ * orden) y para punto fijo. */
+typedef struct {
+    uint16_t n, ct, idx;
+    int64_t key[FILTER_MAX_WINDOW];     /* Buffer circular de claves */
+    int16_t pos[FILTER_MAX_WINDOW];     /* Posición en el montículo de cada clave */
+    int16_t heap[FILTER_MAX_WINDOW];    /* Índices de key; heap[n / 2] es la mediana */
+} filter_median_t;
+
+typedef struct {
+    double alpha, y;
+    bool init;
+} filter_ewma_t;
+
+typedef struct {
+    int32_t alpha;              /* Q15 */
+    int32_t y;
+    bool init;
+} filter_ewma_q_t;
+
+/* Kalman 1-D: q es la varianza del proceso por muestra y r la del ruido de
+ * medición (en unidades del sensor al cuadrado) */
+typedef struct {
+    double q, r, x, p;
+    bool init;
+} filter_kalman_t;
+
+typedef struct {
+    int64_t q, r, p;            /* Varianzas con FILTER_Q bits fraccionarios */
+    int32_t x;
+    bool init;
+} filter_kalman_q_t;
+
+typedef struct {
+    filter_kind_t kind;
+    union {
+        filter_avg_t avg;
+        filter_avg_q_t avg_q;
+        filter_median_t median;
+        filter_ewma_t ewma;
+        filter_ewma_q_t ewma_q;
+        filter_kalman_t kalman;
+        filter_kalman_q_t kalman_q;
+    } u;
+} filter_t;
+
+typedef struct {
+    size_t n;
+    bool fixed;                 /* Las etapas usan la versión de punto fijo */
+    filter_t stage[FILTER_MAX_STAGES];
+} filter_chain_t;
+
+/* Conversión a y desde punto fijo (con saturación) */
+extern int32_t filter_to_q(double x);
+static inline double filter_from_q(int32_t q) {
+    return q / (double)FILTER_ONE;
+}
+
+/* Filtros sueltos: init deja el estado vacío, step filtra una muestra */
+extern void filter_avg_init(filter_avg_t *f, uint32_t n);
+extern double filter_avg_step(filter_avg_t *f, double x);
+extern void filter_avg_q_init(filter_avg_q_t *f, uint32_t n);
+extern int32_t filter_avg_q_step(filter_avg_q_t *f, int32_t x);
+
+extern void filter_median_init(filter_median_t *f, uint32_t n);
+extern double filter_median_step(filter_median_t *f, double x);
+extern int32_t filter_median_q_step(filter_median_t *f, int32_t x);
+
+extern void filter_ewma_init(filter_ewma_t *f, double alpha);
+extern double filter_ewma_step(filter_ewma_t *f, double x);
+extern void filter_ewma_q_init(filter_ewma_q_t *f, double alpha);
+extern int32_t filter_ewma_q_step(filter_ewma_q_t *f, int32_t x);
+
+extern void filter_kalman_init(filter_kalman_t *f, double q, double r);
+extern double filter_kalman_step(filter_kalman_t *f, double x);
+extern void filter_kalman_q_init(filter_kalman_q_t *f, double q, double r);
+extern int32_t filter_kalman_q_step(filter_kalman_q_t *f, int32_t x);
+
+/* Arma una cadena desde "avg:N,median:N,ewma:ALFA,kalman:Q:R" (en el orden
+ * dado); en error deja un mensaje en err y retorna false */
+extern bool filter_chain_parse(filter_chain_t *c, const char *spec, bool fixed, char *err, size_t errlen);
+
+/* Pasa una muestra por todas las etapas */
+extern double filter_chain_apply(filter_chain_t *c, double x);
+
+#endif /* FILTER_H */
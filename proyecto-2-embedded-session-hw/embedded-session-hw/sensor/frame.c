@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <string.h>
+#include "csv.h"
+#include "frame.h"
+
+bool frame_init(sensor_frame_t *f, size_t channels, size_t cap) {
+    memset(f, 0, sizeof(*f));
+    if (channels == 0 || channels > FRAME_MAX_CHANNELS) return false;
+    if (cap < 16) cap = 16;
+
+    f->channels = channels;
+    f->cap = cap;
+    f->ts = malloc(cap * sizeof(double));
+    f->col = calloc(channels, sizeof(double *));
+    if (!f->ts || !f->col) {
+        frame_free(f);
+        return false;
+    }
+    for (size_t c = 0; c < channels; c++) {
+        f->col[c] = malloc(cap * sizeof(double));
+        if (!f->col[c]) {
+            frame_free(f);
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Duplica la capacidad de todas las columnas */
+static bool grow(sensor_frame_t *f) {
+    size_t cap = f->cap * 2;
+    double *ts = realloc(f->ts, cap * sizeof(double));
+    if (!ts) return false;
+    f->ts = ts;
+    for (size_t c = 0; c < f->channels; c++) {
+        double *col = realloc(f->col[c], cap * sizeof(double));
+        if (!col) return false;     /* Las columnas ya crecidas sirven igual */
+        f->col[c] = col;
+    }
+    f->cap = cap;
+    return true;
+}
+
+bool frame_push(sensor_frame_t *f, double ts, const double *values) {
+    if (f->rows == f->cap && !grow(f)) return false;
+    f->ts[f->rows] = ts;
+    for (size_t c = 0; c < f->channels; c++) f->col[c][f->rows] = values[c];
+    f->rows++;
+    return true;
+}
+
+bool frame_load_csv(sensor_frame_t *f, const char *path) {
+    csv_reader_t r;
+    double fields[FRAME_MAX_CHANNELS + 1];
+
+    memset(f, 0, sizeof(*f));
+    if (!csv_open(&r, path)) return false;
+    if (r.columns < 2 || r.columns > FRAME_MAX_CHANNELS + 1) {
+        csv_close(&r);
+        return false;
+    }
+
+    /* Estimación de filas por tamaño (unos 8 bytes por campo) */
+    size_t cap = (size_t)(r.file_size / (off_t)(r.columns * 8)) + 16;
+    bool ok = frame_init(f, r.columns - 1, cap);
+    while (ok && csv_next_fields(&r, fields, r.columns) > 0) {
+        ok = frame_push(f, fields[0], fields + 1);
+    }
+    csv_close(&r);
+
+    if (!ok) frame_free(f);
+    return ok;
+}
+
+void frame_free(sensor_frame_t *f) {
+    if (f->col) {
+        for (size_t c = 0; c < f->channels; c++) free(f->col[c]);
+    }
+    free(f->col);
+    free(f->ts);
+    memset(f, 0, sizeof(*f));
+}
+
+void frame_threshold(const sensor_frame_t *f, size_t row0, size_t n,
+                     const double *thresholds, uint8_t *above) {
+    for (size_t c = 0; c < f->channels; c++) {
+        const double *restrict x = f->col[c] + row0;
+        uint8_t *restrict out = above + c * n;
+        const double th = thresholds[c];
+        for (size_t i = 0; i < n; i++) out[i] = (uint8_t)(x[i] >= th);
+    }
+}
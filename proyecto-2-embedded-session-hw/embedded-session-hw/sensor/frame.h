@@ -0,0 +1,40 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Máximo de canales por fila (sin contar el timestamp) */
+#define FRAME_MAX_CHANNELS 1024
+
+/* Frames multicanal en memoria, por columnas (SoA): cada canal es un arreglo
+ * contiguo de muestras, así el umbral de un canal se evalúa con SIMD sobre
+ * bloques de tiempo en vez de saltar entre filas */
+typedef struct {
+    size_t channels;        /* Canales por fila */
+    size_t rows;            /* Filas cargadas */
+    size_t cap;             /* Capacidad de cada columna */
+    double *ts;             /* Timestamp de cada fila */
+    double **col;           /* col[c][r]: canal c en la fila r */
+} sensor_frame_t;
+
+/* Crea un frame vacío de channels canales; false si falta memoria */
+extern bool frame_init(sensor_frame_t *f, size_t channels, size_t cap);
+
+/* Agrega una fila (values tiene channels elementos) */
+extern bool frame_push(sensor_frame_t *f, double ts, const double *values);
+
+/* Carga un CSV timestamp,c0,c1,...; los canales se toman del header */
+extern bool frame_load_csv(sensor_frame_t *f, const char *path);
+
+/* Libera las columnas */
+extern void frame_free(sensor_frame_t *f);
+
+/* Kernel de umbral: para cada canal c y cada fila r en [row0, row0 + n)
+ * escribe above[c * n + (r - row0)] = (col[c][r] >= thresholds[c]).
+ * El bucle interno es contiguo y sin saltos, apto para vectorizar. */
+extern void frame_threshold(const sensor_frame_t *f, size_t row0, size_t n,
+                            const double *thresholds, uint8_t *above);
+
+#endif /* FRAME_H */
@@ -0,0 +1,71 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../common/rng.h"
+#include "sensor.h"
+
+/* Estructura interna de la fuente aleatoria */
+typedef struct {
+    double clock;               /* Reloj sintético: una muestra cada 100 ms */
+    rng_t rng;                  /* Generador propio de la instancia */
+} RandomParams;
+
+static size_t random_read_batch(void *params, sensor_sample_t *buf, size_t n) {
+    RandomParams *rp = (RandomParams *) params;
+    for (size_t i = 0; i < n; i++) {
+        buf[i].t = rp->clock;
+        buf[i].value = rng_uniform(&rp->rng) * 100.0;  /* Entre 0.0 y 100.0 */
+        rp->clock += 0.1;
+    }
+    return n;
+}
+
+static bool random_eof(void *params) {
+    (void)params;
+    return false;
+}
+
+static void random_reset(void *params) {
+    ((RandomParams *) params)->clock = 0.0;
+}
+
+static int random_fd(void *params) {
+    (void)params;
+    return -1;
+}
+
+static void random_close(void *params) {
+    (void)params;               /* params vive en la arena */
+}
+
+/* Función de fábrica: fuente aleatoria con una semilla explícita; la
+ * secuencia depende solo de seed y varias instancias pueden leerse desde
+ * hilos distintos */
+Sensor create_seeded_random_sensor(arena_t *arena, uint64_t seed) {
+    RandomParams *params = (RandomParams *) arena_alloc(arena, sizeof(RandomParams));
+    if (params) rng_seed(&params->rng, seed);
+
+    Sensor sensor = {
+        .params = params,
+        .name = "ALEATORIO",
+        .live = false,
+        .read_batch = random_read_batch,
+        .eof = random_eof,
+        .reset = random_reset,
+        .fd = random_fd,
+        .close = random_close
+    };
+    return sensor;
+}
+
+/* Función de fábrica: devuelve un Sensor de valores aleatorios, con una
+ * semilla distinta en cada corrida y en cada llamada (también desde varios
+ * hilos a la vez) */
+Sensor create_random_sensor(arena_t *arena) {
+    static atomic_ulong created = 0;
+    uint64_t seed = (uint64_t)time(NULL) * 0x9E3779B97F4A7C15ull +
+                    atomic_fetch_add_explicit(&created, 1, memory_order_relaxed);
+    return create_seeded_random_sensor(arena, seed);
+}
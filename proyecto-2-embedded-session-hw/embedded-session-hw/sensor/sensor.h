@@ -2,29 +2,48 @@
 #define SENSOR_H
 
 #include <stdbool.h>
-
-/* Tipos de modo de sensor */
-typedef enum {
-    SENSOR_MODE_RANDOM,    /* Valores aleatorios */
-    SENSOR_MODE_CSV        /* Replay desde archivo CSV */
-} sensor_mode_t;
-
-/* Inicializa el sensor en modo aleatorio */
-extern void sensor_init(void);
-
-/* Inicializa el sensor con un archivo CSV específico */
-extern void sensor_init_csv(const char *csv_file);
-
-/* Lee un valor del sensor y lo devuelve como double */
-extern double sensor_read(void);
-
-/* Obtiene el modo actual del sensor */
-extern sensor_mode_t sensor_get_mode(void);
-
-/* Verifica si el sensor está en modo CSV y si hay más datos */
-extern bool sensor_has_more_data(void);
-
-/* Reinicia el replay del archivo CSV */
-extern void sensor_reset_csv(void);
+#include <stddef.h>
+#include <stdint.h>
+#include "../common/arena.h"
+
+/* Muestra con su timestamp (segundos) */
+typedef struct {
+    double t;
+    double value;
+} sensor_sample_t;
+
+/* Interfaz polimórfica para fuentes de datos (análoga a Actuator) */
+typedef struct {
+    void *params;                                                   /* Datos específicos de la fuente */
+    const char *name;                                               /* Nombre para los mensajes */
+    bool live;                                                      /* Los datos llegan solos (FIFO, socket, shm) */
+    size_t (*read_batch)(void *params, sensor_sample_t *buf, size_t n); /* Sin bloquear: 0 si no hay datos */
+    bool (*eof)(void *params);                                      /* La fuente se agotó (fin del CSV) */
+    void (*reset)(void *params);                                    /* Volver al inicio (CSV) */
+    int (*fd)(void *params);                                        /* Descriptor para poll, -1 si no tiene */
+    void (*close)(void *params);                                    /* Cerrar descriptores y mapeos */
+} Sensor;
+
+/* Fábricas de fuentes; si fallan devuelven un Sensor con params == NULL.
+ * params sale de la arena del llamador: close() solo suelta los recursos del
+ * sistema (archivos, sockets, mapeos) y la memoria se libera con la arena. */
+extern Sensor create_random_sensor(arena_t *arena);
+extern Sensor create_seeded_random_sensor(arena_t *arena, uint64_t seed);
+extern Sensor create_csv_sensor(arena_t *arena, const char *path, bool stream);
+extern Sensor create_fifo_sensor(arena_t *arena, const char *path);
+extern Sensor create_unix_sensor(arena_t *arena, const char *path);
+extern Sensor create_shm_sensor(arena_t *arena, const char *name, size_t capacity);
+
+/* Señal sintética determinista (ver sensor/synth.h), p. ej.
+ * "seed=7,noise=2,sin=20:60,spike=0.001:40" */
+extern Sensor create_synth_sensor(arena_t *arena, const char *spec);
+
+/* Sensor Linux IIO por sondeo de sysfs o por buffer (ver sensor/iio_sensor.c),
+ * p. ej. "dev=0,chan=voltage0" o "dev=0,chan=voltage0,buffer=256" */
+extern Sensor create_iio_sensor(arena_t *arena, const char *spec);
+
+/* Crea una fuente desde "random", "csv:ruta", "stream:ruta", "fifo:ruta",
+ * "unix:ruta", "shm:/nombre", "synth[:parámetros]" o "iio[:parámetros]" */
+extern Sensor create_sensor_from_spec(arena_t *arena, const char *spec);
 
 #endif /* SENSOR_H */
@@ -0,0 +1,39 @@
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "sensor.h"
+
+#define SHM_RING_MAGIC      "CTLSHM1"
+#define SHM_RING_CAPACITY   65536   /* Muestras por defecto (potencia de 2) */
+
+/* Cola circular de un productor y un consumidor en memoria compartida
+ * (shm_open). El consumidor (create_shm_sensor) crea el segmento; los
+ * productores de otros procesos se conectan con shm_ring_attach. Los índices
+ * son de 32 bits y avanzan sin enmascarar, así que el diseño es el mismo en
+ * ctl32 y ctl64 y ambos pueden compartir un segmento. */
+typedef struct {
+    char magic[8];
+    uint32_t capacity;          /* Potencia de 2 */
+    uint32_t sample_size;       /* sizeof(sensor_sample_t) */
+    _Alignas(64) _Atomic uint32_t head;     /* Próxima escritura (productor) */
+    _Alignas(64) _Atomic uint32_t tail;     /* Próxima lectura (consumidor) */
+    _Alignas(64) sensor_sample_t data[];
+} shm_ring_t;
+
+/* Bytes que ocupa un segmento de capacity muestras */
+static inline size_t shm_ring_bytes(uint32_t capacity) {
+    return sizeof(shm_ring_t) + (size_t)capacity * sizeof(sensor_sample_t);
+}
+
+/* Productor: se conecta a un segmento existente; NULL si no existe o no es
+ * compatible. Se libera con shm_ring_detach. */
+extern shm_ring_t *shm_ring_attach(const char *name);
+extern void shm_ring_detach(shm_ring_t *ring);
+
+/* Productor: encola hasta n muestras sin bloquear; devuelve cuántas entraron */
+extern size_t shm_ring_push(shm_ring_t *ring, const sensor_sample_t *s, size_t n);
+
+#endif /* SHM_RING_H */
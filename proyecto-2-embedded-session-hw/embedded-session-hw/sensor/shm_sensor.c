@@ -0,0 +1,138 @@
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "sensor.h"
+#include "shm_ring.h"
+
+/* Estructura interna de la fuente de memoria compartida */
+typedef struct {
+    shm_ring_t *ring;
+    uint32_t head_cache;        /* Copia de head: se relee solo al vaciarse */
+    char name[256];
+} ShmParams;
+
+shm_ring_t *shm_ring_attach(const char *name) {
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) return NULL;
+    shm_ring_t hdr;
+    if (pread(fd, &hdr, offsetof(shm_ring_t, head), 0) != (ssize_t)offsetof(shm_ring_t, head) ||
+        memcmp(hdr.magic, SHM_RING_MAGIC, sizeof(hdr.magic)) != 0 ||
+        hdr.sample_size != sizeof(sensor_sample_t) || hdr.capacity == 0 ||
+        (hdr.capacity & (hdr.capacity - 1)) != 0) {
+        close(fd);
+        return NULL;
+    }
+    void *m = mmap(NULL, shm_ring_bytes(hdr.capacity), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return m == MAP_FAILED ? NULL : (shm_ring_t *) m;
+}
+
+void shm_ring_detach(shm_ring_t *ring) {
+    munmap(ring, shm_ring_bytes(ring->capacity));
+}
+
+size_t shm_ring_push(shm_ring_t *ring, const sensor_sample_t *s, size_t n) {
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    uint32_t mask = ring->capacity - 1;
+    size_t space = ring->capacity - (uint32_t)(head - tail);
+
+    if (n > space) n = space;
+    for (size_t i = 0; i < n; i++) ring->data[(head + (uint32_t)i) & mask] = s[i];
+    atomic_store_explicit(&ring->head, head + (uint32_t)n, memory_order_release);
+    return n;
+}
+
+static size_t shm_read_batch(void *params, sensor_sample_t *buf, size_t n) {
+    ShmParams *sp = (ShmParams *) params;
+    shm_ring_t *ring = sp->ring;
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t mask = ring->capacity - 1;
+
+    if (sp->head_cache == tail) {
+        sp->head_cache = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (sp->head_cache == tail) return 0;
+    }
+    size_t avail = (uint32_t)(sp->head_cache - tail);
+    if (n > avail) n = avail;
+    for (size_t i = 0; i < n; i++) buf[i] = ring->data[(tail + (uint32_t)i) & mask];
+    atomic_store_explicit(&ring->tail, tail + (uint32_t)n, memory_order_release);
+    return n;
+}
+
+static bool shm_eof(void *params) {
+    (void)params;
+    return false;
+}
+
+static void shm_reset(void *params) {
+    (void)params;
+}
+
+static int shm_fd(void *params) {
+    (void)params;
+    return -1;                  /* Sin descriptor: el consumidor sondea */
+}
+
+static void shm_close(void *params) {
+    ShmParams *sp = (ShmParams *) params;
+    shm_ring_detach(sp->ring);
+    shm_unlink(sp->name);
+}
+
+/* Función de fábrica: crea (o recrea) el segmento name con capacity
+ * muestras (0 = SHM_RING_CAPACITY; se redondea a potencia de 2) */
+Sensor create_shm_sensor(arena_t *arena, const char *name, size_t capacity) {
+    Sensor sensor = {
+        .params = NULL,
+        .name = "MEMORIA COMPARTIDA",
+        .live = true,
+        .read_batch = shm_read_batch,
+        .eof = shm_eof,
+        .reset = shm_reset,
+        .fd = shm_fd,
+        .close = shm_close
+    };
+    uint32_t cap = 1;
+    if (capacity == 0) capacity = SHM_RING_CAPACITY;
+    while (cap < capacity && cap < (1u << 30)) cap <<= 1;
+
+    if (strlen(name) >= sizeof(((ShmParams *)0)->name)) {
+        printf("[SENSOR] Error: Nombre de memoria compartida demasiado largo\n");
+        return sensor;
+    }
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd < 0 || ftruncate(fd, (off_t)shm_ring_bytes(cap)) != 0) {
+        printf("[SENSOR] Error: No se pudo crear la memoria compartida %s: %s\n", name, strerror(errno));
+        if (fd >= 0) {
+            close(fd);
+            shm_unlink(name);
+        }
+        return sensor;
+    }
+    void *m = mmap(NULL, shm_ring_bytes(cap), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    ShmParams *sp = m != MAP_FAILED ? (ShmParams *) arena_alloc(arena, sizeof(ShmParams)) : NULL;
+    if (!sp) {
+        printf("[SENSOR] Error: No se pudo mapear la memoria compartida %s\n", name);
+        if (m != MAP_FAILED) munmap(m, shm_ring_bytes(cap));
+        shm_unlink(name);
+        return sensor;
+    }
+    sp->ring = (shm_ring_t *) m;
+    sp->ring->capacity = cap;
+    sp->ring->sample_size = sizeof(sensor_sample_t);
+    atomic_init(&sp->ring->head, 0);
+    atomic_init(&sp->ring->tail, 0);
+    memcpy(sp->ring->magic, SHM_RING_MAGIC, sizeof(sp->ring->magic));   /* Último: ya está listo */
+    strcpy(sp->name, name);
+    printf("[SENSOR] Memoria compartida %s (%u muestras)\n", name, cap);
+    sensor.params = sp;
+    return sensor;
+}
@@ -0,0 +1,222 @@
+#include <stdlib.h>
+#include <string.h>
+#include "synth.h"
+#include "../common/spec.h"
+
+#define SYNTH_PI 3.14159265358979323846
+
+/* sen y cos sin libm: se lleva x a [-pi, pi], se divide por 16, se usa la
+ * serie de Taylor y se recupera el ángulo con cuatro duplicaciones. Solo se
+ * usa al configurar la sinusoide. */
+static void sin_cos(double x, double *s, double *c) {
+    double turns = x / (2.0 * SYNTH_PI);
+    x -= (double)(long long)turns * 2.0 * SYNTH_PI;
+    if (x > SYNTH_PI) x -= 2.0 * SYNTH_PI;
+    if (x < -SYNTH_PI) x += 2.0 * SYNTH_PI;
+    x /= 16.0;
+
+    double x2 = x * x;
+    double sn = x * (1.0 - x2 / 6.0 * (1.0 - x2 / 20.0 * (1.0 - x2 / 42.0 * (1.0 - x2 / 72.0 * (1.0 - x2 / 110.0)))));
+    double cs = 1.0 - x2 / 2.0 * (1.0 - x2 / 12.0 * (1.0 - x2 / 30.0 * (1.0 - x2 / 56.0 * (1.0 - x2 / 90.0 * (1.0 - x2 / 132.0)))));
+    for (int i = 0; i < 4; i++) {
+        double s2 = 2.0 * sn * cs;
+        cs = cs * cs - sn * sn;
+        sn = s2;
+    }
+    *s = sn;
+    *c = cs;
+}
+
+void synth_defaults(synth_config_t *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->seed = 1;
+    cfg->dt = 0.1;
+    cfg->base = 50.0;
+}
+
+bool synth_parse(synth_config_t *cfg, const char *spec, char *err, size_t errlen) {
+    spec_t sp;
+    if (!spec_open(&sp, spec, err, errlen)) return false;
+
+    char *tok, *arg;
+    while ((tok = spec_next(&sp, '=', &arg))) {
+        const char *item = sp.item;
+        if (!arg) return spec_fail(err, errlen, item, "se esperaba clave=valor");
+        double a, b;
+        int nv = spec_values(&sp, arg, &a, &b, err, errlen);
+        if (nv == 0) return false;
+        bool two = nv == 2;
+
+        bool pair = strcmp(tok, "sin") == 0 || strcmp(tok, "step") == 0 || strcmp(tok, "spike") == 0 ||
+                    strcmp(tok, "stuck") == 0 || strcmp(tok, "clamp") == 0;
+        if (pair != two) return spec_fail(err, errlen, item, pair ? "se esperaban dos valores (a:b)" : "se esperaba un solo valor");
+
+        if (strcmp(tok, "seed") == 0) {
+            if (a < 0) return spec_fail(err, errlen, item, "la semilla debe ser >= 0");
+            cfg->seed = strtoull(arg, NULL, 10);
+        } else if (strcmp(tok, "dt") == 0) {
+            if (!(a > 0.0)) return spec_fail(err, errlen, item, "dt debe ser > 0");
+            cfg->dt = a;
+        } else if (strcmp(tok, "base") == 0) {
+            cfg->base = a;
+        } else if (strcmp(tok, "noise") == 0 || strcmp(tok, "walk") == 0) {
+            if (a < 0.0) return spec_fail(err, errlen, item, "el desvío debe ser >= 0");
+            if (tok[0] == 'n') cfg->noise = a;
+            else cfg->walk = a;
+        } else if (strcmp(tok, "sin") == 0) {
+            if (!(b > 0.0)) return spec_fail(err, errlen, item, "el período debe ser > 0");
+            cfg->amplitude = a;
+            cfg->period = b;
+        } else if (strcmp(tok, "step") == 0) {
+            cfg->step_at = a;
+            cfg->step_size = b;
+        } else if (strcmp(tok, "spike") == 0) {
+            if (!(a >= 0.0 && a <= 1.0)) return spec_fail(err, errlen, item, "la probabilidad debe estar en [0, 1]");
+            cfg->spike_prob = a;
+            cfg->spike_size = b;
+        } else if (strcmp(tok, "stuck") == 0) {
+            if (!(b > 0.0)) return spec_fail(err, errlen, item, "la duración debe ser > 0");
+            cfg->stuck_at = a;
+            cfg->stuck_for = b;
+        } else if (strcmp(tok, "clamp") == 0) {
+            if (!(a < b)) return spec_fail(err, errlen, item, "se esperaba clamp=LO:HI con LO < HI");
+            cfg->clamp = true;
+            cfg->lo = a;
+            cfg->hi = b;
+        } else {
+            return spec_fail(err, errlen, item,
+                        "parámetro desconocido (seed, dt, base, noise, walk, sin, step, spike, stuck, clamp)");
+        }
+    }
+    return true;
+}
+
+void synth_init(synth_t *s, const synth_config_t *cfg) {
+    s->cfg = *cfg;
+    rng_lanes_seed(&s->rng, cfg->seed);
+    s->index = 0;
+    s->walk = 0.0;
+    s->re = 1.0;
+    s->im = 0.0;
+    s->rot_re = 1.0;
+    s->rot_im = 0.0;
+    if (cfg->period > 0.0) {
+        double step = 2.0 * SYNTH_PI * cfg->dt / cfg->period;
+        for (size_t i = 0; i < SYNTH_CHUNK; i++) sin_cos(step * (double)i, &s->sin_i[i], &s->cos_i[i]);
+        sin_cos(step * SYNTH_CHUNK, &s->rot_im, &s->rot_re);
+    }
+    s->held = 0.0;
+    s->holding = false;
+    s->pos = SYNTH_CHUNK;       /* Bloque vacío */
+}
+
+/* Genera el próximo bloque completo en t y v. Como rng_lanes_fill, con
+ * versión AVX2 elegida al cargar. */
+__attribute__((target_clones("avx2", "default")))
+static void generate(synth_t *s, double *restrict t, double *restrict v) {
+    const synth_config_t *cfg = &s->cfg;
+    const size_t n = SYNTH_CHUNK;
+    uint64_t *restrict bits = s->bits;
+    size_t words = 0;
+
+    /* Bits aleatorios de todo el bloque de una vez: 2 palabras por muestra
+     * para el ruido, 2 para la caminata y 1 para los picos */
+    bool noise = cfg->noise > 0.0, walk = cfg->walk > 0.0, spike = cfg->spike_prob > 0.0;
+    size_t need = (noise ? 2 * n : 0) + (walk ? 2 * n : 0) + (spike ? n : 0);
+    if (need) rng_lanes_fill(&s->rng, bits, need);
+
+    double t0 = (double)s->index * cfg->dt;
+    for (size_t i = 0; i < n; i++) t[i] = t0 + (double)(int32_t)i * cfg->dt;    /* Con signo: SSE2 convierte int32, no size_t */
+
+    if (noise) {
+        const uint64_t *r = bits + words;
+        for (size_t i = 0; i < n; i++) v[i] = cfg->base + cfg->noise * rng_gauss_bits(r[2 * i], r[2 * i + 1]);
+        words += 2 * n;
+    } else {
+        for (size_t i = 0; i < n; i++) v[i] = cfg->base;
+    }
+
+    if (cfg->step_size != 0.0) {
+        for (size_t i = 0; i < n; i++) v[i] += t[i] >= cfg->step_at ? cfg->step_size : 0.0;
+    }
+
+    if (cfg->amplitude != 0.0 && cfg->period > 0.0) {
+        /* sen(fase + i·paso) con la tabla del giro de i muestras: sin
+         * dependencia entre muestras; la fase avanza una vez por bloque y se
+         * renormaliza */
+        const double *restrict ci = s->cos_i, *restrict si = s->sin_i;
+        double a_re = cfg->amplitude * s->re, a_im = cfg->amplitude * s->im;
+        for (size_t i = 0; i < n; i++) v[i] += a_im * ci[i] + a_re * si[i];
+        double re = s->re * s->rot_re - s->im * s->rot_im;
+        double im = s->re * s->rot_im + s->im * s->rot_re;
+        double k = (3.0 - (re * re + im * im)) * 0.5;
+        s->re = re * k;
+        s->im = im * k;
+    }
+
+    if (walk) {
+        /* Incrementos en un bucle vectorizable y la suma acumulada aparte */
+        const uint64_t *r = bits + words;
+        double *restrict steps = s->steps;
+        for (size_t i = 0; i < n; i++) steps[i] = cfg->walk * rng_gauss_bits(r[2 * i], r[2 * i + 1]);
+        double w = s->walk;
+        for (size_t i = 0; i < n; i++) {
+            w += steps[i];
+            v[i] += w;
+        }
+        s->walk = w;
+        words += 2 * n;
+    }
+
+    if (spike) {
+        const uint64_t *r = bits + words;
+        /* 31 bits por muestra: entero con signo, que SSE2 sí convierte */
+        double limit = cfg->spike_prob * 2147483648.0, size = cfg->spike_size;
+        for (size_t i = 0; i < n; i++) v[i] += (double)(int32_t)(r[i] >> 33) < limit ? size : 0.0;
+        words += n;
+    }
+
+    if (cfg->stuck_for > 0.0 && t[n - 1] >= cfg->stuck_at && t[0] < cfg->stuck_at + cfg->stuck_for) {
+        /* Falla: desde stuck_at el sensor repite la última lectura buena */
+        for (size_t i = 0; i < n; i++) {
+            bool in = t[i] >= cfg->stuck_at && t[i] < cfg->stuck_at + cfg->stuck_for;
+            if (in && !s->holding) s->held = i > 0 ? v[i - 1] : s->held;
+            if (in) v[i] = s->held;
+            s->holding = in;
+        }
+    }
+    if (!s->holding && n > 0) s->held = v[n - 1];
+
+    if (cfg->clamp) {
+        double lo = cfg->lo, hi = cfg->hi;
+        for (size_t i = 0; i < n; i++) {
+            double x = v[i] < lo ? lo : v[i];
+            v[i] = x > hi ? hi : x;
+        }
+    }
+    s->index += n;
+}
+
+void synth_fill(synth_t *s, double *t, double *v, size_t n) {
+    while (n > 0) {
+        if (s->pos == SYNTH_CHUNK && n >= SYNTH_CHUNK) {
+            /* Bloques completos directo al destino */
+            generate(s, t, v);
+            t += SYNTH_CHUNK;
+            v += SYNTH_CHUNK;
+            n -= SYNTH_CHUNK;
+            continue;
+        }
+        if (s->pos == SYNTH_CHUNK) {
+            generate(s, s->t, s->v);
+            s->pos = 0;
+        }
+        size_t take = SYNTH_CHUNK - s->pos < n ? SYNTH_CHUNK - s->pos : n;
+        memcpy(t, s->t + s->pos, take * sizeof(double));
+        memcpy(v, s->v + s->pos, take * sizeof(double));
+        s->pos += take;
+        t += take;
+        v += take;
+        n -= take;
+    }
+}
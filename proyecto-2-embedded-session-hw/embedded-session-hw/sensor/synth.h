@@ -0,0 +1,72 @@
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../common/rng.h"
+
+/* Generador sintético de señales de sensor, determinista por semilla. La
+ * señal es la suma de los modelos activos:
+ *
+ *     v = base + ruido gaussiano + caminata aleatoria + sinusoide
+ *         + escalón + picos
+ *
+ * más una falla "pegado" (el valor queda fijo durante una ventana) y un
+ * recorte opcional al rango del sensor. Se genera por bloques de
+ * SYNTH_CHUNK muestras con bucles que el compilador vectoriza; la secuencia
+ * no depende de cuántas muestras se pidan por llamada. */
+
+#define SYNTH_CHUNK 1024
+
+typedef struct {
+    uint64_t seed;
+    double dt;                  /* Período de muestreo (segundos) */
+    double base;                /* Nivel base */
+    double noise;               /* Desvío del ruido gaussiano */
+    double walk;                /* Desvío por muestra de la caminata aleatoria */
+    double amplitude;           /* Sinusoide: amplitud y período (segundos) */
+    double period;
+    double step_at;             /* Escalón de step_size a partir de t = step_at */
+    double step_size;
+    double spike_prob;          /* Probabilidad de pico por muestra */
+    double spike_size;
+    double stuck_at;            /* Falla: valor fijo desde stuck_at durante stuck_for s */
+    double stuck_for;
+    bool clamp;                 /* Recortar a [lo, hi] */
+    double lo;
+    double hi;
+} synth_config_t;
+
+typedef struct {
+    synth_config_t cfg;
+    rng_lanes_t rng;
+    uint64_t index;             /* Muestras generadas */
+    double walk;                /* Valor actual de la caminata */
+    double re, im;              /* Fase de la sinusoide al inicio del bloque (cos, sen) */
+    double rot_re, rot_im;      /* Giro de un bloque completo */
+    double held;                /* Valor de la falla "pegado" */
+    bool holding;
+    size_t pos;                 /* Próxima muestra del bloque sin entregar */
+    double t[SYNTH_CHUNK];
+    double v[SYNTH_CHUNK];
+    uint64_t bits[5 * SYNTH_CHUNK];
+    double steps[SYNTH_CHUNK];  /* Incrementos de la caminata */
+    double cos_i[SYNTH_CHUNK];  /* cos y sen del giro de i muestras */
+    double sin_i[SYNTH_CHUNK];
+} synth_t;
+
+/* Configuración por defecto: base 50, dt 0.1 s, semilla 1, sin modelos */
+extern void synth_defaults(synth_config_t *cfg);
+
+/* Lee "clave=valor,..." sobre cfg: seed=N, dt=S, base=X, noise=SD, walk=SD,
+ * sin=AMP:PERIODO, step=T:DELTA, spike=PROB:DELTA, stuck=T:DURACION,
+ * clamp=LO:HI. En error deja un mensaje en err y retorna false. */
+extern bool synth_parse(synth_config_t *cfg, const char *spec, char *err, size_t errlen);
+
+extern void synth_init(synth_t *s, const synth_config_t *cfg);
+
+/* Llena t y v con las próximas n muestras */
+extern void synth_fill(synth_t *s, double *t, double *v, size_t n);
+
+#endif /* SYNTH_H */
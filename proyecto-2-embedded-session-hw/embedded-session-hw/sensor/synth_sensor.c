@@ -0,0 +1,68 @@
+#include <stdio.h>
+#include "synth.h"
+#include "sensor.h"
+
+/* Fuente sintética: la señal de synth.c entregada como muestras */
+static size_t synth_read_batch(void *params, sensor_sample_t *buf, size_t n) {
+    synth_t *s = (synth_t *) params;
+    double t[64], v[64];
+    size_t done = 0;
+    while (done < n) {
+        size_t take = n - done < 64 ? n - done : 64;
+        synth_fill(s, t, v, take);
+        for (size_t i = 0; i < take; i++) {
+            buf[done + i].t = t[i];
+            buf[done + i].value = v[i];
+        }
+        done += take;
+    }
+    return n;
+}
+
+static bool synth_eof(void *params) {
+    (void)params;
+    return false;
+}
+
+static void synth_reset(void *params) {
+    synth_t *s = (synth_t *) params;
+    synth_config_t cfg = s->cfg;
+    synth_init(s, &cfg);
+}
+
+static int synth_fd(void *params) {
+    (void)params;
+    return -1;
+}
+
+static void synth_close(void *params) {
+    (void)params;               /* params vive en la arena */
+}
+
+/* Función de fábrica: spec con los parámetros de synth_parse (vacío = por
+ * defecto) */
+Sensor create_synth_sensor(arena_t *arena, const char *spec) {
+    Sensor sensor = {
+        .params = NULL,
+        .name = "SINTÉTICO",
+        .live = false,
+        .read_batch = synth_read_batch,
+        .eof = synth_eof,
+        .reset = synth_reset,
+        .fd = synth_fd,
+        .close = synth_close
+    };
+    synth_config_t cfg;
+    char err[128];
+
+    synth_defaults(&cfg);
+    if (!synth_parse(&cfg, spec, err, sizeof(err))) {
+        printf("[SENSOR] Error en la señal sintética %s\n", err);
+        return sensor;
+    }
+    synth_t *s = (synth_t *) arena_alloc(arena, sizeof(synth_t));
+    if (!s) return sensor;
+    synth_init(s, &cfg);
+    sensor.params = s;
+    return sensor;
+}
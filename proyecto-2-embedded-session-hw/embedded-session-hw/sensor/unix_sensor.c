@@ -0,0 +1,101 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "sensor.h"
+
+#define UNIX_DGRAM_MAX 4096     /* Muestras por datagrama como máximo */
+
+/* Estructura interna de la fuente socket: cada datagrama trae un arreglo
+ * binario de sensor_sample_t. Lo que no cabe en el lote pedido queda en
+ * staging para la próxima lectura. */
+typedef struct {
+    int fd;
+    char path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    size_t head;                /* Próxima muestra de staging */
+    size_t count;               /* Muestras en staging */
+    sensor_sample_t staging[UNIX_DGRAM_MAX];
+} UnixParams;
+
+static size_t unix_read_batch(void *params, sensor_sample_t *buf, size_t n) {
+    UnixParams *up = (UnixParams *) params;
+    size_t got = 0;
+
+    while (got < n) {
+        if (up->head == up->count) {
+            ssize_t r = recv(up->fd, up->staging, sizeof(up->staging), MSG_DONTWAIT);
+            if (r < 0) break;                       /* EAGAIN: no hay más por ahora */
+            up->head = 0;
+            up->count = (size_t)r / sizeof(sensor_sample_t);   /* Resto truncado: se ignora */
+            continue;
+        }
+        size_t take = up->count - up->head;
+        if (take > n - got) take = n - got;
+        memcpy(buf + got, up->staging + up->head, take * sizeof(sensor_sample_t));
+        up->head += take;
+        got += take;
+    }
+    return got;
+}
+
+static bool unix_eof(void *params) {
+    (void)params;
+    return false;
+}
+
+static void unix_reset(void *params) {
+    (void)params;
+}
+
+static int unix_fd(void *params) {
+    return ((UnixParams *) params)->fd;
+}
+
+static void unix_close(void *params) {
+    UnixParams *up = (UnixParams *) params;
+    close(up->fd);
+    unlink(up->path);
+}
+
+/* Función de fábrica: socket de datagramas ligado a path (si el archivo ya
+ * existía, se reemplaza) */
+Sensor create_unix_sensor(arena_t *arena, const char *path) {
+    Sensor sensor = {
+        .params = NULL,
+        .name = "SOCKET UNIX",
+        .live = true,
+        .read_batch = unix_read_batch,
+        .eof = unix_eof,
+        .reset = unix_reset,
+        .fd = unix_fd,
+        .close = unix_close
+    };
+    struct sockaddr_un addr = {.sun_family = AF_UNIX};
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        printf("[SENSOR] Error: Ruta de socket demasiado larga: %s\n", path);
+        return sensor;
+    }
+    UnixParams *up = (UnixParams *) arena_alloc(arena, sizeof(UnixParams));
+    if (!up) return sensor;
+    strcpy(up->path, path);
+    strcpy(addr.sun_path, path);
+
+    up->fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    unlink(path);
+    if (up->fd < 0 || bind(up->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        printf("[SENSOR] Error: No se pudo abrir el socket %s: %s\n", path, strerror(errno));
+        if (up->fd >= 0) close(up->fd);
+        return sensor;
+    }
+    /* Buffer de recepción amplio para absorber ráfagas */
+    int rcvbuf = 4 << 20;
+    setsockopt(up->fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    printf("[SENSOR] Escuchando socket %s\n", path);
+    sensor.params = up;
+    return sensor;
+}